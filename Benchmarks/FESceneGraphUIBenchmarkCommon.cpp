@@ -0,0 +1,200 @@
+#include "FESceneGraphUIBenchmarkCommon.h"
+#include "../VersionInfo/FE_SCENE_GRAPH_UI_Version.h"
+#include "../VersionInfo/FEVersionInfo.h"
+FE_DEFINE_VERSION_INFO(FE_SCENE_GRAPH_UI_)
+
+std::string BenchmarkSceneShapeToString(FE_BENCHMARK_SCENE_SHAPE Shape)
+{
+	switch (Shape)
+	{
+		case FE_BENCHMARK_SCENE_WIDE:
+			return "wide";
+		case FE_BENCHMARK_SCENE_DEEP:
+			return "deep";
+		case FE_BENCHMARK_SCENE_BALANCED:
+			return "balanced";
+	}
+
+	return "unknown";
+}
+
+bool BenchmarkSceneShapeFromString(const std::string& String, FE_BENCHMARK_SCENE_SHAPE& OutShape)
+{
+	if (String == "wide")
+	{
+		OutShape = FE_BENCHMARK_SCENE_WIDE;
+		return true;
+	}
+
+	if (String == "deep")
+	{
+		OutShape = FE_BENCHMARK_SCENE_DEEP;
+		return true;
+	}
+
+	if (String == "balanced")
+	{
+		OutShape = FE_BENCHMARK_SCENE_BALANCED;
+		return true;
+	}
+
+	return false;
+}
+
+std::vector<std::string> SplitByComma(const std::string& Text)
+{
+	std::vector<std::string> Result;
+	std::string Current;
+	for (char Character : Text)
+	{
+		if (Character == ',')
+		{
+			if (!Current.empty())
+				Result.push_back(Current);
+			Current.clear();
+		}
+		else
+		{
+			Current += Character;
+		}
+	}
+
+	if (!Current.empty())
+		Result.push_back(Current);
+
+	return Result;
+}
+
+std::string GetBenchmarkVersionString()
+{
+	return "Scene Graph UI " + GetFE_SCENE_GRAPH_UI_VersionInfo().GetFullVersionString();
+}
+
+FEBenchmarkScene CreateBenchmarkScene(FE_BENCHMARK_SCENE_SHAPE Shape, size_t NodeCount, size_t BranchingFactor)
+{
+	FEBenchmarkScene Result;
+	Result.Scene = SCENE_MANAGER.CreateScene("Scene graph UI benchmark scene");
+	if (Result.Scene == nullptr)
+		return Result;
+
+	// Scene graph lookups by ID are O(n), so nodes are found and reparented by pointers to keep 1M node scenes linear to create.
+	// Every new node is moved away from the root right after creation, so root never has more than two children to scan.
+	FENaiveSceneGraphNode* Root = Result.Scene->SceneGraph.GetRoot();
+	BranchingFactor = std::max(BranchingFactor, static_cast<size_t>(1));
+	Result.Nodes.reserve(NodeCount);
+	for (size_t i = 0; i < NodeCount; i++)
+	{
+		FEEntity* Entity = Result.Scene->CreateEntity("Node_" + std::to_string(i));
+		FENaiveSceneGraphNode* Node = nullptr;
+		std::vector<FENaiveSceneGraphNode*> RootChildren = Root->GetChildren();
+		for (size_t j = 0; j < RootChildren.size(); j++)
+		{
+			if (RootChildren[j]->GetEntity() == Entity)
+			{
+				Node = RootChildren[j];
+				break;
+			}
+		}
+
+		if (Node == nullptr)
+			break;
+
+		Result.Nodes.push_back(Node);
+
+		if (i == 0)
+			continue;
+
+		size_t ParentIndex = 0;
+		switch (Shape)
+		{
+			case FE_BENCHMARK_SCENE_WIDE:
+				ParentIndex = 0;
+				break;
+			case FE_BENCHMARK_SCENE_DEEP:
+				ParentIndex = i - 1;
+				break;
+			case FE_BENCHMARK_SCENE_BALANCED:
+				ParentIndex = (i - 1) / BranchingFactor;
+				break;
+		}
+
+		// New entities have identity transforms, so there is nothing to preserve.
+		Root->DetachChild(Node, false);
+		Result.Nodes[ParentIndex]->AddChild(Node, false);
+	}
+
+	return Result;
+}
+
+void DeleteBenchmarkScene(FEBenchmarkScene& BenchmarkScene)
+{
+	if (BenchmarkScene.Scene != nullptr)
+	{
+		FESceneGraphChangeJournal::RemoveForScene(BenchmarkScene.Scene->GetObjectID());
+		FESceneGraphCommandQueue::RemoveForScene(BenchmarkScene.Scene->GetObjectID());
+		SCENE_MANAGER.DeleteScene(BenchmarkScene.Scene);
+	}
+
+	BenchmarkScene.Scene = nullptr;
+	BenchmarkScene.Nodes.clear();
+}
+
+FEHeadlessImGuiContext::FEHeadlessImGuiContext(ImVec2 DisplaySize)
+{
+	Context = ImGui::CreateContext();
+	ImGui::SetCurrentContext(Context);
+
+	ImGuiIO& IO = ImGui::GetIO();
+	IO.DisplaySize = DisplaySize;
+	IO.DeltaTime = 1.0f / 60.0f;
+	IO.IniFilename = nullptr;
+
+	// Without renderer backend font atlas should be built manually, texture data itself is never uploaded.
+	unsigned char* Pixels = nullptr;
+	int Width = 0, Height = 0;
+	IO.Fonts->GetTexDataAsRGBA32(&Pixels, &Width, &Height);
+}
+
+FEHeadlessImGuiContext::~FEHeadlessImGuiContext()
+{
+	ImGui::DestroyContext(Context);
+}
+
+void FEHeadlessImGuiContext::BeginFrame()
+{
+	ImGui::SetCurrentContext(Context);
+	ImGui::NewFrame();
+
+	ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+	ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+	ImGui::Begin("Scene graph UI benchmark");
+}
+
+FEBenchmarkDrawStatistics FEHeadlessImGuiContext::EndFrame()
+{
+	ImGui::End();
+	ImGui::Render();
+
+	FEBenchmarkDrawStatistics Result;
+	ImDrawData* DrawData = ImGui::GetDrawData();
+	if (DrawData == nullptr)
+		return Result;
+
+	Result.DrawListCount = static_cast<size_t>(DrawData->CmdListsCount);
+	Result.VertexCount = static_cast<size_t>(DrawData->TotalVtxCount);
+	Result.IndexCount = static_cast<size_t>(DrawData->TotalIdxCount);
+	for (int i = 0; i < DrawData->CmdListsCount; i++)
+		Result.DrawCommandCount += static_cast<size_t>(DrawData->CmdLists[i]->CmdBuffer.Size);
+
+	return Result;
+}
+
+void FEBenchmarkTimer::Start()
+{
+	StartTime = std::chrono::high_resolution_clock::now();
+}
+
+double FEBenchmarkTimer::GetElapsedMilliseconds() const
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - StartTime).count();
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+#include "../FESceneGraphUI.h"
+#include <chrono>
+
+enum FE_BENCHMARK_SCENE_SHAPE
+{
+	FE_BENCHMARK_SCENE_WIDE = 0,
+	FE_BENCHMARK_SCENE_DEEP = 1,
+	FE_BENCHMARK_SCENE_BALANCED = 2
+};
+
+std::string BenchmarkSceneShapeToString(FE_BENCHMARK_SCENE_SHAPE Shape);
+bool BenchmarkSceneShapeFromString(const std::string& String, FE_BENCHMARK_SCENE_SHAPE& OutShape);
+// Empty items are skipped, so "a,,b" and "a,b," give the same result.
+std::vector<std::string> SplitByComma(const std::string& Text);
+// The same string as FESceneGraphUI::GetFullVersion, without creating a panel.
+std::string GetBenchmarkVersionString();
+
+struct FEBenchmarkScene
+{
+	FEScene* Scene = nullptr;
+	// Nodes in creation order, first one is direct child of the scene root.
+	std::vector<FENaiveSceneGraphNode*> Nodes;
+};
+
+// Wide - all nodes are children of the first node.
+// Deep - every node is a child of the previous one.
+// Balanced - every node has up to BranchingFactor children.
+FEBenchmarkScene CreateBenchmarkScene(FE_BENCHMARK_SCENE_SHAPE Shape, size_t NodeCount, size_t BranchingFactor = 8);
+void DeleteBenchmarkScene(FEBenchmarkScene& BenchmarkScene);
+
+struct FEBenchmarkDrawStatistics
+{
+	size_t DrawListCount = 0;
+	size_t DrawCommandCount = 0;
+	size_t VertexCount = 0;
+	size_t IndexCount = 0;
+};
+
+// ImGui context without platform and renderer backends, so frames can be produced on a machine without GPU.
+class FEHeadlessImGuiContext
+{
+	ImGuiContext* Context = nullptr;
+public:
+	FEHeadlessImGuiContext(ImVec2 DisplaySize = ImVec2(1280.0f, 720.0f));
+	~FEHeadlessImGuiContext();
+
+	// Begins frame and a window that covers whole display.
+	void BeginFrame();
+	FEBenchmarkDrawStatistics EndFrame();
+};
+
+class FEBenchmarkTimer
+{
+	std::chrono::high_resolution_clock::time_point StartTime;
+public:
+	void Start();
+	double GetElapsedMilliseconds() const;
+};
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "FESceneGraphUIBenchmarkCommon.h"
+
+// Usage:
+//  FESceneGraphUIFrameBenchmark [--shapes wide,deep,balanced] [--sizes 10,1000,100000] [--scenarios collapsed,expanded,filter,widgets,multiselect]
+//                               [--frames 100] [--branching 8] [--csv]
+// Scene generation time is not included in results.
+// Panel loads its font from "Resources/Cousine-Regular.ttf", so benchmark should be started from the directory that contains it.
+
+struct FEFrameBenchmarkResult
+{
+	std::string Shape;
+	size_t NodeCount = 0;
+	std::string Scenario;
+	// "rebuild" - rows are invalidated every frame, "idle" - nothing changes between frames.
+	std::string Mode;
+	size_t FrameCount = 0;
+	double AverageMilliseconds = 0.0;
+	double MinMilliseconds = 0.0;
+	double MaxMilliseconds = 0.0;
+	double NodesVisitedPerFrame = 0.0;
+	size_t RowCount = 0;
+	FEBenchmarkDrawStatistics DrawStatistics;
+};
+
+static void SetupScenario(FESceneGraphUI& UI, FEBenchmarkScene& BenchmarkScene, const std::string& Scenario)
+{
+	FENaiveSceneGraphNode* Root = BenchmarkScene.Scene->SceneGraph.GetRoot();
+	UI.UpdateRowModel(Root, false);
+
+	if (Scenario == "collapsed")
+	{
+		UI.CollapseAllNodes();
+	}
+	else if (Scenario == "expanded")
+	{
+		UI.ExpandAllNodes();
+	}
+	else if (Scenario == "filter")
+	{
+		UI.ExpandAllNodes();
+		UI.SetFilterText("7");
+	}
+	else if (Scenario == "widgets")
+	{
+		UI.ExpandAllNodes();
+		for (size_t i = 0; i < 8; i++)
+		{
+			FESceneGraphNodeWidget Widget;
+			Widget.Icon = RESOURCE_MANAGER.NoTexture;
+			Widget.TooltipText = "Benchmark widget " + std::to_string(i);
+			Widget.bIsInteractive = i % 2 == 0;
+			Widget.IsVisiblePredicate = [i](FENaiveSceneGraphNode* Node) -> bool {
+				size_t Hash = std::hash<std::string>{}(Node->GetObjectID());
+				return (Hash >> i) % 3 != 0;
+			};
+			UI.AddNodeWidget(Widget);
+		}
+	}
+	else if (Scenario == "multiselect")
+	{
+		UI.SetMultipleNodeSelectionAllowed(true);
+		for (size_t i = 0; i < BenchmarkScene.Nodes.size(); i += 10)
+			UI.SetNodeSelected(BenchmarkScene.Nodes[i], true);
+	}
+}
+
+static FEFrameBenchmarkResult RunScenario(FEHeadlessImGuiContext& HeadlessContext, FEBenchmarkScene& BenchmarkScene, const std::string& Scenario, bool bRebuildEveryFrame, size_t FrameCount)
+{
+	FEFrameBenchmarkResult Result;
+	Result.NodeCount = BenchmarkScene.Nodes.size();
+	Result.Scenario = Scenario;
+	Result.Mode = bRebuildEveryFrame ? "rebuild" : "idle";
+	Result.FrameCount = FrameCount;
+	Result.MinMilliseconds = std::numeric_limits<double>::max();
+
+	FESceneGraphUI UI;
+	// Benchmark scene is changed only through the panel.
+	UI.SetSceneChangeJournalComplete(true);
+	SetupScenario(UI, BenchmarkScene, Scenario);
+	FENaiveSceneGraphNode* Root = BenchmarkScene.Scene->SceneGraph.GetRoot();
+
+	// Warm up frame, it would also build rows for idle mode.
+	HeadlessContext.BeginFrame();
+	UI.Render(Root, false);
+	HeadlessContext.EndFrame();
+
+	double TotalMilliseconds = 0.0;
+	size_t TotalNodesVisited = 0;
+	FEBenchmarkTimer Timer;
+	for (size_t i = 0; i < FrameCount; i++)
+	{
+		if (bRebuildEveryFrame)
+			UI.InvalidateCachedRows();
+
+		uint64_t VersionBeforeFrame = UI.GetRowModel().GetVersion();
+
+		HeadlessContext.BeginFrame();
+		Timer.Start();
+		UI.Render(Root, false);
+		double FrameMilliseconds = Timer.GetElapsedMilliseconds();
+		Result.DrawStatistics = HeadlessContext.EndFrame();
+
+		if (UI.GetRowModel().GetVersion() != VersionBeforeFrame)
+			TotalNodesVisited += UI.GetRowModel().GetVisitedNodeCount();
+
+		TotalMilliseconds += FrameMilliseconds;
+		Result.MinMilliseconds = std::min(Result.MinMilliseconds, FrameMilliseconds);
+		Result.MaxMilliseconds = std::max(Result.MaxMilliseconds, FrameMilliseconds);
+	}
+
+	if (FrameCount > 0)
+	{
+		Result.AverageMilliseconds = TotalMilliseconds / static_cast<double>(FrameCount);
+		Result.NodesVisitedPerFrame = static_cast<double>(TotalNodesVisited) / static_cast<double>(FrameCount);
+	}
+	Result.RowCount = UI.GetRowModel().GetRowCount();
+
+	return Result;
+}
+
+static void PrintResults(const std::vector<FEFrameBenchmarkResult>& Results, bool bCSV)
+{
+	if (bCSV)
+	{
+		printf("shape,nodes,scenario,mode,frames,avg_ms,min_ms,max_ms,nodes_visited_per_frame,rows,draw_lists,draw_commands,vertices,indices\n");
+		for (const FEFrameBenchmarkResult& Result : Results)
+		{
+			printf("%s,%zu,%s,%s,%zu,%.6f,%.6f,%.6f,%.1f,%zu,%zu,%zu,%zu,%zu\n",
+				   Result.Shape.c_str(), Result.NodeCount, Result.Scenario.c_str(), Result.Mode.c_str(), Result.FrameCount,
+				   Result.AverageMilliseconds, Result.MinMilliseconds, Result.MaxMilliseconds, Result.NodesVisitedPerFrame, Result.RowCount,
+				   Result.DrawStatistics.DrawListCount, Result.DrawStatistics.DrawCommandCount, Result.DrawStatistics.VertexCount, Result.DrawStatistics.IndexCount);
+		}
+
+		return;
+	}
+
+	printf("%-9s %9s %-12s %-8s %10s %10s %10s %14s %9s %10s %10s\n",
+		   "Shape", "Nodes", "Scenario", "Mode", "Avg ms", "Min ms", "Max ms", "Visited/frame", "Rows", "Draw cmds", "Vertices");
+	for (const FEFrameBenchmarkResult& Result : Results)
+	{
+		printf("%-9s %9zu %-12s %-8s %10.4f %10.4f %10.4f %14.1f %9zu %10zu %10zu\n",
+			   Result.Shape.c_str(), Result.NodeCount, Result.Scenario.c_str(), Result.Mode.c_str(),
+			   Result.AverageMilliseconds, Result.MinMilliseconds, Result.MaxMilliseconds, Result.NodesVisitedPerFrame, Result.RowCount,
+			   Result.DrawStatistics.DrawCommandCount, Result.DrawStatistics.VertexCount);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::string> Shapes = { "wide", "deep", "balanced" };
+	std::vector<std::string> Sizes = { "10", "1000", "10000", "100000" };
+	std::vector<std::string> Scenarios = { "collapsed", "expanded", "filter", "widgets", "multiselect" };
+	size_t FrameCount = 100;
+	size_t BranchingFactor = 8;
+	bool bCSV = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string Argument = argv[i];
+		bool bHasValue = i + 1 < argc;
+		if (Argument == "--shapes" && bHasValue)
+			Shapes = SplitByComma(argv[++i]);
+		else if (Argument == "--sizes" && bHasValue)
+			Sizes = SplitByComma(argv[++i]);
+		else if (Argument == "--scenarios" && bHasValue)
+			Scenarios = SplitByComma(argv[++i]);
+		else if (Argument == "--frames" && bHasValue)
+			FrameCount = std::stoull(argv[++i]);
+		else if (Argument == "--branching" && bHasValue)
+			BranchingFactor = std::stoull(argv[++i]);
+		else if (Argument == "--csv")
+			bCSV = true;
+		else
+		{
+			fprintf(stderr, "Unknown argument: %s\n", Argument.c_str());
+			return 1;
+		}
+	}
+
+	FEHeadlessImGuiContext HeadlessContext;
+	std::vector<FEFrameBenchmarkResult> Results;
+	for (const std::string& ShapeName : Shapes)
+	{
+		FE_BENCHMARK_SCENE_SHAPE Shape;
+		if (!BenchmarkSceneShapeFromString(ShapeName, Shape))
+		{
+			fprintf(stderr, "Unknown scene shape: %s\n", ShapeName.c_str());
+			return 1;
+		}
+
+		for (const std::string& Size : Sizes)
+		{
+			FEBenchmarkScene BenchmarkScene = CreateBenchmarkScene(Shape, std::stoull(Size), BranchingFactor);
+			if (BenchmarkScene.Scene == nullptr)
+			{
+				fprintf(stderr, "Failed to create benchmark scene.\n");
+				return 1;
+			}
+
+			for (const std::string& Scenario : Scenarios)
+			{
+				for (bool bRebuildEveryFrame : { true, false })
+				{
+					FEFrameBenchmarkResult Result = RunScenario(HeadlessContext, BenchmarkScene, Scenario, bRebuildEveryFrame, FrameCount);
+					Result.Shape = ShapeName;
+					Results.push_back(Result);
+				}
+			}
+
+			DeleteBenchmarkScene(BenchmarkScene);
+		}
+	}
+
+	PrintResults(Results, bCSV);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include "FESceneGraphUIBenchmarkCommon.h"
+
+// Usage:
+//  FESceneGraphUIMicroBenchmark [--shapes wide,deep,balanced] [--sizes 10,1000,100000] [--selection-sizes 1,10,1000]
+//                               [--iterations 100] [--branching 8] [--format csv|json] [--output FilePath]
+// Operations do not need ImGui context, so no frames are produced.
+// Selection size is only meaningful for selection operations, other operations report it as 0.
+// MoveBatch_drop reports number of dropped nodes as its selection size.
+
+struct FEMicroBenchmarkResult
+{
+	std::string Operation;
+	std::string Shape;
+	size_t NodeCount = 0;
+	size_t SelectionCount = 0;
+	size_t Iterations = 0;
+	double AverageMicroseconds = 0.0;
+	double MinMicroseconds = 0.0;
+	double MaxMicroseconds = 0.0;
+};
+
+// Setup is called before every iteration and is not timed.
+static FEMicroBenchmarkResult MeasureOperation(const std::string& Operation, size_t Iterations, std::function<void(size_t)> Setup, std::function<void(size_t)> Body)
+{
+	FEMicroBenchmarkResult Result;
+	Result.Operation = Operation;
+	Result.Iterations = Iterations;
+	Result.MinMicroseconds = std::numeric_limits<double>::max();
+
+	double TotalMicroseconds = 0.0;
+	FEBenchmarkTimer Timer;
+	for (size_t i = 0; i < Iterations; i++)
+	{
+		if (Setup != nullptr)
+			Setup(i);
+
+		Timer.Start();
+		Body(i);
+		double Microseconds = Timer.GetElapsedMilliseconds() * 1000.0;
+
+		TotalMicroseconds += Microseconds;
+		Result.MinMicroseconds = std::min(Result.MinMicroseconds, Microseconds);
+		Result.MaxMicroseconds = std::max(Result.MaxMicroseconds, Microseconds);
+	}
+
+	if (Iterations > 0)
+		Result.AverageMicroseconds = TotalMicroseconds / static_cast<double>(Iterations);
+	else
+		Result.MinMicroseconds = 0.0;
+
+	return Result;
+}
+
+// Nodes are picked evenly across creation order, so deep and balanced scenes get nodes from all levels.
+static FENaiveSceneGraphNode* GetSpreadNode(const FEBenchmarkScene& BenchmarkScene, size_t Index, size_t Count)
+{
+	if (BenchmarkScene.Nodes.empty() || Count == 0)
+		return nullptr;
+
+	size_t NodeIndex = (Index % Count) * BenchmarkScene.Nodes.size() / Count;
+	return BenchmarkScene.Nodes[std::min(NodeIndex, BenchmarkScene.Nodes.size() - 1)];
+}
+
+static void SelectNodes(FESceneGraphUI& UI, const FEBenchmarkScene& BenchmarkScene, size_t SelectionCount)
+{
+	SelectionCount = std::min(SelectionCount, BenchmarkScene.Nodes.size());
+	for (size_t i = 0; i < SelectionCount; i++)
+		UI.SetNodeSelected(GetSpreadNode(BenchmarkScene, i, SelectionCount), true);
+}
+
+static std::vector<FEMicroBenchmarkResult> RunSelectionIndependentOperations(const FEBenchmarkScene& BenchmarkScene, size_t Iterations)
+{
+	std::vector<FEMicroBenchmarkResult> Results;
+	FENaiveSceneGraphNode* Root = BenchmarkScene.Scene->SceneGraph.GetRoot();
+	FENaiveSceneGraphNode* DeepestNode = BenchmarkScene.Nodes.back();
+	const size_t NodeCount = BenchmarkScene.Nodes.size();
+
+	FESceneGraphUI UI;
+	UI.SetSceneChangeJournalComplete(true);
+	UI.UpdateRowModel(Root, false);
+
+	Results.push_back(MeasureOperation("SetNodeSelected_single", Iterations, nullptr, [&](size_t Iteration) {
+		UI.SetNodeSelected(GetSpreadNode(BenchmarkScene, Iteration, NodeCount), true);
+	}));
+
+	Results.push_back(MeasureOperation("ExpandAllNodes", Iterations, [&](size_t) { UI.CollapseAllNodes(); }, [&](size_t) {
+		UI.ExpandAllNodes();
+	}));
+
+	Results.push_back(MeasureOperation("CollapseAllNodes", Iterations, [&](size_t) { UI.ExpandAllNodes(); }, [&](size_t) {
+		UI.CollapseAllNodes();
+	}));
+
+	Results.push_back(MeasureOperation("ExpandToNode", Iterations, [&](size_t) { UI.CollapseAllNodes(); }, [&](size_t) {
+		UI.ExpandToNode(DeepestNode);
+	}));
+
+	// Viewport pick, including update of rows that the next frame would do.
+	Results.push_back(MeasureOperation("ScrollToNode_pick", Iterations, [&](size_t) { UI.CollapseAllNodes(); UI.UpdateRowModel(Root, false); }, [&](size_t Iteration) {
+		FENaiveSceneGraphNode* PickedNode = GetSpreadNode(BenchmarkScene, Iteration, NodeCount);
+		UI.SetNodeSelected(PickedNode, true);
+		UI.ScrollToNode(PickedNode);
+		UI.UpdateRowModel(Root, false);
+	}));
+
+	Results.push_back(MeasureOperation("IsNodeExpandedTo", Iterations, nullptr, [&](size_t) {
+		UI.IsNodeExpandedTo(DeepestNode);
+	}));
+
+	// Filter text that does not match anything forces full subtree search.
+	UI.SetFilterText("No node has this name");
+	Results.push_back(MeasureOperation("DoesNodePassTextFilter_miss", Iterations, nullptr, [&](size_t) {
+		UI.DoesNodePassTextFilter(BenchmarkScene.Nodes.front());
+	}));
+
+	UI.SetFilterText("Node_" + std::to_string(NodeCount - 1));
+	Results.push_back(MeasureOperation("DoesNodePassTextFilter_hit", Iterations, nullptr, [&](size_t Iteration) {
+		UI.DoesNodePassTextFilter(GetSpreadNode(BenchmarkScene, Iteration, NodeCount));
+	}));
+	UI.SetFilterText("");
+
+	UI.SetHiddenEntityTags({ "HiddenTag_0", "HiddenTag_1", "HiddenTag_2", "HiddenTag_3" });
+	Results.push_back(MeasureOperation("ShouldNodeBeVisible_tags", Iterations, nullptr, [&](size_t Iteration) {
+		UI.ShouldNodeBeVisible(GetSpreadNode(BenchmarkScene, Iteration, NodeCount));
+	}));
+
+	return Results;
+}
+
+static std::vector<FEMicroBenchmarkResult> RunSelectionOperations(const FEBenchmarkScene& BenchmarkScene, size_t SelectionCount, size_t Iterations)
+{
+	std::vector<FEMicroBenchmarkResult> Results;
+	FENaiveSceneGraphNode* Root = BenchmarkScene.Scene->SceneGraph.GetRoot();
+	const size_t NodeCount = BenchmarkScene.Nodes.size();
+
+	FESceneGraphUI UI;
+	UI.SetSceneChangeJournalComplete(true);
+	UI.SetMultipleNodeSelectionAllowed(true);
+	UI.UpdateRowModel(Root, false);
+	SelectNodes(UI, BenchmarkScene, SelectionCount);
+
+	// Toggles node that is not part of initial selection, so selection size stays the same between iterations.
+	FENaiveSceneGraphNode* ToggledNode = Root;
+	Results.push_back(MeasureOperation("SetNodeSelected_multi", Iterations, nullptr, [&](size_t Iteration) {
+		UI.SetNodeSelected(ToggledNode, Iteration % 2 == 0);
+	}));
+
+	Results.push_back(MeasureOperation("GetSelectedNodeIDs", Iterations, nullptr, [&](size_t) {
+		UI.GetSelectedNodeIDs();
+	}));
+
+	for (FEMicroBenchmarkResult& Result : Results)
+		Result.SelectionCount = std::min(SelectionCount, NodeCount);
+
+	return Results;
+}
+
+static FENaiveSceneGraphNode* CreateRootChild(FEScene* Scene, const std::string& Name)
+{
+	FEEntity* Entity = Scene->CreateEntity(Name);
+	for (FENaiveSceneGraphNode* Child : Scene->SceneGraph.GetRoot()->GetChildren())
+	{
+		if (Child->GetEntity() == Entity)
+			return Child;
+	}
+
+	return nullptr;
+}
+
+// Changes scene structure, so it should run after all other operations on the scene.
+static std::vector<FEMicroBenchmarkResult> RunMoveOperations(const FEBenchmarkScene& BenchmarkScene, size_t Iterations)
+{
+	std::vector<FEMicroBenchmarkResult> Results;
+	FEScene* Scene = BenchmarkScene.Scene;
+	const std::string SceneID = Scene->GetObjectID();
+
+	// Dropped nodes are moved between two targets, so every iteration moves them to a new parent.
+	FENaiveSceneGraphNode* DropTargets[2] = { CreateRootChild(Scene, "DropTarget_0"), CreateRootChild(Scene, "DropTarget_1") };
+	if (DropTargets[0] == nullptr || DropTargets[1] == nullptr)
+		return Results;
+
+	// Drop of 20k nodes, the last created nodes are the deepest ones in deep and balanced scenes.
+	const size_t DropCount = std::min(BenchmarkScene.Nodes.size(), static_cast<size_t>(20000));
+	std::vector<std::string> DroppedNodeIDs;
+	DroppedNodeIDs.reserve(DropCount);
+	for (size_t i = BenchmarkScene.Nodes.size() - DropCount; i < BenchmarkScene.Nodes.size(); i++)
+		DroppedNodeIDs.push_back(BenchmarkScene.Nodes[i]->GetObjectID());
+
+	// Panel that shows the scene keeps its index alive, otherwise every command would build it from scratch.
+	FESceneGraphIndex* SceneIndex = FESceneGraphIndex::Acquire(SceneID);
+	SceneIndex->Update();
+
+	const size_t OldMaxCommandsAppliedPerFrame = FESceneGraphCommandQueue::GetMaxCommandsAppliedPerFrame(SceneID);
+	FESceneGraphCommandQueue::SetMaxCommandsAppliedPerFrame(SceneID, 0);
+
+	// Every iteration changes parents of thousands of nodes, so fewer iterations are enough.
+	Results.push_back(MeasureOperation("MoveBatch_drop", std::min(Iterations, static_cast<size_t>(10)), [&](size_t Iteration) {
+		FESceneGraphUICommand Command;
+		Command.Type = FE_SCENE_GRAPH_UI_COMMAND_MOVE_BATCH;
+		Command.SceneID = SceneID;
+		Command.NodeIDs = DroppedNodeIDs;
+		Command.TargetNodeID = DropTargets[Iteration % 2]->GetObjectID();
+		FESceneGraphCommandQueue::Push(Command);
+	}, [&](size_t) {
+		FESceneGraphCommandQueue::ApplyAll(true);
+	}));
+
+	FESceneGraphCommandQueue::SetMaxCommandsAppliedPerFrame(SceneID, OldMaxCommandsAppliedPerFrame);
+	FESceneGraphIndex::Release(SceneIndex);
+	for (FEMicroBenchmarkResult& Result : Results)
+		Result.SelectionCount = DropCount;
+
+	return Results;
+}
+
+static void WriteCSV(FILE* File, const std::vector<FEMicroBenchmarkResult>& Results)
+{
+	fprintf(File, "operation,shape,nodes,selection,iterations,avg_us,min_us,max_us\n");
+	for (const FEMicroBenchmarkResult& Result : Results)
+	{
+		fprintf(File, "%s,%s,%zu,%zu,%zu,%.4f,%.4f,%.4f\n",
+				Result.Operation.c_str(), Result.Shape.c_str(), Result.NodeCount, Result.SelectionCount, Result.Iterations,
+				Result.AverageMicroseconds, Result.MinMicroseconds, Result.MaxMicroseconds);
+	}
+}
+
+static void WriteJSON(FILE* File, const std::vector<FEMicroBenchmarkResult>& Results)
+{
+	fprintf(File, "{\n\t\"version\": \"%s\",\n\t\"results\": [\n", GetBenchmarkVersionString().c_str());
+	for (size_t i = 0; i < Results.size(); i++)
+	{
+		const FEMicroBenchmarkResult& Result = Results[i];
+		fprintf(File, "\t\t{ \"operation\": \"%s\", \"shape\": \"%s\", \"nodes\": %zu, \"selection\": %zu, \"iterations\": %zu, \"avg_us\": %.4f, \"min_us\": %.4f, \"max_us\": %.4f }%s\n",
+				Result.Operation.c_str(), Result.Shape.c_str(), Result.NodeCount, Result.SelectionCount, Result.Iterations,
+				Result.AverageMicroseconds, Result.MinMicroseconds, Result.MaxMicroseconds, i + 1 < Results.size() ? "," : "");
+	}
+	fprintf(File, "\t]\n}\n");
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::string> Shapes = { "wide", "deep", "balanced" };
+	std::vector<std::string> Sizes = { "10", "1000", "10000", "100000" };
+	std::vector<std::string> SelectionSizes = { "1", "10", "1000" };
+	size_t Iterations = 100;
+	size_t BranchingFactor = 8;
+	std::string Format = "csv";
+	std::string OutputFilePath = "";
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string Argument = argv[i];
+		bool bHasValue = i + 1 < argc;
+		if (Argument == "--shapes" && bHasValue)
+			Shapes = SplitByComma(argv[++i]);
+		else if (Argument == "--sizes" && bHasValue)
+			Sizes = SplitByComma(argv[++i]);
+		else if (Argument == "--selection-sizes" && bHasValue)
+			SelectionSizes = SplitByComma(argv[++i]);
+		else if (Argument == "--iterations" && bHasValue)
+			Iterations = std::stoull(argv[++i]);
+		else if (Argument == "--branching" && bHasValue)
+			BranchingFactor = std::stoull(argv[++i]);
+		else if (Argument == "--format" && bHasValue)
+			Format = argv[++i];
+		else if (Argument == "--output" && bHasValue)
+			OutputFilePath = argv[++i];
+		else
+		{
+			fprintf(stderr, "Unknown argument: %s\n", Argument.c_str());
+			return 1;
+		}
+	}
+
+	if (Format != "csv" && Format != "json")
+	{
+		fprintf(stderr, "Unknown format: %s\n", Format.c_str());
+		return 1;
+	}
+
+	std::vector<FEMicroBenchmarkResult> Results;
+	for (const std::string& ShapeName : Shapes)
+	{
+		FE_BENCHMARK_SCENE_SHAPE Shape;
+		if (!BenchmarkSceneShapeFromString(ShapeName, Shape))
+		{
+			fprintf(stderr, "Unknown scene shape: %s\n", ShapeName.c_str());
+			return 1;
+		}
+
+		for (const std::string& Size : Sizes)
+		{
+			FEBenchmarkScene BenchmarkScene = CreateBenchmarkScene(Shape, std::stoull(Size), BranchingFactor);
+			if (BenchmarkScene.Scene == nullptr || BenchmarkScene.Nodes.empty())
+			{
+				fprintf(stderr, "Failed to create benchmark scene.\n");
+				return 1;
+			}
+
+			std::vector<FEMicroBenchmarkResult> SceneResults = RunSelectionIndependentOperations(BenchmarkScene, Iterations);
+			for (const std::string& SelectionSize : SelectionSizes)
+			{
+				std::vector<FEMicroBenchmarkResult> SelectionResults = RunSelectionOperations(BenchmarkScene, std::stoull(SelectionSize), Iterations);
+				SceneResults.insert(SceneResults.end(), SelectionResults.begin(), SelectionResults.end());
+			}
+
+			std::vector<FEMicroBenchmarkResult> MoveResults = RunMoveOperations(BenchmarkScene, Iterations);
+			SceneResults.insert(SceneResults.end(), MoveResults.begin(), MoveResults.end());
+
+			for (FEMicroBenchmarkResult& Result : SceneResults)
+			{
+				Result.Shape = ShapeName;
+				Result.NodeCount = BenchmarkScene.Nodes.size();
+				Results.push_back(Result);
+			}
+
+			DeleteBenchmarkScene(BenchmarkScene);
+		}
+	}
+
+	FILE* OutputFile = stdout;
+	if (!OutputFilePath.empty())
+	{
+		OutputFile = fopen(OutputFilePath.c_str(), "w");
+		if (OutputFile == nullptr)
+		{
+			fprintf(stderr, "Could not open output file: %s\n", OutputFilePath.c_str());
+			return 1;
+		}
+	}
+
+	if (Format == "json")
+		WriteJSON(OutputFile, Results);
+	else
+		WriteCSV(OutputFile, Results);
+
+	if (OutputFile != stdout)
+		fclose(OutputFile);
+
+	return 0;
+}
\ No newline at end of file
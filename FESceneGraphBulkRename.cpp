@@ -0,0 +1,120 @@
+#include "FESceneGraphBulkRename.h"
+
+FESceneGraphBulkRename::FESceneGraphBulkRename(const FESceneGraphBulkRenameOptions& Options) : Options(Options)
+{
+	bValid = true;
+	if (Options.bUseRegex && !Options.Find.empty())
+	{
+		std::regex_constants::syntax_option_type Flags = std::regex_constants::ECMAScript;
+		if (!Options.bCaseSensitive)
+			Flags |= std::regex_constants::icase;
+
+		try
+		{
+			FindRegex = std::regex(Options.Find, Flags);
+		}
+		catch (const std::regex_error& Exception)
+		{
+			bValid = false;
+			Error = Exception.what();
+		}
+	}
+}
+
+bool FESceneGraphBulkRename::IsValid() const
+{
+	return bValid;
+}
+
+std::string FESceneGraphBulkRename::GetError() const
+{
+	return Error;
+}
+
+std::string FESceneGraphBulkRename::ApplyFindReplace(const std::string& Name) const
+{
+	if (Options.Find.empty())
+		return Name;
+
+	if (Options.bUseRegex)
+		return std::regex_replace(Name, FindRegex, Options.Replace);
+
+	std::string SearchedName = Name;
+	std::string Find = Options.Find;
+	if (!Options.bCaseSensitive)
+	{
+		std::transform(SearchedName.begin(), SearchedName.end(), SearchedName.begin(), ::tolower);
+		std::transform(Find.begin(), Find.end(), Find.begin(), ::tolower);
+	}
+
+	std::string Result;
+	size_t Position = 0;
+	size_t MatchPosition = SearchedName.find(Find);
+	while (MatchPosition != std::string::npos)
+	{
+		Result.append(Name, Position, MatchPosition - Position);
+		Result += Options.Replace;
+		Position = MatchPosition + Find.size();
+		MatchPosition = SearchedName.find(Find, Position);
+	}
+	Result.append(Name, Position, std::string::npos);
+
+	return Result;
+}
+
+std::string FESceneGraphBulkRename::ApplyTemplate(const std::string& Name, size_t Counter) const
+{
+	const std::string& Template = Options.NameTemplate;
+	std::string Result;
+	Result.reserve(Template.size() + Name.size());
+
+	size_t i = 0;
+	while (i < Template.size())
+	{
+		if (Template.compare(i, 3, "[N]") == 0)
+		{
+			Result += Name;
+			i += 3;
+		}
+		else if (Template[i] == '#')
+		{
+			size_t RunLength = 0;
+			while (i < Template.size() && Template[i] == '#')
+			{
+				RunLength++;
+				i++;
+			}
+
+			std::string CounterText = std::to_string(Counter);
+			if (CounterText.size() < RunLength)
+				Result.append(RunLength - CounterText.size(), '0');
+			Result += CounterText;
+		}
+		else
+		{
+			Result += Template[i];
+			i++;
+		}
+	}
+
+	return Result;
+}
+
+std::string FESceneGraphBulkRename::GetNewName(const std::string& Name, size_t Index) const
+{
+	if (!bValid)
+		return Name;
+
+	size_t Counter = Options.CounterStart + Index * Options.CounterStep;
+	return Options.Prefix + ApplyTemplate(ApplyFindReplace(Name), Counter) + Options.Suffix;
+}
+
+std::vector<std::string> FESceneGraphBulkRename::GetNewNames(const std::vector<std::string>& Names) const
+{
+	std::vector<std::string> Result;
+	Result.reserve(Names.size());
+	for (size_t i = 0; i < Names.size(); i++)
+		Result.push_back(GetNewName(Names[i], i));
+
+	return Result;
+}
\ No newline at end of file
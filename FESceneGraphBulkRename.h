@@ -0,0 +1,42 @@
+#pragma once
+#include "FEngine.h"
+#include <regex>
+
+// Name template syntax:
+// [N] is the current name after find and replace, every run of '#' is a counter padded with zeros to the run length.
+// For example "Mesh_###" gives Mesh_001, Mesh_002 and "[N]_LOD#" gives Rock_LOD1, Tree_LOD2.
+struct FESceneGraphBulkRenameOptions
+{
+	std::string NameTemplate = "[N]";
+	std::string Find = "";
+	// With regex, $1, $2 and so on insert capture groups.
+	std::string Replace = "";
+	bool bUseRegex = false;
+	bool bCaseSensitive = true;
+	std::string Prefix = "";
+	std::string Suffix = "";
+	size_t CounterStart = 1;
+	size_t CounterStep = 1;
+};
+
+// Produces new names for a list of names, it does not know about scenes, so it can be used for preview.
+// Regex is compiled once for the whole list.
+class FESceneGraphBulkRename
+{
+	FESceneGraphBulkRenameOptions Options;
+	bool bValid = false;
+	std::string Error = "";
+	std::regex FindRegex;
+
+	std::string ApplyFindReplace(const std::string& Name) const;
+	std::string ApplyTemplate(const std::string& Name, size_t Counter) const;
+public:
+	FESceneGraphBulkRename(const FESceneGraphBulkRenameOptions& Options);
+
+	bool IsValid() const;
+	std::string GetError() const;
+
+	// Index is the position of the name in the renamed list, it drives the counter.
+	std::string GetNewName(const std::string& Name, size_t Index) const;
+	std::vector<std::string> GetNewNames(const std::vector<std::string>& Names) const;
+};
\ No newline at end of file
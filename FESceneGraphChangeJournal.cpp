@@ -0,0 +1,134 @@
+#include "FESceneGraphChangeJournal.h"
+
+std::unordered_map<std::string, FESceneGraphChangeJournal> FESceneGraphChangeJournal::SceneJournals;
+
+FESceneGraphChangeJournal& FESceneGraphChangeJournal::GetForScene(const std::string& SceneID)
+{
+	return SceneJournals[SceneID];
+}
+
+void FESceneGraphChangeJournal::RemoveForScene(const std::string& SceneID)
+{
+	SceneJournals.erase(SceneID);
+}
+
+void FESceneGraphChangeJournal::Acquire(const std::string& SceneID)
+{
+	if (SceneID.empty())
+		return;
+
+	SceneJournals[SceneID].ReferenceCount++;
+}
+
+void FESceneGraphChangeJournal::Release(const std::string& SceneID)
+{
+	auto Iterator = SceneJournals.find(SceneID);
+	if (Iterator == SceneJournals.end() || Iterator->second.ReferenceCount == 0)
+		return;
+
+	if (--Iterator->second.ReferenceCount == 0)
+		SceneJournals.erase(Iterator);
+
+	// Journals that were only written to (e.g. by commands) are dropped together with their scene.
+	for (auto JournalIterator = SceneJournals.begin(); JournalIterator != SceneJournals.end();)
+	{
+		if (JournalIterator->second.ReferenceCount == 0 && SCENE_MANAGER.GetSceneByID(JournalIterator->first) == nullptr)
+		{
+			JournalIterator = SceneJournals.erase(JournalIterator);
+		}
+		else
+		{
+			JournalIterator++;
+		}
+	}
+}
+
+size_t FESceneGraphChangeJournal::GetReferenceCount() const
+{
+	return ReferenceCount;
+}
+
+uint64_t FESceneGraphChangeJournal::Record(FE_SCENE_GRAPH_CHANGE_TYPE Type, const std::string& NodeID, const std::string& ParentID, const std::string& PreviousParentID)
+{
+	FESceneGraphChangeRecord NewRecord;
+	NewRecord.Sequence = ++LastSequence;
+	// Nobody could read it, consumers that come later start from the current sequence.
+	if (ReferenceCount == 0)
+		return LastSequence;
+
+	NewRecord.Type = Type;
+	NewRecord.NodeID = NodeID;
+	NewRecord.ParentID = ParentID;
+	NewRecord.PreviousParentID = PreviousParentID;
+	Records.push_back(NewRecord);
+
+	while (Records.size() > Capacity)
+		Records.pop_front();
+
+	return LastSequence;
+}
+
+void FESceneGraphChangeJournal::RecordNodeAdded(FENaiveSceneGraphNode* Node)
+{
+	if (Node == nullptr)
+		return;
+
+	Record(FE_SCENE_GRAPH_CHANGE_NODE_ADDED, Node->GetObjectID(), Node->GetParent() == nullptr ? "" : Node->GetParent()->GetObjectID());
+}
+
+void FESceneGraphChangeJournal::RecordNodeRemoved(const std::string& NodeID, const std::string& PreviousParentID)
+{
+	Record(FE_SCENE_GRAPH_CHANGE_NODE_REMOVED, NodeID, "", PreviousParentID);
+}
+
+void FESceneGraphChangeJournal::RecordNodeReparented(FENaiveSceneGraphNode* Node, const std::string& PreviousParentID)
+{
+	if (Node == nullptr)
+		return;
+
+	Record(FE_SCENE_GRAPH_CHANGE_NODE_REPARENTED, Node->GetObjectID(), Node->GetParent() == nullptr ? "" : Node->GetParent()->GetObjectID(), PreviousParentID);
+}
+
+void FESceneGraphChangeJournal::RecordNodeRenamed(FENaiveSceneGraphNode* Node)
+{
+	if (Node == nullptr)
+		return;
+
+	Record(FE_SCENE_GRAPH_CHANGE_NODE_RENAMED, Node->GetObjectID(), Node->GetParent() == nullptr ? "" : Node->GetParent()->GetObjectID());
+}
+
+uint64_t FESceneGraphChangeJournal::GetLastSequence() const
+{
+	return LastSequence;
+}
+
+bool FESceneGraphChangeJournal::GetChangesSince(uint64_t Sequence, std::vector<FESceneGraphChangeRecord>& OutChanges) const
+{
+	OutChanges.clear();
+	if (Sequence >= LastSequence)
+		return true;
+
+	// Oldest record that consumer needs was already discarded.
+	if (Records.empty() || Records.front().Sequence > Sequence + 1)
+		return false;
+
+	// Sequence numbers are contiguous, so position of the first needed record can be computed directly.
+	size_t FirstIndex = static_cast<size_t>(Sequence + 1 - Records.front().Sequence);
+	OutChanges.reserve(Records.size() - FirstIndex);
+	for (size_t i = FirstIndex; i < Records.size(); i++)
+		OutChanges.push_back(Records[i]);
+
+	return true;
+}
+
+size_t FESceneGraphChangeJournal::GetCapacity() const
+{
+	return Capacity;
+}
+
+void FESceneGraphChangeJournal::SetCapacity(size_t NewCapacity)
+{
+	Capacity = std::max(NewCapacity, static_cast<size_t>(1));
+	while (Records.size() > Capacity)
+		Records.pop_front();
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include "FEngine.h"
+#include <deque>
+
+enum FE_SCENE_GRAPH_CHANGE_TYPE
+{
+	FE_SCENE_GRAPH_CHANGE_NODE_ADDED = 0,
+	FE_SCENE_GRAPH_CHANGE_NODE_REMOVED = 1,
+	FE_SCENE_GRAPH_CHANGE_NODE_REPARENTED = 2,
+	FE_SCENE_GRAPH_CHANGE_NODE_RENAMED = 3
+};
+
+struct FESceneGraphChangeRecord
+{
+	uint64_t Sequence = 0;
+	FE_SCENE_GRAPH_CHANGE_TYPE Type = FE_SCENE_GRAPH_CHANGE_NODE_ADDED;
+	std::string NodeID = "";
+	// Parent after the change for added, reparented and renamed nodes.
+	std::string ParentID = "";
+	// Parent before the change for removed and reparented nodes, empty if it was not known to the recorder.
+	std::string PreviousParentID = "";
+};
+
+// Per-scene list of scene graph changes with increasing sequence numbers.
+// Consumers remember last sequence they have seen and apply only changes after it,
+// so catching up after being hidden costs O(changes) instead of O(scene).
+// Journal is not thread-safe, changes should be recorded on the thread that renders UI.
+class FESceneGraphChangeJournal
+{
+	std::deque<FESceneGraphChangeRecord> Records;
+	uint64_t LastSequence = 0;
+	size_t Capacity = 65536;
+	size_t ReferenceCount = 0;
+
+	static std::unordered_map<std::string, FESceneGraphChangeJournal> SceneJournals;
+public:
+	static FESceneGraphChangeJournal& GetForScene(const std::string& SceneID);
+	static void RemoveForScene(const std::string& SceneID);
+
+	// Consumers (panels, scene index) hold a reference for every scene they follow.
+	// Changes are stored only while journal has consumers, journal is deleted with the last reference.
+	static void Acquire(const std::string& SceneID);
+	static void Release(const std::string& SceneID);
+	size_t GetReferenceCount() const;
+
+	uint64_t Record(FE_SCENE_GRAPH_CHANGE_TYPE Type, const std::string& NodeID, const std::string& ParentID = "", const std::string& PreviousParentID = "");
+	void RecordNodeAdded(FENaiveSceneGraphNode* Node);
+	// Consumers update caches of the parent only, so it should be passed whenever it is known.
+	// Removal of a node with descendants still in the index makes the scene index rebuild,
+	// recording descendants first (deepest first) keeps the update incremental.
+	void RecordNodeRemoved(const std::string& NodeID, const std::string& PreviousParentID = "");
+	void RecordNodeReparented(FENaiveSceneGraphNode* Node, const std::string& PreviousParentID = "");
+	void RecordNodeRenamed(FENaiveSceneGraphNode* Node);
+
+	uint64_t GetLastSequence() const;
+
+	// Returns false if some changes after Sequence were already discarded, in that case consumer should rescan the scene.
+	bool GetChangesSince(uint64_t Sequence, std::vector<FESceneGraphChangeRecord>& OutChanges) const;
+
+	size_t GetCapacity() const;
+	void SetCapacity(size_t NewCapacity);
+};
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "FESceneGraphChildrenSorting.h"
+
+bool FESceneGraphSortedChildren::NaturalLess(const std::string& First, const std::string& Second)
+{
+	size_t FirstIndex = 0;
+	size_t SecondIndex = 0;
+	while (FirstIndex < First.size() && SecondIndex < Second.size())
+	{
+		bool bFirstDigit = isdigit(static_cast<unsigned char>(First[FirstIndex])) != 0;
+		bool bSecondDigit = isdigit(static_cast<unsigned char>(Second[SecondIndex])) != 0;
+		if (bFirstDigit && bSecondDigit)
+		{
+			// Leading zeros are skipped, then longer number is bigger, numbers of the same length are compared digit by digit.
+			while (FirstIndex < First.size() && First[FirstIndex] == '0')
+				FirstIndex++;
+			while (SecondIndex < Second.size() && Second[SecondIndex] == '0')
+				SecondIndex++;
+
+			size_t FirstNumberEnd = FirstIndex;
+			while (FirstNumberEnd < First.size() && isdigit(static_cast<unsigned char>(First[FirstNumberEnd])))
+				FirstNumberEnd++;
+			size_t SecondNumberEnd = SecondIndex;
+			while (SecondNumberEnd < Second.size() && isdigit(static_cast<unsigned char>(Second[SecondNumberEnd])))
+				SecondNumberEnd++;
+
+			size_t FirstNumberLength = FirstNumberEnd - FirstIndex;
+			size_t SecondNumberLength = SecondNumberEnd - SecondIndex;
+			if (FirstNumberLength != SecondNumberLength)
+				return FirstNumberLength < SecondNumberLength;
+
+			int Comparison = First.compare(FirstIndex, FirstNumberLength, Second, SecondIndex, SecondNumberLength);
+			if (Comparison != 0)
+				return Comparison < 0;
+
+			FirstIndex = FirstNumberEnd;
+			SecondIndex = SecondNumberEnd;
+			continue;
+		}
+
+		if (First[FirstIndex] != Second[SecondIndex])
+			return First[FirstIndex] < Second[SecondIndex];
+
+		FirstIndex++;
+		SecondIndex++;
+	}
+
+	return First.size() - FirstIndex < Second.size() - SecondIndex;
+}
+
+bool FESceneGraphSortedChildren::IsBefore(const std::string& FirstKey, const std::string& SecondKey) const
+{
+	if (!bAscending)
+		return bNaturalOrder ? NaturalLess(SecondKey, FirstKey) : SecondKey < FirstKey;
+
+	return bNaturalOrder ? NaturalLess(FirstKey, SecondKey) : FirstKey < SecondKey;
+}
+
+bool FESceneGraphSortedChildren::IsBuilt() const
+{
+	return bBuilt;
+}
+
+void FESceneGraphSortedChildren::Build(const std::vector<FENaiveSceneGraphNode*>& Children, std::function<std::string(FENaiveSceneGraphNode*)> KeyProvider, bool bNaturalOrder, bool bAscending)
+{
+	this->bNaturalOrder = bNaturalOrder;
+	this->bAscending = bAscending;
+	StaleNodeIDs.clear();
+
+	Entries.clear();
+	Entries.reserve(Children.size());
+	for (size_t i = 0; i < Children.size(); i++)
+		Entries.push_back({ Children[i], Children[i]->GetObjectID(), KeyProvider(Children[i]) });
+
+	// Stable, so children with equal keys keep storage order.
+	std::stable_sort(Entries.begin(), Entries.end(), [this](const FESceneGraphSortedChild& First, const FESceneGraphSortedChild& Second) {
+		return IsBefore(First.Key, Second.Key);
+	});
+
+	bBuilt = true;
+}
+
+void FESceneGraphSortedChildren::Update(const std::vector<FENaiveSceneGraphNode*>& Children, std::function<std::string(FENaiveSceneGraphNode*)> KeyProvider)
+{
+	// Equal sizes do not mean the same members, e.g. one child could be moved out and another moved in.
+	// Entry pointer is dereferenced only if it is one of current children, so entries of deleted nodes are safe to check.
+	std::unordered_set<FENaiveSceneGraphNode*> ChildSet(Children.begin(), Children.end());
+	Entries.erase(std::remove_if(Entries.begin(), Entries.end(), [&](const FESceneGraphSortedChild& Entry) {
+		if (StaleNodeIDs.find(Entry.NodeID) != StaleNodeIDs.end() || ChildSet.find(Entry.Node) == ChildSet.end())
+			return true;
+
+		// Memory of deleted node could be reused by a new child.
+		return Entry.Node->GetObjectID() != Entry.NodeID;
+	}), Entries.end());
+	StaleNodeIDs.clear();
+
+	if (Entries.size() == Children.size())
+		return;
+
+	std::unordered_set<FENaiveSceneGraphNode*> SortedNodes;
+	SortedNodes.reserve(Entries.size());
+	for (size_t i = 0; i < Entries.size(); i++)
+		SortedNodes.insert(Entries[i].Node);
+
+	std::vector<FENaiveSceneGraphNode*> MissingChildren;
+	for (size_t i = 0; i < Children.size(); i++)
+	{
+		if (SortedNodes.find(Children[i]) == SortedNodes.end())
+			MissingChildren.push_back(Children[i]);
+	}
+
+	// Each insertion shifts the tail of the vector, for big batches one sort is cheaper.
+	if (MissingChildren.size() > Entries.size() / 4)
+	{
+		Build(Children, KeyProvider, bNaturalOrder, bAscending);
+		return;
+	}
+
+	for (size_t i = 0; i < MissingChildren.size(); i++)
+	{
+		FESceneGraphSortedChild NewEntry = { MissingChildren[i], MissingChildren[i]->GetObjectID(), KeyProvider(MissingChildren[i]) };
+		auto Position = std::upper_bound(Entries.begin(), Entries.end(), NewEntry, [this](const FESceneGraphSortedChild& First, const FESceneGraphSortedChild& Second) {
+			return IsBefore(First.Key, Second.Key);
+		});
+		Entries.insert(Position, std::move(NewEntry));
+	}
+}
+
+void FESceneGraphSortedChildren::MarkStale(const std::string& NodeID)
+{
+	if (bBuilt)
+		StaleNodeIDs.insert(NodeID);
+}
+
+int FESceneGraphSortedChildren::FindPosition(const std::string& NodeID, const std::string& Key) const
+{
+	auto Iterator = std::lower_bound(Entries.begin(), Entries.end(), Key, [this](const FESceneGraphSortedChild& Entry, const std::string& SearchKey) {
+		return IsBefore(Entry.Key, SearchKey);
+	});
+
+	// Children with equal keys are next to each other.
+	for (; Iterator != Entries.end() && !IsBefore(Key, Iterator->Key); Iterator++)
+	{
+		if (Iterator->NodeID == NodeID)
+			return static_cast<int>(Iterator - Entries.begin());
+	}
+
+	return -1;
+}
+
+const std::vector<FESceneGraphSortedChild>& FESceneGraphSortedChildren::GetEntries() const
+{
+	return Entries;
+}
+
+std::vector<FENaiveSceneGraphNode*> FESceneGraphSortedChildren::GetNodes() const
+{
+	std::vector<FENaiveSceneGraphNode*> Result;
+	Result.reserve(Entries.size());
+	for (size_t i = 0; i < Entries.size(); i++)
+		Result.push_back(Entries[i].Node);
+
+	return Result;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include "FEngine.h"
+#include <unordered_set>
+
+enum FE_SCENE_GRAPH_UI_CHILDREN_SORT_MODE
+{
+	// Order in which children are stored in the scene graph.
+	FE_SCENE_GRAPH_UI_CHILDREN_SORT_STORAGE = 0,
+	FE_SCENE_GRAPH_UI_CHILDREN_SORT_NAME = 1,
+	// Numbers inside names are compared by value, so Tree_2 goes before Tree_10.
+	FE_SCENE_GRAPH_UI_CHILDREN_SORT_NATURAL_NAME = 2,
+	FE_SCENE_GRAPH_UI_CHILDREN_SORT_TAG = 3,
+	FE_SCENE_GRAPH_UI_CHILDREN_SORT_ENTITY_TYPE = 4,
+	FE_SCENE_GRAPH_UI_CHILDREN_SORT_CUSTOM = 5
+};
+
+struct FESceneGraphSortedChild
+{
+	FENaiveSceneGraphNode* Node = nullptr;
+	// Kept with the entry, because node could be already deleted when its removal is processed.
+	std::string NodeID = "";
+	std::string Key = "";
+};
+
+// Cached permutation of children of one parent.
+// After it is built, it is updated incrementally: stale entries are removed and missing children are inserted at their sorted position.
+class FESceneGraphSortedChildren
+{
+	std::vector<FESceneGraphSortedChild> Entries;
+	std::unordered_set<std::string> StaleNodeIDs;
+	bool bBuilt = false;
+	bool bNaturalOrder = false;
+	bool bAscending = true;
+
+	bool IsBefore(const std::string& FirstKey, const std::string& SecondKey) const;
+public:
+	static bool NaturalLess(const std::string& First, const std::string& Second);
+
+	bool IsBuilt() const;
+	void Build(const std::vector<FENaiveSceneGraphNode*>& Children, std::function<std::string(FENaiveSceneGraphNode*)> KeyProvider, bool bNaturalOrder, bool bAscending);
+	// Brings permutation in sync with current children, falls back to full rebuild only if most of the children have changed.
+	void Update(const std::vector<FENaiveSceneGraphNode*>& Children, std::function<std::string(FENaiveSceneGraphNode*)> KeyProvider);
+	// Entry of the node would be removed on next update and, if node is still a child, inserted again with new key.
+	void MarkStale(const std::string& NodeID);
+
+	// Binary search by key, Key should be current sort key of the node. Returns -1 if node is not in the permutation.
+	int FindPosition(const std::string& NodeID, const std::string& Key) const;
+
+	const std::vector<FESceneGraphSortedChild>& GetEntries() const;
+	std::vector<FENaiveSceneGraphNode*> GetNodes() const;
+};
\ No newline at end of file
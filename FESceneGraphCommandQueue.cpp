@@ -0,0 +1,303 @@
+#include "FESceneGraphCommandQueue.h"
+
+std::mutex FESceneGraphCommandQueue::QueuesMutex;
+std::unordered_map<std::string, std::unique_ptr<FESceneGraphCommandQueue>> FESceneGraphCommandQueue::SceneQueues;
+
+FESceneGraphCommandQueue::FESceneGraphCommandQueue(const std::string& SceneID)
+{
+	this->SceneID = SceneID;
+}
+
+bool FESceneGraphCommandQueue::ReparentNode(FENaiveSceneGraphNode* Node, FENaiveSceneGraphNode* NewParent)
+{
+	// Root has no parent and can not be moved.
+	if (Node == nullptr || NewParent == nullptr || Node == NewParent || Node->GetParent() == nullptr)
+		return false;
+
+	Node->GetParent()->DetachChild(Node);
+	NewParent->AddChild(Node);
+	return true;
+}
+
+void FESceneGraphCommandQueue::Push(const FESceneGraphUICommand& Command)
+{
+	if (Command.SceneID.empty())
+		return;
+
+	std::lock_guard<std::mutex> Lock(QueuesMutex);
+	std::unique_ptr<FESceneGraphCommandQueue>& Queue = SceneQueues[Command.SceneID];
+	if (Queue == nullptr)
+		Queue = std::make_unique<FESceneGraphCommandQueue>(Command.SceneID);
+
+	Queue->IncomingCommands.push_back(Command);
+}
+
+size_t FESceneGraphCommandQueue::GetQueuedCommandCount(const std::string& SceneID)
+{
+	std::lock_guard<std::mutex> Lock(QueuesMutex);
+	auto Iterator = SceneQueues.find(SceneID);
+	if (Iterator == SceneQueues.end())
+		return 0;
+
+	return Iterator->second->IncomingCommands.size() + Iterator->second->PendingCommandCount.load();
+}
+
+size_t FESceneGraphCommandQueue::GetMaxCommandsAppliedPerFrame(const std::string& SceneID)
+{
+	std::lock_guard<std::mutex> Lock(QueuesMutex);
+	auto Iterator = SceneQueues.find(SceneID);
+	if (Iterator == SceneQueues.end())
+		return DefaultMaxCommandsAppliedPerFrame;
+
+	return Iterator->second->MaxCommandsAppliedPerFrame;
+}
+
+void FESceneGraphCommandQueue::SetMaxCommandsAppliedPerFrame(const std::string& SceneID, size_t NewValue)
+{
+	if (SceneID.empty())
+		return;
+
+	std::lock_guard<std::mutex> Lock(QueuesMutex);
+	std::unique_ptr<FESceneGraphCommandQueue>& Queue = SceneQueues[SceneID];
+	if (Queue == nullptr)
+		Queue = std::make_unique<FESceneGraphCommandQueue>(SceneID);
+
+	Queue->MaxCommandsAppliedPerFrame = NewValue;
+}
+
+void FESceneGraphCommandQueue::RemoveForScene(const std::string& SceneID)
+{
+	std::lock_guard<std::mutex> Lock(QueuesMutex);
+	SceneQueues.erase(SceneID);
+}
+
+void FESceneGraphCommandQueue::ApplyAll(bool bSceneChangeJournalComplete)
+{
+	// Only the UI thread adds and removes queues after creation, so pointers stay valid after lock is released.
+	std::vector<FESceneGraphCommandQueue*> Queues;
+	{
+		std::lock_guard<std::mutex> Lock(QueuesMutex);
+		for (auto Iterator = SceneQueues.begin(); Iterator != SceneQueues.end();)
+		{
+			if (SCENE_MANAGER.GetSceneByID(Iterator->first) == nullptr)
+			{
+				Iterator = SceneQueues.erase(Iterator);
+			}
+			else
+			{
+				Queues.push_back(Iterator->second.get());
+				Iterator++;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < Queues.size(); i++)
+		Queues[i]->ApplyPending(bSceneChangeJournalComplete);
+}
+
+void FESceneGraphCommandQueue::ApplyPending(bool bSceneChangeJournalComplete)
+{
+	// Lock is held only to take incoming commands, so producers are never blocked by command application.
+	// Commands queued while applying (e.g. from selection callbacks) wait for the next call.
+	std::vector<FESceneGraphUICommand> NewCommands;
+	{
+		std::lock_guard<std::mutex> Lock(QueuesMutex);
+		NewCommands.swap(IncomingCommands);
+		// Counted while lock is held, so commands are never missing from GetQueuedCommandCount.
+		PendingCommandCount += NewCommands.size();
+	}
+
+	for (size_t i = 0; i < NewCommands.size(); i++)
+		PendingCommands.push_back(std::move(NewCommands[i]));
+
+	// Without ImGui context (e.g. in benchmarks) every call is treated as a new frame.
+	const int CurrentFrame = ImGui::GetCurrentContext() == nullptr ? LastAppliedFrame + 1 : ImGui::GetFrameCount();
+	if (CurrentFrame != LastAppliedFrame)
+	{
+		LastAppliedFrame = CurrentFrame;
+		CommandsAppliedInLastFrame = 0;
+	}
+
+	// During heavy streaming, application is spread across frames to keep UI responsive.
+	size_t CommandsToApply = PendingCommands.size();
+	if (MaxCommandsAppliedPerFrame != 0)
+		CommandsToApply = std::min(CommandsToApply, MaxCommandsAppliedPerFrame - std::min(CommandsAppliedInLastFrame, MaxCommandsAppliedPerFrame));
+
+	for (size_t i = 0; i < CommandsToApply; i++)
+	{
+		FESceneGraphUICommand Command = std::move(PendingCommands.front());
+		PendingCommands.pop_front();
+		PendingCommandCount--;
+		CommandsAppliedInLastFrame++;
+		ApplyCommand(Command, bSceneChangeJournalComplete);
+	}
+}
+
+void FESceneGraphCommandQueue::ApplyCommand(const FESceneGraphUICommand& Command, bool bSceneChangeJournalComplete)
+{
+	FEScene* Scene = SCENE_MANAGER.GetSceneByID(Command.SceneID);
+	if (Scene == nullptr)
+		return;
+
+	// Command could target a node that was removed by an earlier command.
+	FENaiveSceneGraphNode* Node = Command.NodeID.empty() ? nullptr : Scene->SceneGraph.GetNodeByID(Command.NodeID);
+	FENaiveSceneGraphNode* TargetNode = Command.TargetNodeID.empty() ? Scene->SceneGraph.GetRoot() : Scene->SceneGraph.GetNodeByID(Command.TargetNodeID);
+
+	switch (Command.Type)
+	{
+		case FE_SCENE_GRAPH_UI_COMMAND_DELETE:
+		{
+			if (Node == nullptr || Node->GetEntity() == nullptr)
+				return;
+
+			// Deleting entity also deletes its subtree, so we need to clean up state of all descendants.
+			// Pairs of removed node ID and its parent ID.
+			std::vector<std::pair<std::string, std::string>> RemovedNodeIDs;
+			std::vector<FENaiveSceneGraphNode*> Stack;
+			Stack.push_back(Node);
+			while (!Stack.empty())
+			{
+				FENaiveSceneGraphNode* CurrentNode = Stack.back();
+				Stack.pop_back();
+				RemovedNodeIDs.push_back({ CurrentNode->GetObjectID(), CurrentNode->GetParent() == nullptr ? "" : CurrentNode->GetParent()->GetObjectID() });
+				for (FENaiveSceneGraphNode* Child : CurrentNode->GetChildren())
+					Stack.push_back(Child);
+			}
+
+			// Descendants are recorded before their ancestors, so the scene index can drop them one by one.
+			Scene->DeleteEntity(Node->GetEntity());
+			for (size_t i = RemovedNodeIDs.size(); i > 0; i--)
+				FESceneGraphChangeJournal::GetForScene(Scene->GetObjectID()).RecordNodeRemoved(RemovedNodeIDs[i - 1].first, RemovedNodeIDs[i - 1].second);
+
+			break;
+		}
+
+		case FE_SCENE_GRAPH_UI_COMMAND_MOVE:
+		{
+			if (Node == nullptr || TargetNode == nullptr || Node == TargetNode)
+				return;
+
+			// Node can not be moved into its own subtree.
+			FENaiveSceneGraphNode* CurrentNode = TargetNode;
+			while (CurrentNode != nullptr)
+			{
+				if (CurrentNode == Node)
+					return;
+				CurrentNode = CurrentNode->GetParent();
+			}
+
+			std::string PreviousParentID = Node->GetParent() == nullptr ? "" : Node->GetParent()->GetObjectID();
+			if (ReparentNode(Node, TargetNode))
+				FESceneGraphChangeJournal::GetForScene(Scene->GetObjectID()).RecordNodeReparented(Node, PreviousParentID);
+			break;
+		}
+
+		case FE_SCENE_GRAPH_UI_COMMAND_MOVE_BATCH:
+		{
+			if (TargetNode == nullptr)
+				return;
+
+			// Scene index gives O(1) lookups, FENaiveSceneGraph::GetNodeByID is O(n) for every node.
+			FESceneGraphIndex* CommandSceneIndex = FESceneGraphIndex::AcquireUpToDate(Command.SceneID, bSceneChangeJournalComplete);
+
+			// Target and its ancestors can not be moved into target, so cycle check is O(1) per node.
+			std::unordered_set<FENaiveSceneGraphNode*> TargetAncestors;
+			for (FENaiveSceneGraphNode* CurrentNode = TargetNode; CurrentNode != nullptr; CurrentNode = CurrentNode->GetParent())
+				TargetAncestors.insert(CurrentNode);
+
+			std::vector<FENaiveSceneGraphNode*> MovedNodes;
+			std::unordered_set<FENaiveSceneGraphNode*> MovedNodeSet;
+			MovedNodes.reserve(Command.NodeIDs.size());
+			for (size_t i = 0; i < Command.NodeIDs.size(); i++)
+			{
+				FENaiveSceneGraphNode* MovedNode = CommandSceneIndex->GetNodeByID(Command.NodeIDs[i]);
+				if (MovedNode == nullptr || TargetAncestors.find(MovedNode) != TargetAncestors.end())
+					continue;
+
+				if (MovedNodeSet.insert(MovedNode).second)
+					MovedNodes.push_back(MovedNode);
+			}
+			FESceneGraphIndex::Release(CommandSceneIndex);
+
+			FESceneGraphChangeJournal& Journal = FESceneGraphChangeJournal::GetForScene(Scene->GetObjectID());
+			for (size_t i = 0; i < MovedNodes.size(); i++)
+			{
+				FENaiveSceneGraphNode* MovedNode = MovedNodes[i];
+				if (MovedNode->GetParent() == TargetNode)
+					continue;
+
+				// Descendants of moved nodes are moved together with them, O(depth) per node.
+				bool bInsideOfMovedNode = false;
+				for (FENaiveSceneGraphNode* CurrentNode = MovedNode->GetParent(); CurrentNode != nullptr; CurrentNode = CurrentNode->GetParent())
+				{
+					if (MovedNodeSet.find(CurrentNode) != MovedNodeSet.end())
+					{
+						bInsideOfMovedNode = true;
+						break;
+					}
+				}
+
+				if (bInsideOfMovedNode)
+					continue;
+
+				std::string PreviousParentID = MovedNode->GetParent() == nullptr ? "" : MovedNode->GetParent()->GetObjectID();
+				if (ReparentNode(MovedNode, TargetNode))
+					Journal.RecordNodeReparented(MovedNode, PreviousParentID);
+			}
+
+			break;
+		}
+
+		case FE_SCENE_GRAPH_UI_COMMAND_RENAME_BATCH:
+		{
+			FESceneGraphIndex* CommandSceneIndex = FESceneGraphIndex::AcquireUpToDate(Command.SceneID, bSceneChangeJournalComplete);
+
+			// Panels, index and filter memos see the renames on their next journal sync, so they are processed as one batch.
+			FESceneGraphChangeJournal& Journal = FESceneGraphChangeJournal::GetForScene(Scene->GetObjectID());
+			const size_t RenameCount = std::min(Command.NodeIDs.size(), Command.Names.size());
+			for (size_t i = 0; i < RenameCount; i++)
+			{
+				FENaiveSceneGraphNode* RenamedNode = CommandSceneIndex->GetNodeByID(Command.NodeIDs[i]);
+				if (RenamedNode == nullptr || RenamedNode->GetEntity() == nullptr)
+					continue;
+
+				RenamedNode->GetEntity()->SetName(Command.Names[i]);
+				Journal.RecordNodeRenamed(RenamedNode);
+			}
+
+			FESceneGraphIndex::Release(CommandSceneIndex);
+			break;
+		}
+
+		case FE_SCENE_GRAPH_UI_COMMAND_RENAME:
+		{
+			if (Node == nullptr || Node->GetEntity() == nullptr)
+				return;
+
+			Node->GetEntity()->SetName(Command.Name);
+			FESceneGraphChangeJournal::GetForScene(Scene->GetObjectID()).RecordNodeRenamed(Node);
+			break;
+		}
+
+		case FE_SCENE_GRAPH_UI_COMMAND_CREATE:
+		{
+			if (TargetNode == nullptr)
+				return;
+
+			FEEntity* NewEntity = Scene->CreateEntity(Command.Name);
+			if (NewEntity == nullptr)
+				return;
+
+			FENaiveSceneGraphNode* NewNode = Scene->SceneGraph.GetNodeByEntityID(NewEntity->GetObjectID());
+			if (NewNode != nullptr && TargetNode != Scene->SceneGraph.GetRoot())
+				Scene->SceneGraph.MoveNode(NewNode->GetObjectID(), TargetNode->GetObjectID());
+
+			FESceneGraphChangeJournal::GetForScene(Scene->GetObjectID()).RecordNodeAdded(NewNode);
+
+			if (Command.OnEntityCreated != nullptr)
+				Command.OnEntityCreated(NewEntity);
+
+			break;
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "FEngine.h"
+#include "FESceneGraphChangeJournal.h"
+#include "FESceneGraphIndex.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+enum FE_SCENE_GRAPH_UI_COMMAND_TYPE
+{
+	FE_SCENE_GRAPH_UI_COMMAND_DELETE = 0,
+	FE_SCENE_GRAPH_UI_COMMAND_MOVE = 1,
+	FE_SCENE_GRAPH_UI_COMMAND_RENAME = 2,
+	FE_SCENE_GRAPH_UI_COMMAND_CREATE = 3,
+	// Moves all NodeIDs under one parent, it counts as one command for per-frame limit.
+	FE_SCENE_GRAPH_UI_COMMAND_MOVE_BATCH = 4,
+	// Gives Names[i] to NodeIDs[i], journal changes of the whole batch are consumed in one pass.
+	FE_SCENE_GRAPH_UI_COMMAND_RENAME_BATCH = 5
+};
+
+// Scene graph modification that is requested during UI traversal (widget, click or context menu callbacks)
+// or by other threads (e.g. background loaders), but applied only on the thread that renders UI.
+struct FESceneGraphUICommand
+{
+	FE_SCENE_GRAPH_UI_COMMAND_TYPE Type = FE_SCENE_GRAPH_UI_COMMAND_DELETE;
+	std::string SceneID = "";
+	std::string NodeID = "";
+	// Only for batched move and rename.
+	std::vector<std::string> NodeIDs;
+	std::vector<std::string> Names;
+	// New parent for move and create commands, empty means scene root.
+	std::string TargetNodeID = "";
+	std::string Name = "";
+	// Called on the thread that applies commands, for create command it can be used to set up newly created entity.
+	std::function<void(FEEntity*)> OnEntityCreated = nullptr;
+};
+
+// Per-scene command intake, it does not belong to any panel, so commands are applied even when no panel shows the scene.
+// Push is thread-safe, commands are applied on the thread that renders UI by ApplyAll,
+// every panel calls it in Render, host that has no visible panels should call it once per frame.
+// Applied commands are recorded in the change journal, panels and scene index pick them up from there.
+class FESceneGraphCommandQueue
+{
+	std::string SceneID = "";
+	// Guarded by QueuesMutex.
+	std::vector<FESceneGraphUICommand> IncomingCommands;
+	// Touched only by the UI thread, other threads read its size through PendingCommandCount.
+	std::deque<FESceneGraphUICommand> PendingCommands;
+	std::atomic<size_t> PendingCommandCount = 0;
+	static constexpr size_t DefaultMaxCommandsAppliedPerFrame = 10000;
+	size_t MaxCommandsAppliedPerFrame = DefaultMaxCommandsAppliedPerFrame;
+	// Queue could be drained several times per frame (e.g. by several panels), limit is shared by all of them.
+	int LastAppliedFrame = -1;
+	size_t CommandsAppliedInLastFrame = 0;
+
+	static std::mutex QueuesMutex;
+	static std::unordered_map<std::string, std::unique_ptr<FESceneGraphCommandQueue>> SceneQueues;
+
+	void ApplyPending(bool bSceneChangeJournalComplete);
+	static void ApplyCommand(const FESceneGraphUICommand& Command, bool bSceneChangeJournalComplete);
+	// Same as FENaiveSceneGraph::MoveNode, but without O(n) lookups of both nodes by ID.
+	// Caller should make sure that NewParent is not inside of Node subtree.
+	static bool ReparentNode(FENaiveSceneGraphNode* Node, FENaiveSceneGraphNode* NewParent);
+public:
+	FESceneGraphCommandQueue(const std::string& SceneID);
+	FESceneGraphCommandQueue(const FESceneGraphCommandQueue&) = delete;
+	FESceneGraphCommandQueue& operator=(const FESceneGraphCommandQueue&) = delete;
+
+	// Thread-safe, command should reference nodes and scene by IDs.
+	static void Push(const FESceneGraphUICommand& Command);
+	// Thread-safe, queued and not yet applied commands of the scene.
+	static size_t GetQueuedCommandCount(const std::string& SceneID);
+	// Should be called on the thread that renders UI, while no panel traverses the scene graph.
+	// Queues of removed scenes are dropped together with their commands.
+	static void ApplyAll(bool bSceneChangeJournalComplete = false);
+	static void RemoveForScene(const std::string& SceneID);
+
+	// 0 means that all queued commands will be applied in one frame.
+	static size_t GetMaxCommandsAppliedPerFrame(const std::string& SceneID);
+	static void SetMaxCommandsAppliedPerFrame(const std::string& SceneID, size_t NewValue);
+};
@@ -0,0 +1,284 @@
+#include "FESceneGraphIconAtlas.h"
+
+FESceneGraphIconAtlas::FESceneGraphIconAtlas()
+{
+	Pixels.resize(static_cast<size_t>(AtlasSize) * AtlasSize * 4, 0);
+}
+
+FESceneGraphIconAtlas::~FESceneGraphIconAtlas()
+{
+	if (AtlasTexture != nullptr)
+		RESOURCE_MANAGER.DeleteFETexture(AtlasTexture);
+}
+
+int FESceneGraphIconAtlas::GetAtlasSize() const
+{
+	return AtlasSize;
+}
+
+void FESceneGraphIconAtlas::SetAtlasSize(int NewValue)
+{
+	if (NewValue <= 0 || NewValue == AtlasSize)
+		return;
+
+	AtlasSize = NewValue;
+	Clear();
+}
+
+int FESceneGraphIconAtlas::GetMaxIconSize() const
+{
+	return MaxIconSize;
+}
+
+void FESceneGraphIconAtlas::SetMaxIconSize(int NewValue)
+{
+	if (NewValue <= 0)
+		return;
+
+	MaxIconSize = NewValue;
+}
+
+double FESceneGraphIconAtlas::GetMinUpdateInterval() const
+{
+	return MinUpdateInterval;
+}
+
+void FESceneGraphIconAtlas::SetMinUpdateInterval(double NewValue)
+{
+	MinUpdateInterval = std::max(NewValue, 0.0);
+}
+
+bool FESceneGraphIconAtlas::FindFreeRect(int Width, int Height, int& OutX, int& OutY)
+{
+	int PaddedWidth = Width + Padding * 2;
+	int PaddedHeight = Height + Padding * 2;
+	if (PaddedWidth > AtlasSize || PaddedHeight > AtlasSize)
+		return false;
+
+	// Icon does not fit in the current shelf, so a new shelf is started below it.
+	if (ShelfX + PaddedWidth > AtlasSize)
+	{
+		ShelfY += ShelfHeight;
+		ShelfX = 0;
+		ShelfHeight = 0;
+	}
+
+	if (ShelfY + PaddedHeight > AtlasSize)
+		return false;
+
+	OutX = ShelfX + Padding;
+	OutY = ShelfY + Padding;
+	ShelfX += PaddedWidth;
+	ShelfHeight = std::max(ShelfHeight, PaddedHeight);
+
+	return true;
+}
+
+void FESceneGraphIconAtlas::GetPackedSize(int SourceWidth, int SourceHeight, int& OutWidth, int& OutHeight) const
+{
+	float Scale = std::min(1.0f, static_cast<float>(MaxIconSize) / std::max(SourceWidth, SourceHeight));
+	OutWidth = std::max(1, static_cast<int>(SourceWidth * Scale));
+	OutHeight = std::max(1, static_cast<int>(SourceHeight * Scale));
+}
+
+bool FESceneGraphIconAtlas::CopyIconPixels(FETexture* Icon, const FESceneGraphIconAtlasEntry& Entry)
+{
+	int SourceWidth = Entry.SourceWidth;
+	int SourceHeight = Entry.SourceHeight;
+	size_t RawDataSize = 0;
+	unsigned char* RawData = SourceWidth > 0 && SourceHeight > 0 ? Icon->GetRawData(&RawDataSize) : nullptr;
+	if (RawData == nullptr || RawDataSize < static_cast<size_t>(SourceWidth) * SourceHeight * 4)
+	{
+		delete[] RawData;
+		return false;
+	}
+
+	// Box filter, each atlas pixel is the average of source pixels it covers.
+	const int Width = Entry.Width;
+	const int Height = Entry.Height;
+	for (int y = 0; y < Height; y++)
+	{
+		int SourceMinY = y * SourceHeight / Height;
+		int SourceMaxY = std::max(SourceMinY + 1, (y + 1) * SourceHeight / Height);
+		for (int x = 0; x < Width; x++)
+		{
+			int SourceMinX = x * SourceWidth / Width;
+			int SourceMaxX = std::max(SourceMinX + 1, (x + 1) * SourceWidth / Width);
+
+			unsigned int Sum[4] = { 0, 0, 0, 0 };
+			for (int SourceY = SourceMinY; SourceY < SourceMaxY; SourceY++)
+			{
+				for (int SourceX = SourceMinX; SourceX < SourceMaxX; SourceX++)
+				{
+					const unsigned char* SourcePixel = RawData + (static_cast<size_t>(SourceY) * SourceWidth + SourceX) * 4;
+					for (int Channel = 0; Channel < 4; Channel++)
+						Sum[Channel] += SourcePixel[Channel];
+				}
+			}
+
+			unsigned int SampleCount = static_cast<unsigned int>((SourceMaxY - SourceMinY) * (SourceMaxX - SourceMinX));
+			unsigned char* AtlasPixel = Pixels.data() + (static_cast<size_t>(Entry.Y + y) * AtlasSize + Entry.X + x) * 4;
+			for (int Channel = 0; Channel < 4; Channel++)
+				AtlasPixel[Channel] = static_cast<unsigned char>(Sum[Channel] / SampleCount);
+		}
+	}
+	delete[] RawData;
+
+	return true;
+}
+
+bool FESceneGraphIconAtlas::AddIcon(FETexture* Icon)
+{
+	if (Icon == nullptr)
+		return false;
+
+	std::string IconID = Icon->GetObjectID();
+	if (Entries.find(IconID) != Entries.end())
+		return true;
+
+	if (RejectedIconIDs.find(IconID) != RejectedIconIDs.end())
+		return false;
+
+	FESceneGraphIconAtlasEntry NewEntry;
+	NewEntry.SourceWidth = Icon->GetWidth();
+	NewEntry.SourceHeight = Icon->GetHeight();
+	if (NewEntry.SourceWidth <= 0 || NewEntry.SourceHeight <= 0)
+	{
+		RejectedIconIDs.insert(IconID);
+		return false;
+	}
+
+	GetPackedSize(NewEntry.SourceWidth, NewEntry.SourceHeight, NewEntry.Width, NewEntry.Height);
+	// Rect is taken only after pixels are known to be available.
+	int ShelfXBefore = ShelfX;
+	int ShelfYBefore = ShelfY;
+	int ShelfHeightBefore = ShelfHeight;
+	if (!FindFreeRect(NewEntry.Width, NewEntry.Height, NewEntry.X, NewEntry.Y))
+	{
+		RejectedIconIDs.insert(IconID);
+		return false;
+	}
+
+	if (!CopyIconPixels(Icon, NewEntry))
+	{
+		ShelfX = ShelfXBefore;
+		ShelfY = ShelfYBefore;
+		ShelfHeight = ShelfHeightBefore;
+		RejectedIconIDs.insert(IconID);
+		return false;
+	}
+
+	NewEntry.UV0 = ImVec2(static_cast<float>(NewEntry.X) / AtlasSize, static_cast<float>(NewEntry.Y) / AtlasSize);
+	NewEntry.UV1 = ImVec2(static_cast<float>(NewEntry.X + NewEntry.Width) / AtlasSize, static_cast<float>(NewEntry.Y + NewEntry.Height) / AtlasSize);
+	Entries[IconID] = NewEntry;
+	bTextureDirty = true;
+
+	return true;
+}
+
+void FESceneGraphIconAtlas::RefreshIcon(FETexture* Icon)
+{
+	if (Icon == nullptr)
+		return;
+
+	std::string IconID = Icon->GetObjectID();
+	RejectedIconIDs.erase(IconID);
+
+	auto Iterator = Entries.find(IconID);
+	if (Iterator == Entries.end())
+		return;
+
+	FESceneGraphIconAtlasEntry& Entry = Iterator->second;
+	int NewWidth = 0;
+	int NewHeight = 0;
+	if (Icon->GetWidth() > 0 && Icon->GetHeight() > 0)
+		GetPackedSize(Icon->GetWidth(), Icon->GetHeight(), NewWidth, NewHeight);
+
+	// Shelf packer can not reuse the old rect for a different size, its space is reclaimed only by Clear.
+	if (NewWidth != Entry.Width || NewHeight != Entry.Height)
+	{
+		Entries.erase(Iterator);
+		return;
+	}
+
+	Entry.SourceWidth = Icon->GetWidth();
+	Entry.SourceHeight = Icon->GetHeight();
+	if (!CopyIconPixels(Icon, Entry))
+	{
+		Entries.erase(Iterator);
+		RejectedIconIDs.insert(IconID);
+		return;
+	}
+
+	// Until the next upload the icon is rendered with its own texture, old pixels are still in the atlas texture.
+	Entry.bUploaded = false;
+	bTextureDirty = true;
+}
+
+bool FESceneGraphIconAtlas::IsIconRejected(FETexture* Icon) const
+{
+	if (Icon == nullptr)
+		return true;
+
+	return RejectedIconIDs.find(Icon->GetObjectID()) != RejectedIconIDs.end();
+}
+
+const FESceneGraphIconAtlasEntry* FESceneGraphIconAtlas::GetEntry(FETexture* Icon) const
+{
+	if (Icon == nullptr)
+		return nullptr;
+
+	auto Iterator = Entries.find(Icon->GetObjectID());
+	if (Iterator == Entries.end())
+		return nullptr;
+
+	return &Iterator->second;
+}
+
+size_t FESceneGraphIconAtlas::GetIconCount() const
+{
+	return Entries.size();
+}
+
+float FESceneGraphIconAtlas::GetOccupancy() const
+{
+	return static_cast<float>(ShelfY + ShelfHeight) / AtlasSize;
+}
+
+void FESceneGraphIconAtlas::UpdateTexture(bool bForce)
+{
+	if (!bTextureDirty)
+		return;
+
+	// Whole texture is uploaded, so icons that keep appearing are collected for a while instead of uploading on every frame.
+	std::chrono::steady_clock::time_point CurrentTime = std::chrono::steady_clock::now();
+	if (!bForce && AtlasTexture != nullptr && std::chrono::duration<double>(CurrentTime - LastUpdateTime).count() < MinUpdateInterval)
+		return;
+
+	if (AtlasTexture != nullptr)
+		RESOURCE_MANAGER.DeleteFETexture(AtlasTexture);
+
+	AtlasTexture = RESOURCE_MANAGER.RawDataToFETexture(Pixels.data(), AtlasSize, AtlasSize);
+	for (auto& EntryPair : Entries)
+		EntryPair.second.bUploaded = true;
+
+	bTextureDirty = false;
+	LastUpdateTime = CurrentTime;
+}
+
+FETexture* FESceneGraphIconAtlas::GetTexture() const
+{
+	return AtlasTexture;
+}
+
+void FESceneGraphIconAtlas::Clear()
+{
+	Pixels.assign(static_cast<size_t>(AtlasSize) * AtlasSize * 4, 0);
+	Entries.clear();
+	RejectedIconIDs.clear();
+	ShelfX = 0;
+	ShelfY = 0;
+	ShelfHeight = 0;
+	// Old texture is kept until the next update, because current frame could still use it.
+	bTextureDirty = true;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+#include "FEngine.h"
+#include <chrono>
+
+// Place of one icon in the atlas.
+struct FESceneGraphIconAtlasEntry
+{
+	int X = 0;
+	int Y = 0;
+	int Width = 0;
+	int Height = 0;
+	ImVec2 UV0 = ImVec2(0.0f, 0.0f);
+	ImVec2 UV1 = ImVec2(1.0f, 1.0f);
+	// Size of the texture when its pixels were copied, so resized textures could be detected.
+	int SourceWidth = 0;
+	int SourceHeight = 0;
+	// Pixels are already in the GPU texture.
+	bool bUploaded = false;
+};
+
+// Packs icon textures into one shared texture, so rows with different icons do not break ImGui draw command batches.
+// Packing is done on CPU with shelf packer, GPU texture is recreated only when new icons were added,
+// and not more often than MinUpdateInterval, so icons that appear one by one are uploaded in batches.
+// Pixels are copied when icon is added, textures that change their content should be refreshed with RefreshIcon.
+class FESceneGraphIconAtlas
+{
+	int AtlasSize = 1024;
+	// Larger icons are downscaled, rows render them much smaller anyway.
+	int MaxIconSize = 64;
+	int Padding = 1;
+
+	std::vector<unsigned char> Pixels;
+	std::unordered_map<std::string, FESceneGraphIconAtlasEntry> Entries;
+	// Icons that could not be added (no CPU data or no space left), they are rendered with their own texture.
+	std::unordered_set<std::string> RejectedIconIDs;
+
+	int ShelfX = 0;
+	int ShelfY = 0;
+	int ShelfHeight = 0;
+	bool FindFreeRect(int Width, int Height, int& OutX, int& OutY);
+	void GetPackedSize(int SourceWidth, int SourceHeight, int& OutWidth, int& OutHeight) const;
+	// Downscales icon into its rect, returns false if icon has no CPU data.
+	bool CopyIconPixels(FETexture* Icon, const FESceneGraphIconAtlasEntry& Entry);
+
+	FETexture* AtlasTexture = nullptr;
+	bool bTextureDirty = false;
+	double MinUpdateInterval = 0.5;
+	std::chrono::steady_clock::time_point LastUpdateTime;
+public:
+	FESceneGraphIconAtlas();
+	~FESceneGraphIconAtlas();
+
+	int GetAtlasSize() const;
+	// Clears the atlas, size should be a power of two.
+	void SetAtlasSize(int NewValue);
+	int GetMaxIconSize() const;
+	// Applies only to icons that are added after this call.
+	void SetMaxIconSize(int NewValue);
+
+	double GetMinUpdateInterval() const;
+	// In seconds, 0 means texture is recreated in every update that has new icons.
+	void SetMinUpdateInterval(double NewValue);
+
+	// Returns false if icon can not be packed, in that case it should be rendered with its own texture.
+	bool AddIcon(FETexture* Icon);
+	// Copies pixels of already packed icon again, e.g. after its texture was rendered to.
+	// If icon has different size now, it is packed again on the next AddIcon.
+	void RefreshIcon(FETexture* Icon);
+	bool IsIconRejected(FETexture* Icon) const;
+	const FESceneGraphIconAtlasEntry* GetEntry(FETexture* Icon) const;
+	size_t GetIconCount() const;
+	// Fraction of atlas height that is already used by shelves.
+	float GetOccupancy() const;
+
+	// Recreates GPU texture if icons were added since the last update and MinUpdateInterval has passed.
+	// Should not be called while ImGui frame that uses the old texture is being built.
+	void UpdateTexture(bool bForce = false);
+	// nullptr until the first icon is added and texture is updated.
+	// Only entries with bUploaded are in this texture.
+	FETexture* GetTexture() const;
+
+	void Clear();
+};
\ No newline at end of file
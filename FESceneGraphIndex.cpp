@@ -0,0 +1,396 @@
+#include "FESceneGraphIndex.h"
+
+std::unordered_map<std::string, FESceneGraphIndex*>& FESceneGraphIndex::GetIndices()
+{
+	static std::unordered_map<std::string, FESceneGraphIndex*> Indices;
+	return Indices;
+}
+
+FESceneGraphIndex::FESceneGraphIndex(const std::string& SceneID)
+{
+	this->SceneID = SceneID;
+}
+
+FESceneGraphIndex* FESceneGraphIndex::Acquire(const std::string& SceneID)
+{
+	if (SceneID.empty())
+		return nullptr;
+
+	FESceneGraphIndex*& Index = GetIndices()[SceneID];
+	if (Index == nullptr)
+	{
+		FESceneGraphChangeJournal::Acquire(SceneID);
+		Index = new FESceneGraphIndex(SceneID);
+	}
+
+	Index->ReferenceCount++;
+	return Index;
+}
+
+FESceneGraphIndex* FESceneGraphIndex::AcquireUpToDate(const std::string& SceneID, bool bSceneChangeJournalComplete)
+{
+	FESceneGraphIndex* Index = Acquire(SceneID);
+	if (Index == nullptr)
+		return nullptr;
+
+	if (!bSceneChangeJournalComplete)
+		Index->Invalidate();
+
+	Index->Update();
+	return Index;
+}
+
+void FESceneGraphIndex::Release(FESceneGraphIndex* Index)
+{
+	if (Index == nullptr)
+		return;
+
+	if (--Index->ReferenceCount > 0)
+		return;
+
+	GetIndices().erase(Index->SceneID);
+	FESceneGraphChangeJournal::Release(Index->SceneID);
+	delete Index;
+}
+
+std::string FESceneGraphIndex::GetSceneID() const
+{
+	return SceneID;
+}
+
+size_t FESceneGraphIndex::GetReferenceCount() const
+{
+	return ReferenceCount;
+}
+
+void FESceneGraphIndex::Update()
+{
+	FESceneGraphChangeJournal& Journal = FESceneGraphChangeJournal::GetForScene(SceneID);
+	if (!bNeedsRebuild && LastSeenJournalSequence == Journal.GetLastSequence())
+		return;
+
+	if (!bNeedsRebuild)
+	{
+		std::vector<FESceneGraphChangeRecord> Changes;
+		if (Journal.GetChangesSince(LastSeenJournalSequence, Changes))
+		{
+			for (size_t i = 0; i < Changes.size() && !bNeedsRebuild; i++)
+				ApplyChange(Changes[i]);
+		}
+		else
+		{
+			bNeedsRebuild = true;
+		}
+	}
+
+	LastSeenJournalSequence = Journal.GetLastSequence();
+
+	// Removed entries and old names are not reclaimed by incremental updates.
+	if (RemovedEntryCount > Entries.size() / 2 || UnusedNameArenaSize > NameArena.size() / 2)
+		bNeedsRebuild = true;
+
+	if (bNeedsRebuild)
+		Rebuild();
+}
+
+void FESceneGraphIndex::Invalidate()
+{
+	bNeedsRebuild = true;
+}
+
+void FESceneGraphIndex::Rebuild()
+{
+	Entries.clear();
+	EntryIndices.clear();
+	RemovedEntryCount = 0;
+	NameArena.clear();
+	LowercaseNameArena.clear();
+	UnusedNameArenaSize = 0;
+	Tags.clear();
+	TagIDs.clear();
+	FilterResults.clear();
+	bNeedsRebuild = false;
+	LastSeenJournalSequence = FESceneGraphChangeJournal::GetForScene(SceneID).GetLastSequence();
+	Version++;
+
+	FEScene* Scene = SCENE_MANAGER.GetSceneByID(SceneID);
+	if (Scene == nullptr || Scene->SceneGraph.GetRoot() == nullptr)
+		return;
+
+	// Entries are added in pre-order, so parent entry always exists before its children.
+	std::vector<std::pair<FENaiveSceneGraphNode*, int>> Stack;
+	Stack.push_back({ Scene->SceneGraph.GetRoot(), -1 });
+	while (!Stack.empty())
+	{
+		FENaiveSceneGraphNode* Node = Stack.back().first;
+		int ParentIndex = Stack.back().second;
+		Stack.pop_back();
+
+		int EntryIndex = static_cast<int>(AddEntry(Node, ParentIndex));
+		std::vector<FENaiveSceneGraphNode*> Children = Node->GetChildren();
+		for (size_t i = Children.size(); i > 0; i--)
+			Stack.push_back({ Children[i - 1], EntryIndex });
+	}
+
+	// Subtree sizes are accumulated from the end, children always have larger index than their parent.
+	for (size_t i = Entries.size(); i > 0; i--)
+	{
+		if (Entries[i - 1].ParentIndex != -1)
+			Entries[Entries[i - 1].ParentIndex].SubtreeNodeCount += Entries[i - 1].SubtreeNodeCount;
+	}
+}
+
+size_t FESceneGraphIndex::AddEntry(FENaiveSceneGraphNode* Node, int ParentIndex)
+{
+	FESceneGraphIndexEntry NewEntry;
+	NewEntry.Node = Node;
+	NewEntry.NodeID = Node->GetObjectID();
+	NewEntry.ParentIndex = ParentIndex;
+	NewEntry.Depth = ParentIndex == -1 ? 0 : Entries[ParentIndex].Depth + 1;
+	FEEntity* Entity = Node->GetEntity();
+	NewEntry.TagID = GetOrAddTagID(Entity == nullptr ? "" : Entity->GetTag());
+	SetEntryName(NewEntry);
+
+	EntryIndices[NewEntry.NodeID] = Entries.size();
+	Entries.push_back(std::move(NewEntry));
+	return Entries.size() - 1;
+}
+
+void FESceneGraphIndex::SetEntryName(FESceneGraphIndexEntry& Entry)
+{
+	FEEntity* Entity = Entry.Node->GetEntity();
+	std::string Name = Entity == nullptr ? Entry.Node->GetName() : Entity->GetName();
+
+	UnusedNameArenaSize += Entry.NameLength;
+	Entry.NameOffset = NameArena.size();
+	Entry.NameLength = Name.size();
+	NameArena += Name;
+	std::transform(Name.begin(), Name.end(), Name.begin(), ::tolower);
+	LowercaseNameArena += Name;
+}
+
+uint32_t FESceneGraphIndex::GetOrAddTagID(const std::string& Tag)
+{
+	auto Iterator = TagIDs.find(Tag);
+	if (Iterator != TagIDs.end())
+		return Iterator->second;
+
+	uint32_t NewTagID = static_cast<uint32_t>(Tags.size());
+	Tags.push_back(Tag);
+	TagIDs[Tag] = NewTagID;
+	return NewTagID;
+}
+
+void FESceneGraphIndex::AddToAncestorSubtreeCounts(int AncestorIndex, int64_t Delta)
+{
+	// Removed ancestor has already excluded its whole subtree.
+	while (AncestorIndex != -1 && Entries[AncestorIndex].Node != nullptr)
+	{
+		Entries[AncestorIndex].SubtreeNodeCount = static_cast<size_t>(static_cast<int64_t>(Entries[AncestorIndex].SubtreeNodeCount) + Delta);
+		AncestorIndex = Entries[AncestorIndex].ParentIndex;
+	}
+}
+
+void FESceneGraphIndex::UpdateSubtreeDepth(size_t EntryIndex)
+{
+	std::vector<size_t> Stack;
+	Stack.push_back(EntryIndex);
+	while (!Stack.empty())
+	{
+		FESceneGraphIndexEntry& Entry = Entries[Stack.back()];
+		Stack.pop_back();
+		Entry.Depth = Entry.ParentIndex == -1 ? 0 : Entries[Entry.ParentIndex].Depth + 1;
+
+		for (FENaiveSceneGraphNode* Child : Entry.Node->GetChildren())
+		{
+			auto Iterator = EntryIndices.find(Child->GetObjectID());
+			if (Iterator == EntryIndices.end())
+			{
+				bNeedsRebuild = true;
+				return;
+			}
+
+			Stack.push_back(Iterator->second);
+		}
+	}
+}
+
+void FESceneGraphIndex::ApplyChange(const FESceneGraphChangeRecord& Change)
+{
+	Version++;
+	auto Iterator = EntryIndices.find(Change.NodeID);
+	switch (Change.Type)
+	{
+		case FE_SCENE_GRAPH_CHANGE_NODE_ADDED:
+		{
+			auto ParentIterator = EntryIndices.find(Change.ParentID);
+			if (Iterator != EntryIndices.end() || ParentIterator == EntryIndices.end())
+			{
+				bNeedsRebuild = true;
+				return;
+			}
+
+			// New node is found among children of its parent, not in the whole scene graph.
+			FENaiveSceneGraphNode* NewNode = nullptr;
+			for (FENaiveSceneGraphNode* Child : Entries[ParentIterator->second].Node->GetChildren())
+			{
+				if (Child->GetObjectID() == Change.NodeID)
+				{
+					NewNode = Child;
+					break;
+				}
+			}
+
+			if (NewNode == nullptr || !NewNode->GetChildren().empty())
+			{
+				bNeedsRebuild = true;
+				return;
+			}
+
+			int ParentIndex = static_cast<int>(ParentIterator->second);
+			AddEntry(NewNode, ParentIndex);
+			AddToAncestorSubtreeCounts(ParentIndex, 1);
+			break;
+		}
+
+		case FE_SCENE_GRAPH_CHANGE_NODE_REMOVED:
+		{
+			if (Iterator == EntryIndices.end())
+				return;
+
+			// Descendants would keep pointers to deleted nodes, so only removal of a leaf is applied in place.
+			// Descendants recorded as removed before their ancestor leave it a leaf.
+			FESceneGraphIndexEntry& Entry = Entries[Iterator->second];
+			if (Entry.SubtreeNodeCount > 1)
+			{
+				bNeedsRebuild = true;
+				return;
+			}
+
+			AddToAncestorSubtreeCounts(Entry.ParentIndex, -static_cast<int64_t>(Entry.SubtreeNodeCount));
+			Entry.Node = nullptr;
+			UnusedNameArenaSize += Entry.NameLength;
+			RemovedEntryCount++;
+			EntryIndices.erase(Iterator);
+			break;
+		}
+
+		case FE_SCENE_GRAPH_CHANGE_NODE_REPARENTED:
+		{
+			auto ParentIterator = EntryIndices.find(Change.ParentID);
+			if (Iterator == EntryIndices.end() || ParentIterator == EntryIndices.end())
+			{
+				bNeedsRebuild = true;
+				return;
+			}
+
+			FESceneGraphIndexEntry& Entry = Entries[Iterator->second];
+			int64_t SubtreeNodeCount = static_cast<int64_t>(Entry.SubtreeNodeCount);
+			AddToAncestorSubtreeCounts(Entry.ParentIndex, -SubtreeNodeCount);
+			Entry.ParentIndex = static_cast<int>(ParentIterator->second);
+			AddToAncestorSubtreeCounts(Entry.ParentIndex, SubtreeNodeCount);
+			UpdateSubtreeDepth(Iterator->second);
+			break;
+		}
+
+		case FE_SCENE_GRAPH_CHANGE_NODE_RENAMED:
+		{
+			if (Iterator == EntryIndices.end())
+			{
+				bNeedsRebuild = true;
+				return;
+			}
+
+			SetEntryName(Entries[Iterator->second]);
+			break;
+		}
+	}
+}
+
+uint64_t FESceneGraphIndex::GetVersion() const
+{
+	return Version;
+}
+
+uint64_t FESceneGraphIndex::GetJournalSequence() const
+{
+	return LastSeenJournalSequence;
+}
+
+size_t FESceneGraphIndex::GetNodeCount() const
+{
+	return Entries.size() - RemovedEntryCount;
+}
+
+const FESceneGraphIndexEntry* FESceneGraphIndex::GetEntry(const std::string& NodeID) const
+{
+	auto Iterator = EntryIndices.find(NodeID);
+	if (Iterator == EntryIndices.end())
+		return nullptr;
+
+	return &Entries[Iterator->second];
+}
+
+FENaiveSceneGraphNode* FESceneGraphIndex::GetNodeByID(const std::string& NodeID) const
+{
+	const FESceneGraphIndexEntry* Entry = GetEntry(NodeID);
+	return Entry == nullptr ? nullptr : Entry->Node;
+}
+
+std::string_view FESceneGraphIndex::GetNodeName(const FESceneGraphIndexEntry& Entry) const
+{
+	return std::string_view(NameArena).substr(Entry.NameOffset, Entry.NameLength);
+}
+
+std::string FESceneGraphIndex::GetTag(uint32_t TagID) const
+{
+	if (TagID >= Tags.size())
+		return "";
+
+	return Tags[TagID];
+}
+
+bool FESceneGraphIndex::TryGetTextFilterResult(const std::string& NodeID, const std::string& FilterText, bool bCaseSensitive, bool& bOutPasses)
+{
+	auto Iterator = EntryIndices.find(NodeID);
+	if (Iterator == EntryIndices.end())
+		return false;
+
+	std::string UsedFilterText = FilterText;
+	if (!bCaseSensitive)
+		std::transform(UsedFilterText.begin(), UsedFilterText.end(), UsedFilterText.begin(), ::tolower);
+
+	// Case sensitive and insensitive results are stored separately.
+	std::string ResultKey = (bCaseSensitive ? "1" : "0") + UsedFilterText;
+	auto ResultIterator = FilterResults.find(ResultKey);
+	if (ResultIterator == FilterResults.end() || ResultIterator->second.IndexVersion != Version)
+	{
+		// Each panel could use its own filter, old results are dropped instead of growing without limit.
+		if (ResultIterator == FilterResults.end() && FilterResults.size() >= 8)
+			FilterResults.clear();
+
+		FESceneGraphIndexFilterResult& Result = FilterResults[ResultKey];
+		Result.IndexVersion = Version;
+		Result.bPasses.assign(Entries.size(), false);
+
+		std::string_view Names = bCaseSensitive ? std::string_view(NameArena) : std::string_view(LowercaseNameArena);
+		for (size_t i = 0; i < Entries.size(); i++)
+		{
+			if (Entries[i].Node == nullptr || Names.substr(Entries[i].NameOffset, Entries[i].NameLength).find(UsedFilterText) == std::string_view::npos)
+				continue;
+
+			// Ancestors are marked until the first one that is already marked, so each entry is marked once.
+			int CurrentIndex = static_cast<int>(i);
+			while (CurrentIndex != -1 && !Result.bPasses[CurrentIndex])
+			{
+				Result.bPasses[CurrentIndex] = true;
+				CurrentIndex = Entries[CurrentIndex].ParentIndex;
+			}
+		}
+
+		ResultIterator = FilterResults.find(ResultKey);
+	}
+
+	bOutPasses = ResultIterator->second.bPasses[Iterator->second];
+	return true;
+}
\ No newline at end of file
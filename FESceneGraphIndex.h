@@ -0,0 +1,90 @@
+#pragma once
+#include "FESceneGraphChangeJournal.h"
+#include <string_view>
+
+struct FESceneGraphIndexEntry
+{
+	// nullptr for removed nodes, their slots are reused only after rebuild.
+	FENaiveSceneGraphNode* Node = nullptr;
+	std::string NodeID = "";
+	int ParentIndex = -1;
+	size_t Depth = 0;
+	// Including node itself.
+	size_t SubtreeNodeCount = 1;
+	size_t NameOffset = 0;
+	size_t NameLength = 0;
+	uint32_t TagID = 0;
+};
+
+// Visible nodes for one filter text, shared by all panels that use the same filter.
+struct FESceneGraphIndexFilterResult
+{
+	uint64_t IndexVersion = 0;
+	std::vector<bool> bPasses;
+};
+
+// Scene derived data that does not depend on panel view state: names, tags, depth and subtree sizes.
+// One index exists per scene and is shared by all panels that show it, it follows scene changes through the change journal.
+// Like row caches of panels, it relies on all scene graph changes being recorded in the journal.
+class FESceneGraphIndex
+{
+	std::string SceneID = "";
+	size_t ReferenceCount = 0;
+	uint64_t LastSeenJournalSequence = 0;
+	// Incremented on every change, so derived data can detect that it is outdated.
+	uint64_t Version = 0;
+	bool bNeedsRebuild = true;
+
+	std::vector<FESceneGraphIndexEntry> Entries;
+	std::unordered_map<std::string, size_t> EntryIndices;
+	size_t RemovedEntryCount = 0;
+	// Names of all nodes are stored in one buffer, lowercase copy has the same offsets.
+	std::string NameArena = "";
+	std::string LowercaseNameArena = "";
+	size_t UnusedNameArenaSize = 0;
+	std::vector<std::string> Tags;
+	std::unordered_map<std::string, uint32_t> TagIDs;
+	std::unordered_map<std::string, FESceneGraphIndexFilterResult> FilterResults;
+
+	static std::unordered_map<std::string, FESceneGraphIndex*>& GetIndices();
+	FESceneGraphIndex(const std::string& SceneID);
+
+	void Rebuild();
+	size_t AddEntry(FENaiveSceneGraphNode* Node, int ParentIndex);
+	void SetEntryName(FESceneGraphIndexEntry& Entry);
+	uint32_t GetOrAddTagID(const std::string& Tag);
+	void AddToAncestorSubtreeCounts(int AncestorIndex, int64_t Delta);
+	void UpdateSubtreeDepth(size_t EntryIndex);
+	void ApplyChange(const FESceneGraphChangeRecord& Change);
+public:
+	FESceneGraphIndex(const FESceneGraphIndex&) = delete;
+	FESceneGraphIndex& operator=(const FESceneGraphIndex&) = delete;
+
+	// Index is created on first acquire and deleted when the last reference is released.
+	static FESceneGraphIndex* Acquire(const std::string& SceneID);
+	static void Release(FESceneGraphIndex* Index);
+	// Without complete journal index could miss host changes, so it is rebuilt from the scene. Caller should release it.
+	static FESceneGraphIndex* AcquireUpToDate(const std::string& SceneID, bool bSceneChangeJournalComplete);
+
+	std::string GetSceneID() const;
+	size_t GetReferenceCount() const;
+
+	// Applies journal changes since the last update, it is cheap when nothing has changed.
+	void Update();
+	// Should be used after scene changes that are not recorded in the journal, e.g. tag changes.
+	void Invalidate();
+
+	uint64_t GetVersion() const;
+	uint64_t GetJournalSequence() const;
+	size_t GetNodeCount() const;
+
+	const FESceneGraphIndexEntry* GetEntry(const std::string& NodeID) const;
+	// O(1) alternative to FENaiveSceneGraph::GetNodeByID.
+	FENaiveSceneGraphNode* GetNodeByID(const std::string& NodeID) const;
+	std::string_view GetNodeName(const FESceneGraphIndexEntry& Entry) const;
+	std::string GetTag(uint32_t TagID) const;
+
+	// Node passes if its name or name of any descendant contains filter text, the same rule as in FESceneGraphUI.
+	// Returns false if node is not in the index.
+	bool TryGetTextFilterResult(const std::string& NodeID, const std::string& FilterText, bool bCaseSensitive, bool& bOutPasses);
+};
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "FESceneGraphMinimap.h"
+
+size_t FESceneGraphMinimap::GetResolution() const
+{
+	return Resolution;
+}
+
+void FESceneGraphMinimap::SetResolution(size_t NewValue)
+{
+	if (NewValue == 0 || NewValue == Resolution)
+		return;
+
+	Resolution = NewValue;
+	bBuilt = false;
+	for (size_t i = 0; i < FE_SCENE_GRAPH_MINIMAP_MARK_COUNT; i++)
+	{
+		MarkCounts[i].clear();
+		RowMarks[i].clear();
+	}
+}
+
+size_t FESceneGraphMinimap::GetRowCount() const
+{
+	return RowCount;
+}
+
+bool FESceneGraphMinimap::IsBuiltFrom(const FESceneGraphRowModel& RowModel) const
+{
+	return bBuilt && RowModelVersion == RowModel.GetVersion() && RowCount == RowModel.GetRowCount();
+}
+
+void FESceneGraphMinimap::Reset(const FESceneGraphRowModel& RowModel)
+{
+	RowCount = RowModel.GetRowCount();
+	RowModelVersion = RowModel.GetVersion();
+	bBuilt = true;
+	for (size_t i = 0; i < FE_SCENE_GRAPH_MINIMAP_MARK_COUNT; i++)
+	{
+		MarkCounts[i].assign(Resolution, 0);
+		RowMarks[i].assign(RowCount, false);
+	}
+}
+
+void FESceneGraphMinimap::SetRowModelVersion(const FESceneGraphRowModel& RowModel)
+{
+	if (!bBuilt || RowCount != RowModel.GetRowCount())
+		return;
+
+	RowModelVersion = RowModel.GetVersion();
+}
+
+size_t FESceneGraphMinimap::GetBucketIndex(size_t RowIndex) const
+{
+	if (RowCount == 0)
+		return 0;
+
+	// When there are fewer rows than buckets, each row gets its own range of buckets and the first one is used.
+	return std::min(static_cast<size_t>(static_cast<uint64_t>(RowIndex) * Resolution / RowCount), Resolution - 1);
+}
+
+void FESceneGraphMinimap::GetBucketRowRange(size_t BucketIndex, size_t& OutFirstRowIndex, size_t& OutRowCount) const
+{
+	OutFirstRowIndex = 0;
+	OutRowCount = 0;
+	if (RowCount == 0 || BucketIndex >= Resolution)
+		return;
+
+	// Inverse of GetBucketIndex, rounded up so that rows are not shared between buckets.
+	size_t FirstRowIndex = static_cast<size_t>((static_cast<uint64_t>(BucketIndex) * RowCount + Resolution - 1) / Resolution);
+	size_t EndRowIndex = static_cast<size_t>((static_cast<uint64_t>(BucketIndex + 1) * RowCount + Resolution - 1) / Resolution);
+	OutFirstRowIndex = std::min(FirstRowIndex, RowCount);
+	OutRowCount = std::min(EndRowIndex, RowCount) - OutFirstRowIndex;
+}
+
+void FESceneGraphMinimap::AddMark(size_t RowIndex, FE_SCENE_GRAPH_MINIMAP_MARK Mark)
+{
+	SetMark(RowIndex, Mark, true);
+}
+
+void FESceneGraphMinimap::RemoveMark(size_t RowIndex, FE_SCENE_GRAPH_MINIMAP_MARK Mark)
+{
+	SetMark(RowIndex, Mark, false);
+}
+
+void FESceneGraphMinimap::SetMark(size_t RowIndex, FE_SCENE_GRAPH_MINIMAP_MARK Mark, bool bMarked)
+{
+	if (!bBuilt || RowIndex >= RowCount || Mark >= FE_SCENE_GRAPH_MINIMAP_MARK_COUNT)
+		return;
+
+	if (RowMarks[Mark][RowIndex] == bMarked)
+		return;
+
+	RowMarks[Mark][RowIndex] = bMarked;
+	uint32_t& Count = MarkCounts[Mark][GetBucketIndex(RowIndex)];
+	if (bMarked)
+	{
+		Count++;
+	}
+	else
+	{
+		Count--;
+	}
+}
+
+bool FESceneGraphMinimap::IsRowMarked(size_t RowIndex, FE_SCENE_GRAPH_MINIMAP_MARK Mark) const
+{
+	if (!bBuilt || RowIndex >= RowCount || Mark >= FE_SCENE_GRAPH_MINIMAP_MARK_COUNT)
+		return false;
+
+	return RowMarks[Mark][RowIndex];
+}
+
+uint32_t FESceneGraphMinimap::GetMarkCount(size_t BucketIndex, FE_SCENE_GRAPH_MINIMAP_MARK Mark) const
+{
+	if (Mark >= FE_SCENE_GRAPH_MINIMAP_MARK_COUNT || BucketIndex >= MarkCounts[Mark].size())
+		return 0;
+
+	return MarkCounts[Mark][BucketIndex];
+}
+
+bool FESceneGraphMinimap::IsBucketMarked(size_t BucketIndex) const
+{
+	for (size_t i = 0; i < FE_SCENE_GRAPH_MINIMAP_MARK_COUNT; i++)
+	{
+		if (GetMarkCount(BucketIndex, static_cast<FE_SCENE_GRAPH_MINIMAP_MARK>(i)) != 0)
+			return true;
+	}
+
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include "FESceneGraphRowModel.h"
+
+enum FE_SCENE_GRAPH_MINIMAP_MARK
+{
+	FE_SCENE_GRAPH_MINIMAP_MARK_SELECTION = 0,
+	FE_SCENE_GRAPH_MINIMAP_MARK_FILTER_MATCH = 1,
+	FE_SCENE_GRAPH_MINIMAP_MARK_ALERT = 2,
+	FE_SCENE_GRAPH_MINIMAP_MARK_COUNT = 3
+};
+
+// Fixed resolution histogram of marked rows over the full row range.
+// It is filled from the row model, so the scene graph is not traversed and it does not depend on ImGui.
+class FESceneGraphMinimap
+{
+	size_t Resolution = 256;
+	size_t RowCount = 0;
+	// Version of the row model that marks were built from.
+	uint64_t RowModelVersion = 0;
+	bool bBuilt = false;
+	std::vector<uint32_t> MarkCounts[FE_SCENE_GRAPH_MINIMAP_MARK_COUNT];
+	// Marks of each row, so changes of single rows could be applied to buckets without rebuilding them.
+	std::vector<bool> RowMarks[FE_SCENE_GRAPH_MINIMAP_MARK_COUNT];
+public:
+	size_t GetResolution() const;
+	// Marks are dropped, they should be built again.
+	void SetResolution(size_t NewValue);
+
+	size_t GetRowCount() const;
+	bool IsBuiltFrom(const FESceneGraphRowModel& RowModel) const;
+	// Clears all marks and prepares buckets for given row model.
+	void Reset(const FESceneGraphRowModel& RowModel);
+
+	size_t GetBucketIndex(size_t RowIndex) const;
+	void GetBucketRowRange(size_t BucketIndex, size_t& OutFirstRowIndex, size_t& OutRowCount) const;
+
+	// Marking already marked row (or unmarking not marked one) does nothing.
+	void AddMark(size_t RowIndex, FE_SCENE_GRAPH_MINIMAP_MARK Mark);
+	void RemoveMark(size_t RowIndex, FE_SCENE_GRAPH_MINIMAP_MARK Mark);
+	void SetMark(size_t RowIndex, FE_SCENE_GRAPH_MINIMAP_MARK Mark, bool bMarked);
+	bool IsRowMarked(size_t RowIndex, FE_SCENE_GRAPH_MINIMAP_MARK Mark) const;
+	// For row model changes that keep all rows in place, after marks of changed rows were updated.
+	void SetRowModelVersion(const FESceneGraphRowModel& RowModel);
+	uint32_t GetMarkCount(size_t BucketIndex, FE_SCENE_GRAPH_MINIMAP_MARK Mark) const;
+	bool IsBucketMarked(size_t BucketIndex) const;
+};
\ No newline at end of file
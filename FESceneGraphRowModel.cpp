@@ -0,0 +1,123 @@
+#include "FESceneGraphRowModel.h"
+
+bool FESceneGraphUIRowWidget::operator==(const FESceneGraphUIRowWidget& Other) const
+{
+	return WidgetIndex == Other.WidgetIndex && Icon == Other.Icon;
+}
+
+bool FESceneGraphUIRowWidget::operator!=(const FESceneGraphUIRowWidget& Other) const
+{
+	return !(*this == Other);
+}
+
+bool FESceneGraphUIRow::operator==(const FESceneGraphUIRow& Other) const
+{
+	return Type == Other.Type &&
+		   Node == Other.Node &&
+		   NodeID == Other.NodeID &&
+		   ParentRowIndex == Other.ParentRowIndex &&
+		   Indentation == Other.Indentation &&
+		   bHasVisibleChildren == Other.bHasVisibleChildren &&
+		   bExpanded == Other.bExpanded &&
+		   bSelected == Other.bSelected &&
+		   bOnSelectedBranch == Other.bOnSelectedBranch &&
+		   bFilterMatch == Other.bFilterMatch &&
+		   DisplayName == Other.DisplayName &&
+		   Icon == Other.Icon &&
+		   Widgets == Other.Widgets &&
+		   LoadedChildCount == Other.LoadedChildCount &&
+		   TotalChildCount == Other.TotalChildCount &&
+		   GroupKey == Other.GroupKey;
+}
+
+bool FESceneGraphUIRow::operator!=(const FESceneGraphUIRow& Other) const
+{
+	return !(*this == Other);
+}
+
+FENaiveSceneGraphNode* FESceneGraphRowModel::GetRenderingRoot() const
+{
+	return RenderingRoot;
+}
+
+bool FESceneGraphRowModel::IsRenderingRootItself() const
+{
+	return bRenderRootItself;
+}
+
+uint64_t FESceneGraphRowModel::GetVersion() const
+{
+	return Version;
+}
+
+size_t FESceneGraphRowModel::GetVisitedNodeCount() const
+{
+	return VisitedNodeCount;
+}
+
+const std::vector<FESceneGraphUIRow>& FESceneGraphRowModel::GetRows() const
+{
+	return Rows;
+}
+
+size_t FESceneGraphRowModel::GetRowCount() const
+{
+	return Rows.size();
+}
+
+const FESceneGraphUIRow* FESceneGraphRowModel::GetRow(size_t RowIndex) const
+{
+	if (RowIndex >= Rows.size())
+		return nullptr;
+
+	return &Rows[RowIndex];
+}
+
+int FESceneGraphRowModel::FindRowIndex(const std::string& NodeID) const
+{
+	auto Iterator = NodeRowIndices.find(NodeID);
+	if (Iterator == NodeRowIndices.end())
+		return -1;
+
+	return static_cast<int>(Iterator->second);
+}
+
+void FESceneGraphRowModel::GetRowRangeInScrollWindow(float ScrollY, float WindowHeight, float RowPitch, size_t& OutFirstRowIndex, size_t& OutRowCount) const
+{
+	OutFirstRowIndex = 0;
+	OutRowCount = 0;
+	if (Rows.empty() || RowPitch <= 0.0f || WindowHeight <= 0.0f)
+		return;
+
+	size_t FirstRowIndex = static_cast<size_t>(std::max(0.0f, ScrollY) / RowPitch);
+	if (FirstRowIndex >= Rows.size())
+		return;
+
+	size_t LastRowIndex = static_cast<size_t>((std::max(0.0f, ScrollY) + WindowHeight) / RowPitch);
+	LastRowIndex = std::min(LastRowIndex, Rows.size() - 1);
+
+	OutFirstRowIndex = FirstRowIndex;
+	OutRowCount = LastRowIndex - FirstRowIndex + 1;
+}
+
+std::vector<FESceneGraphUIRow> FESceneGraphRowModel::GetRowsInScrollWindow(float ScrollY, float WindowHeight, float RowPitch) const
+{
+	size_t FirstRowIndex = 0;
+	size_t RowCount = 0;
+	GetRowRangeInScrollWindow(ScrollY, WindowHeight, RowPitch, FirstRowIndex, RowCount);
+
+	return std::vector<FESceneGraphUIRow>(Rows.begin() + FirstRowIndex, Rows.begin() + FirstRowIndex + RowCount);
+}
+
+std::vector<size_t> FESceneGraphRowModel::GetChangedRowIndices(const FESceneGraphRowModel& OldModel, const FESceneGraphRowModel& NewModel)
+{
+	std::vector<size_t> Result;
+	size_t MaxRowCount = std::max(OldModel.Rows.size(), NewModel.Rows.size());
+	for (size_t i = 0; i < MaxRowCount; i++)
+	{
+		if (i >= OldModel.Rows.size() || i >= NewModel.Rows.size() || OldModel.Rows[i] != NewModel.Rows[i])
+			Result.push_back(i);
+	}
+
+	return Result;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+#include "FEngine.h"
+
+enum FE_SCENE_GRAPH_UI_ROW_TYPE
+{
+	FE_SCENE_GRAPH_UI_ROW_NODE = 0,
+	// Placeholder for children of paged node that are not materialized yet, Node is the paged parent.
+	FE_SCENE_GRAPH_UI_ROW_MORE_CHILDREN = 1,
+	// Synthetic group of siblings, Node is their parent and GroupKey identifies the group.
+	FE_SCENE_GRAPH_UI_ROW_SIBLING_GROUP = 2
+};
+
+struct FESceneGraphUIRowWidget
+{
+	// Index in FESceneGraphUI::NodeWidgets.
+	size_t WidgetIndex = 0;
+	FETexture* Icon = nullptr;
+
+	bool operator==(const FESceneGraphUIRowWidget& Other) const;
+	bool operator!=(const FESceneGraphUIRowWidget& Other) const;
+};
+
+// One visible line of the scene graph tree.
+// It contains only results of the scene graph UI logic and does not depend on ImGui.
+struct FESceneGraphUIRow
+{
+	FE_SCENE_GRAPH_UI_ROW_TYPE Type = FE_SCENE_GRAPH_UI_ROW_NODE;
+	FENaiveSceneGraphNode* Node = nullptr;
+	std::string NodeID = "";
+	int ParentRowIndex = -1;
+	size_t Indentation = 0;
+	bool bHasVisibleChildren = false;
+	bool bExpanded = false;
+	bool bSelected = false;
+	bool bOnSelectedBranch = false;
+	// Own display name matches the text filter, ancestors that are shown only for context do not.
+	bool bFilterMatch = false;
+	std::string DisplayName = "";
+	FETexture* Icon = nullptr;
+	std::vector<FESceneGraphUIRowWidget> Widgets;
+	// Only for FE_SCENE_GRAPH_UI_ROW_MORE_CHILDREN rows, children before LoadedChildCount have rows above this one.
+	size_t LoadedChildCount = 0;
+	size_t TotalChildCount = 0;
+	std::string GroupKey = "";
+
+	bool operator==(const FESceneGraphUIRow& Other) const;
+	bool operator!=(const FESceneGraphUIRow& Other) const;
+};
+
+// Flattened visible part of the tree for current rendering root, filter and expansion state.
+// It is produced by FESceneGraphUI without ImGui context, so it can be used in tests, benchmarks or other renderers.
+class FESceneGraphRowModel
+{
+	friend class FESceneGraphUI;
+
+	std::vector<FESceneGraphUIRow> Rows;
+	// Row index of each visible node, placeholder rows are not included.
+	std::unordered_map<std::string, size_t> NodeRowIndices;
+	FENaiveSceneGraphNode* RenderingRoot = nullptr;
+	bool bRenderRootItself = false;
+	// Incremented every time rows are rebuilt.
+	uint64_t Version = 0;
+	// Number of nodes that were checked during the last rebuild, including the hidden ones.
+	size_t VisitedNodeCount = 0;
+public:
+	FENaiveSceneGraphNode* GetRenderingRoot() const;
+	bool IsRenderingRootItself() const;
+	uint64_t GetVersion() const;
+	size_t GetVisitedNodeCount() const;
+
+	const std::vector<FESceneGraphUIRow>& GetRows() const;
+	size_t GetRowCount() const;
+	const FESceneGraphUIRow* GetRow(size_t RowIndex) const;
+	// Returns -1 if node does not have a visible row, placeholder rows are ignored.
+	// It is O(1), so it could be called for every picked node.
+	int FindRowIndex(const std::string& NodeID) const;
+
+	// Rows that intersect scroll window with given offset and height.
+	void GetRowRangeInScrollWindow(float ScrollY, float WindowHeight, float RowPitch, size_t& OutFirstRowIndex, size_t& OutRowCount) const;
+	std::vector<FESceneGraphUIRow> GetRowsInScrollWindow(float ScrollY, float WindowHeight, float RowPitch) const;
+
+	// Indices of rows that differ between two models, rows are matched by position.
+	static std::vector<size_t> GetChangedRowIndices(const FESceneGraphRowModel& OldModel, const FESceneGraphRowModel& NewModel);
+};
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "FESceneGraphSiblingGrouping.h"
+
+std::string FESceneGraphSiblingGrouping::GetNamePrefix(const std::string& Name)
+{
+	size_t PrefixLength = Name.size();
+	while (PrefixLength > 0 && isdigit(static_cast<unsigned char>(Name[PrefixLength - 1])))
+		PrefixLength--;
+
+	while (PrefixLength > 0 && (Name[PrefixLength - 1] == '_' || Name[PrefixLength - 1] == '-' || Name[PrefixLength - 1] == ' ' || Name[PrefixLength - 1] == '.'))
+		PrefixLength--;
+
+	return Name.substr(0, PrefixLength);
+}
+
+std::string FESceneGraphSiblingGrouping::GetNodeTag(FENaiveSceneGraphNode* Node)
+{
+	if (Node == nullptr || Node->GetEntity() == nullptr)
+		return "";
+
+	return Node->GetEntity()->GetTag();
+}
+
+std::vector<FESceneGraphSiblingGroup> FESceneGraphSiblingGrouping::Build(const std::vector<FENaiveSceneGraphNode*>& Siblings, FE_SCENE_GRAPH_UI_SIBLING_GROUPING Mode,
+																		 std::function<std::string(FENaiveSceneGraphNode*)> NameProvider, size_t AlphabeticalGroupSize)
+{
+	std::vector<FESceneGraphSiblingGroup> Result;
+	if (Mode == FE_SCENE_GRAPH_UI_SIBLING_GROUPING_NONE || Siblings.empty() || NameProvider == nullptr)
+		return Result;
+
+	// Keys and names are computed once, then indices are sorted and partitioned into runs of equal keys.
+	std::vector<std::string> Names(Siblings.size());
+	std::vector<std::string> Keys(Siblings.size());
+	for (size_t i = 0; i < Siblings.size(); i++)
+	{
+		Names[i] = NameProvider(Siblings[i]);
+		switch (Mode)
+		{
+			case FE_SCENE_GRAPH_UI_SIBLING_GROUPING_TAG:
+				Keys[i] = GetNodeTag(Siblings[i]);
+				break;
+			case FE_SCENE_GRAPH_UI_SIBLING_GROUPING_NAME_PREFIX:
+				Keys[i] = GetNamePrefix(Names[i]);
+				break;
+			case FE_SCENE_GRAPH_UI_SIBLING_GROUPING_ALPHABETICAL:
+				Keys[i] = Names[i];
+				std::transform(Keys[i].begin(), Keys[i].end(), Keys[i].begin(), ::tolower);
+				break;
+			default:
+				break;
+		}
+	}
+
+	std::vector<size_t> Order(Siblings.size());
+	for (size_t i = 0; i < Order.size(); i++)
+		Order[i] = i;
+
+	std::stable_sort(Order.begin(), Order.end(), [&Keys](size_t A, size_t B) {
+		return Keys[A] < Keys[B];
+	});
+
+	if (Mode == FE_SCENE_GRAPH_UI_SIBLING_GROUPING_ALPHABETICAL)
+	{
+		AlphabeticalGroupSize = std::max(AlphabeticalGroupSize, static_cast<size_t>(1));
+		for (size_t First = 0; First < Order.size(); First += AlphabeticalGroupSize)
+		{
+			size_t Last = std::min(First + AlphabeticalGroupSize, Order.size()) - 1;
+
+			FESceneGraphSiblingGroup NewGroup;
+			NewGroup.Key = "Range " + std::to_string(First / AlphabeticalGroupSize);
+			NewGroup.Label = Names[Order[First]] + " .. " + Names[Order[Last]] + " (" + std::to_string(Last - First + 1) + ")";
+			for (size_t i = First; i <= Last; i++)
+				NewGroup.Members.push_back(Siblings[Order[i]]);
+
+			Result.push_back(std::move(NewGroup));
+		}
+
+		return Result;
+	}
+
+	size_t First = 0;
+	while (First < Order.size())
+	{
+		size_t End = First;
+		std::string FirstName = Names[Order[First]];
+		std::string LastName = FirstName;
+
+		FESceneGraphSiblingGroup NewGroup;
+		NewGroup.Key = Keys[Order[First]];
+		while (End < Order.size() && Keys[Order[End]] == NewGroup.Key)
+		{
+			NewGroup.Members.push_back(Siblings[Order[End]]);
+			FirstName = std::min(FirstName, Names[Order[End]]);
+			LastName = std::max(LastName, Names[Order[End]]);
+			End++;
+		}
+
+		std::string CountText = " (" + std::to_string(NewGroup.Members.size()) + ")";
+		if (Mode == FE_SCENE_GRAPH_UI_SIBLING_GROUPING_TAG)
+		{
+			NewGroup.Label = (NewGroup.Key.empty() ? "Untagged" : "Tag: " + NewGroup.Key) + CountText;
+		}
+		else
+		{
+			NewGroup.Label = (FirstName == LastName ? FirstName : FirstName + " .. " + LastName) + CountText;
+		}
+
+		Result.push_back(std::move(NewGroup));
+		First = End;
+	}
+
+	return Result;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include "FEngine.h"
+
+enum FE_SCENE_GRAPH_UI_SIBLING_GROUPING
+{
+	FE_SCENE_GRAPH_UI_SIBLING_GROUPING_NONE = 0,
+	FE_SCENE_GRAPH_UI_SIBLING_GROUPING_TAG = 1,
+	// Name without trailing number, e.g. Tree_0001..Tree_0999 are grouped under "Tree".
+	FE_SCENE_GRAPH_UI_SIBLING_GROUPING_NAME_PREFIX = 2,
+	// Siblings sorted by name and split into ranges of fixed size.
+	FE_SCENE_GRAPH_UI_SIBLING_GROUPING_ALPHABETICAL = 3
+};
+
+// Synthetic group of siblings, it exists only in UI and does not change the scene graph.
+struct FESceneGraphSiblingGroup
+{
+	std::string Key = "";
+	std::string Label = "";
+	std::vector<FENaiveSceneGraphNode*> Members;
+};
+
+class FESceneGraphSiblingGrouping
+{
+public:
+	// Groups are ordered by key, members of tag and name prefix groups keep storage order.
+	static std::vector<FESceneGraphSiblingGroup> Build(const std::vector<FENaiveSceneGraphNode*>& Siblings, FE_SCENE_GRAPH_UI_SIBLING_GROUPING Mode,
+													   std::function<std::string(FENaiveSceneGraphNode*)> NameProvider, size_t AlphabeticalGroupSize = 1000);
+
+	static std::string GetNamePrefix(const std::string& Name);
+	static std::string GetNodeTag(FENaiveSceneGraphNode* Node);
+};
\ No newline at end of file
@@ -1,13 +1,18 @@
 #include "FESceneGraphUI.h"
 
-bool FESceneGraphUI::bLastNodeWasEven = true;
-
 FESceneGraphUI::FESceneGraphUI()
 {
 	strcpy_s(CharFilterText, PlaceHolderTextString.c_str());
+	FESceneGraphUIFontCache::Acquire(FontPath);
 }
 
-FESceneGraphUI::~FESceneGraphUI() {}
+FESceneGraphUI::~FESceneGraphUI()
+{
+	FESceneGraphUIFontCache::Release(FontPath);
+	FESceneGraphIndex::Release(SceneIndex);
+	for (const auto& SequencePair : LastSeenJournalSequences)
+		FESceneGraphChangeJournal::Release(SequencePair.first);
+}
 
 #include "VersionInfo/FE_SCENE_GRAPH_UI_Version.h"
 #include "VersionInfo/FEVersionInfo.h"
@@ -36,26 +41,33 @@ FENaiveSceneGraphNode* FESceneGraphUI::GetCurrentRenderingRoot() const
 void FESceneGraphUI::SetNodeRenderPredicate(std::function<bool(FENaiveSceneGraphNode*)> Predicate)
 {
 	NodeRenderPredicate = Predicate;
+	MarkRowsDirty();
 }
 
 void FESceneGraphUI::SetNodeDisplayNameProvider(std::function<std::string(FENaiveSceneGraphNode*)> Provider)
 {
 	NodeDisplayNameProvider = Provider;
+	// Name based groups and sort order depend on displayed names.
+	SortedChildrenCaches.clear();
+	ClearSiblingGroupCaches();
 }
 
 void FESceneGraphUI::SetNodeChildrenVisiblePredicate(std::function<bool(FENaiveSceneGraphNode*)> Predicate)
 {
 	NodeChildrenVisiblePredicate = Predicate;
+	MarkRowsDirty();
 }
 
 void FESceneGraphUI::SetNodeIconProvider(std::function<FETexture* (FENaiveSceneGraphNode*)> Provider)
 {
 	NodeIconProvider = Provider;
+	MarkRowsDirty();
 }
 
 void FESceneGraphUI::SetNodeSelectionPredicate(std::function<bool(FENaiveSceneGraphNode*)> Predicate)
 {
 	NodeSelectionPredicate = Predicate;
+	MarkRowsDirty();
 }
 
 void FESceneGraphUI::ClearAllProvidersAndPredicates()
@@ -65,12 +77,18 @@ void FESceneGraphUI::ClearAllProvidersAndPredicates()
 	NodeChildrenVisiblePredicate = nullptr;
 	NodeIconProvider = nullptr;
 	NodeSelectionPredicate = nullptr;
+	SortedChildrenCaches.clear();
+	ClearSiblingGroupCaches();
 }
 
 FETexture* FESceneGraphUI::GetNodeIcon(FENaiveSceneGraphNode* Node)
 {
 	if (NodeIconProvider != nullptr)
+	{
+		FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_PROVIDERS);
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_PROVIDER_CALLS, 1);
 		return NodeIconProvider(Node);
+	}
 	
 	return nullptr;
 }
@@ -80,7 +98,11 @@ std::string FESceneGraphUI::GetNodeDisplayName(FENaiveSceneGraphNode* Node)
 	FEEntity* CurrentEntity = Node->GetEntity();
 	std::string DisplayedName = CurrentEntity == nullptr ? Node->GetName() : CurrentEntity->GetName();
 	if (NodeDisplayNameProvider != nullptr)
+	{
+		FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_PROVIDERS);
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_PROVIDER_CALLS, 1);
 		DisplayedName = NodeDisplayNameProvider(Node);
+	}
 
 	return DisplayedName;
 }
@@ -93,24 +115,66 @@ std::vector<std::string> FESceneGraphUI::GetHiddenEntityTags() const
 void FESceneGraphUI::SetHiddenEntityTags(const std::vector<std::string>& NewHiddenEntityTags)
 {
 	HiddenEntityTags = NewHiddenEntityTags;
+	MarkRowsDirty();
 }
 
 void FESceneGraphUI::AddHiddenEntityTag(const std::string& TagToAdd)
 {
 	if (std::find(HiddenEntityTags.begin(), HiddenEntityTags.end(), TagToAdd) == HiddenEntityTags.end())
+	{
 		HiddenEntityTags.push_back(TagToAdd);
+		MarkRowsDirty();
+	}
 }
 
 void FESceneGraphUI::RemoveHiddenEntityTag(const std::string& TagToRemove)
 {
 	auto Iterator = std::find(HiddenEntityTags.begin(), HiddenEntityTags.end(), TagToRemove);
 	if (Iterator != HiddenEntityTags.end())
+	{
 		HiddenEntityTags.erase(Iterator);
+		MarkRowsDirty();
+	}
 }
 
 void FESceneGraphUI::ClearHiddenEntityTags()
 {
 	HiddenEntityTags.clear();
+	MarkRowsDirty();
+}
+
+std::string FESceneGraphUI::GetFilterText() const
+{
+	return bFilterEnabled ? FilterText : "";
+}
+
+void FESceneGraphUI::SetFilterText(const std::string& NewFilterText)
+{
+	std::string OldFilterText = FilterText;
+	FilterText = NewFilterText.substr(0, FilterInputBufferSize - 1);
+	ViewHistory.RecordFilterChange(OldFilterText, FilterText);
+	bFilterEnabled = !FilterText.empty();
+	bIsPlaceHolderTextUsed = FilterText.empty();
+	strcpy_s(CharFilterText, bIsPlaceHolderTextUsed ? PlaceHolderTextString.c_str() : FilterText.c_str());
+	MarkRowsDirty();
+}
+
+bool FESceneGraphUI::DoesDisplayNameMatchFilter(const std::string& DisplayName) const
+{
+	std::string UsedFilterText = FilterText;
+	std::string UsedDisplayName = DisplayName;
+	if (!bCaseSensitiveFiltering)
+	{
+		std::transform(UsedDisplayName.begin(), UsedDisplayName.end(), UsedDisplayName.begin(), ::tolower);
+		std::transform(UsedFilterText.begin(), UsedFilterText.end(), UsedFilterText.begin(), ::tolower);
+	}
+
+	return UsedDisplayName.find(UsedFilterText) != std::string::npos;
+}
+
+bool FESceneGraphUI::IsTextFilterActive() const
+{
+	return bFilterEnabled && !FilterText.empty();
 }
 
 bool FESceneGraphUI::DoesNodePassTextFilter(FENaiveSceneGraphNode* Node)
@@ -124,15 +188,14 @@ bool FESceneGraphUI::DoesNodePassTextFilter(FENaiveSceneGraphNode* Node)
 	if (FilterText.empty())
 		return true;
 
-	std::string UsedFilterText = FilterText;
-	std::string NodeDisplayName = GetNodeDisplayName(Node);
-	if (!bCaseSensitiveFiltering)
-	{
-		std::transform(NodeDisplayName.begin(), NodeDisplayName.end(), NodeDisplayName.begin(), ::tolower);
-		std::transform(UsedFilterText.begin(), UsedFilterText.end(), UsedFilterText.begin(), ::tolower);
-	}
+	// Without display name provider names come from the scene, so result is shared through the scene index.
+	// Names in the index are updated only by journal records, so it is used only if host records all changes.
+	bool bPassesFilter = false;
+	if (NodeDisplayNameProvider == nullptr && bSceneChangeJournalComplete && SceneIndex != nullptr &&
+		SceneIndex->TryGetTextFilterResult(Node->GetObjectID(), FilterText, bCaseSensitiveFiltering, bPassesFilter))
+		return bPassesFilter;
 
-	if (NodeDisplayName.find(UsedFilterText) != std::string::npos)
+	if (DoesDisplayNameMatchFilter(GetNodeDisplayName(Node)))
 		return true;
 
 	// Check all children recursively, if at least one of them passes the filter, then this node should be visible as well.
@@ -157,12 +220,19 @@ bool FESceneGraphUI::ShouldNodeBeVisible(FENaiveSceneGraphNode* Node)
 		if (std::find(HiddenEntityTags.begin(), HiddenEntityTags.end(), EntityTag) != HiddenEntityTags.end())
 			return false;
 
+		// Without filter text every node passes, span would only add noise.
+		FE_SCENE_GRAPH_UI_TRACE_SPAN(IsTextFilterActive() ? TraceSink : nullptr, "Filter");
+		FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_FILTERING);
 		if (!DoesNodePassTextFilter(Node))
 			return false;
 	}
 
 	if (NodeRenderPredicate != nullptr)
+	{
+		FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_PREDICATES);
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_PREDICATE_CALLS, 1);
 		return NodeRenderPredicate(Node);
+	}
 	
 	return true;
 }
@@ -176,7 +246,11 @@ bool FESceneGraphUI::AreNodeChildrenVisible(FENaiveSceneGraphNode* Node)
 		return false;
 
 	if (NodeChildrenVisiblePredicate != nullptr)
+	{
+		FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_PREDICATES);
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_PREDICATE_CALLS, 1);
 		return NodeChildrenVisiblePredicate(Node);
+	}
 	
 	return true;
 }
@@ -199,7 +273,12 @@ bool FESceneGraphUI::IsNodeExpanded(FENaiveSceneGraphNode* Node)
 
 void FESceneGraphUI::SetNodeExpanded(FENaiveSceneGraphNode* Node, bool bExpanded)
 {
-	NodeState[Node->GetObjectID()].bExpanded = bExpanded;
+	FESceneGraphNodeStateData& Data = NodeState[Node->GetObjectID()];
+	if (Data.bExpanded != bExpanded)
+		ViewHistory.RecordNodeChange(Node->GetObjectID(), FE_SCENE_GRAPH_VIEW_HISTORY_FIELD_EXPANDED, bExpanded);
+
+	Data.bExpanded = bExpanded;
+	MarkRowsDirty();
 }
 
 bool FESceneGraphUI::IsNodeExpandedTo(FENaiveSceneGraphNode* Node)
@@ -217,10 +296,26 @@ bool FESceneGraphUI::IsNodeExpandedTo(FENaiveSceneGraphNode* Node)
 
 void FESceneGraphUI::ExpandToNode(FENaiveSceneGraphNode* Node)
 {
+	// Ancestors above the first child that already has a row show the path, so their children are not listed again.
+	// Every change marks only rows of its own subtree, so revealing a node does not rebuild all rows.
+	const bool bRowsUpToDate = !ShouldRebuildRows() && PendingRowSubtreeNodeIDs.empty() && IsSyncedWithChangeJournal();
+	FENaiveSceneGraphNode* Child = Node;
 	FENaiveSceneGraphNode* Current = Node->GetParent();
 	while (Current != nullptr)
 	{
-		NodeState[Current->GetObjectID()].bExpanded = true;
+		if (bRowsUpToDate && RowModel.FindRowIndex(Child->GetObjectID()) != -1)
+			break;
+
+		FESceneGraphNodeStateData& Data = NodeState[Current->GetObjectID()];
+		if (!Data.bExpanded)
+		{
+			ViewHistory.RecordNodeChange(Current->GetObjectID(), FE_SCENE_GRAPH_VIEW_HISTORY_FIELD_EXPANDED, true);
+			Data.bExpanded = true;
+			MarkRowSubtreeDirty(Current);
+		}
+
+		EnsureChildIsMaterialized(Current, Child);
+		Child = Current;
 		Current = Current->GetParent();
 	}
 }
@@ -231,6 +326,8 @@ bool FESceneGraphUI::IsNodeSelected(FENaiveSceneGraphNode* Node)
 	std::string NodeID = Node->GetObjectID();
 	if (NodeSelectionPredicate != nullptr)
 	{
+		FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_PREDICATES);
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_PREDICATE_CALLS, 1);
 		bool bResult = NodeSelectionPredicate(Node);
 		SetNodeSelectedInternal(Node, bResult);
 
@@ -260,25 +357,50 @@ void FESceneGraphUI::SetNodeSelectedInternal(FENaiveSceneGraphNode* Node, bool b
 	if (bSelected)
 		ExpandToNode(Node);
 
+	SetNodeSelectionState(Node, bSelected);
+}
+
+void FESceneGraphUI::SetNodeSelectionState(FENaiveSceneGraphNode* Node, bool bSelected)
+{
+	if (Node == nullptr)
+		return;
+
+	if (NodeState[Node->GetObjectID()].bSelected == bSelected)
+		return;
+
 	bool bOldSelectionState = NodeState[Node->GetObjectID()].bSelected;
 	NodeState[Node->GetObjectID()].bSelected = bSelected;
+	if (bSelected)
+	{
+		SelectedNodeIDSet.insert(Node->GetObjectID());
+	}
+	else
+	{
+		SelectedNodeIDSet.erase(Node->GetObjectID());
+	}
+	ViewHistory.RecordNodeChange(Node->GetObjectID(), FE_SCENE_GRAPH_VIEW_HISTORY_FIELD_SELECTED, bSelected);
+	MarkRowSelectionDirty(Node);
 	
-	for (const auto& Callback : OnNodeSelectionChangedCallbacks)
-		Callback(Node, bOldSelectionState);
+	for (auto& Registration : OnNodeSelectionChangedCallbacks)
+	{
+		FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, Registration.Name.c_str());
+		Registration.Function(Node, bOldSelectionState);
+	}
 }
 
 void FESceneGraphUI::SetNodeSelected(FENaiveSceneGraphNode* Node, bool bSelected)
 {
 	if (!bAllowMultipleNodeSelection && bSelected)
 	{
-		for (auto& NodeStatePair : NodeState)
+		// Copy, because deselection modifies the set.
+		std::vector<std::string> PreviouslySelectedNodeIDs(SelectedNodeIDSet.begin(), SelectedNodeIDSet.end());
+		for (size_t i = 0; i < PreviouslySelectedNodeIDs.size(); i++)
 		{
-			if (NodeStatePair.first == Node->GetObjectID())
+			if (PreviouslySelectedNodeIDs[i] == Node->GetObjectID())
 				continue;
 
-			FENaiveSceneGraphNode* CurrentNode = GetScene()->SceneGraph.GetNodeByID(NodeStatePair.first);
-			// Node might be null if it has been deleted but its state has not been cleaned up yet.
-			// FE_FIX_ME: Clean up state of deleted nodes to avoid this situation.
+			// Nodes of other scenes are not found, their selection is kept for when that scene is shown again.
+			FENaiveSceneGraphNode* CurrentNode = FindNodeByID(PreviouslySelectedNodeIDs[i]);
 			if (CurrentNode != nullptr)
 				SetNodeSelectedInternal(CurrentNode, false);
 		}
@@ -287,96 +409,128 @@ void FESceneGraphUI::SetNodeSelected(FENaiveSceneGraphNode* Node, bool bSelected
 	SetNodeSelectedInternal(Node, bSelected);
 }
 
-std::vector<std::string> FESceneGraphUI::GetSelectedNodeIDs() const
+bool FESceneGraphUI::IsMultipleNodeSelectionAllowed() const
 {
-	std::vector<std::string> SelectedNodeIDs;
-	for (const auto& NodeStatePair : NodeState)
-	{
-		if (NodeStatePair.second.bSelected)
-			SelectedNodeIDs.push_back(NodeStatePair.first);
-	}
+	return bAllowMultipleNodeSelection;
+}
 
-	return SelectedNodeIDs;
+void FESceneGraphUI::SetMultipleNodeSelectionAllowed(bool bNewValue)
+{
+	bAllowMultipleNodeSelection = bNewValue;
 }
 
-bool FESceneGraphUI::IsNodePartOfBranch(FENaiveSceneGraphNode* NodeToCheck, FENaiveSceneGraphNode* BranchRoot, FENaiveSceneGraphNode* BranchLeaf)
+std::vector<std::string> FESceneGraphUI::GetSelectedNodeIDs() const
 {
-	if (NodeToCheck == nullptr || BranchRoot == nullptr || BranchLeaf == nullptr)
-		return false;
+	return std::vector<std::string>(SelectedNodeIDSet.begin(), SelectedNodeIDSet.end());
+}
 
-	if (NodeToCheck == BranchRoot || NodeToCheck == BranchLeaf)
-		return true;
+void FESceneGraphUI::DrawTreeConnectorLines(size_t FirstRowIndex, size_t RowCount, float RowPitch)
+{
+	if (RowCount == 0)
+		return;
+
+	const std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	ImDrawList* DrawList = ImGui::GetWindowDrawList();
+	ImColor RegularColor = ImColor(ConnectorLineColor);
+	ImColor HighlightedColor = ImColor(SelectedNodeConnectorLineColor);
+
+	// Offsets are computed in double, otherwise rows far from the top of huge lists would lose precision.
+	float BaseX = ImGui::GetCursorScreenPos().x;
+	double RowsTopY = static_cast<double>(ImGui::GetWindowPos().y) + RowsStartY - ImGui::GetScrollY();
+	auto GetRowTopY = [&](int RowIndex) {
+		return static_cast<float>(RowsTopY + static_cast<double>(RowIndex) * RowPitch);
+	};
 
-	// Walk from BranchLeaf up to BranchRoot.
-	// NodeToCheck is part of the branch only if it lies on this path.
-	FENaiveSceneGraphNode* CurrentNode = BranchLeaf;
-	while (CurrentNode != nullptr)
+	ConnectorRuns.clear();
+	ConnectorRunIndices.clear();
+	for (size_t i = FirstRowIndex; i < FirstRowIndex + RowCount; i++)
 	{
-		if (CurrentNode == NodeToCheck)
-			return true;
+		const FESceneGraphUIRow& Row = Rows[i];
+		if (Row.ParentRowIndex == -1)
+			continue;
 
-		// Stop once we have reached the root of the branch.
-		if (CurrentNode == BranchRoot)
-			break;
+		auto Iterator = ConnectorRunIndices.find(Row.ParentRowIndex);
+		if (Iterator == ConnectorRunIndices.end())
+		{
+			FESceneGraphUIConnectorRun NewRun;
+			NewRun.ParentRowIndex = Row.ParentRowIndex;
+			NewRun.X = BaseX + static_cast<int>((Row.Indentation - 1) * NodeHeight) + NodeHeight / 2.0f;
+			Iterator = ConnectorRunIndices.emplace(Row.ParentRowIndex, ConnectorRuns.size()).first;
+			ConnectorRuns.push_back(NewRun);
+		}
 
-		CurrentNode = CurrentNode->GetParent();
+		FESceneGraphUIConnectorRun& Run = ConnectorRuns[Iterator->second];
+		Run.LastChildRowIndex = static_cast<int>(i);
+		if (bHighlightSelectedNodeConnectorLines && Row.bOnSelectedBranch)
+			Run.LastHighlightedChildRowIndex = static_cast<int>(i);
 	}
 
-	return false;
-}
-
-void FESceneGraphUI::DrawTreeConnectorLines(FENaiveSceneGraphNode* Node, float ParentBottomY)
-{
-	ImColor ConnectorLineColorToUse = ImColor(this->ConnectorLineColor);
-	float ConnectorLineThicknessToUse = ConnectorLineThickness;
-	bool bNeedToHighlightNodeBranch = false;
-	std::vector<std::string> SelectedNodeIDs = GetSelectedNodeIDs();
-	if (bHighlightSelectedNodeConnectorLines && !SelectedNodeIDs.empty())
+	// Regular lines go under rows, highlighted lines are drawn over them in a single pass.
+	DrawList->ChannelsSetCurrent(FE_SCENE_GRAPH_UI_DRAW_CHANNEL_BACKGROUND);
+	for (size_t i = 0; i < ConnectorRuns.size(); i++)
 	{
-		FEScene* CurrentScene = GetScene();
-		for (size_t i = 0; i < SelectedNodeIDs.size(); i++)
-		{
-			if (IsNodePartOfBranch(Node, RenderingRoot, CurrentScene->SceneGraph.GetNodeByID(SelectedNodeIDs[i])))
-			{
-				ConnectorLineColorToUse = SelectedNodeConnectorLineColor;
-				ConnectorLineThicknessToUse = SelectedConnectorLineThickness;
-				bNeedToHighlightNodeBranch = true;
-			}
-		}
+		const FESceneGraphUIConnectorRun& Run = ConnectorRuns[i];
+		float StartY = GetRowTopY(Run.ParentRowIndex) + NodeHeight;
+		DrawList->AddLine(ImVec2(Run.X, StartY), ImVec2(Run.X, GetRowTopY(Run.LastChildRowIndex) + NodeHeight / 2.0f), RegularColor, ConnectorLineThickness);
 	}
-	ImGui::GetWindowDrawList()->ChannelsSetCurrent(bNeedToHighlightNodeBranch ? 1 : 0);
 
-	size_t Depth = Node->GetDepth();
-	Depth -= RenderingRoot->GetDepth() + (bRenderRootItself ? 0 : 1);
+	auto DrawHorizontalLines = [&](bool bHighlighted, ImColor Color, float Thickness) {
+		for (size_t i = FirstRowIndex; i < FirstRowIndex + RowCount; i++)
+		{
+			const FESceneGraphUIRow& Row = Rows[i];
+			if (Row.ParentRowIndex == -1 || (bHighlightSelectedNodeConnectorLines && Row.bOnSelectedBranch) != bHighlighted)
+				continue;
 
-	float BaseX = ImGui::GetCursorScreenPos().x;
+			float ElbowX = ConnectorRuns[ConnectorRunIndices[Row.ParentRowIndex]].X;
+			float ElbowY = GetRowTopY(static_cast<int>(i)) + NodeHeight / 2.0f;
+			DrawList->AddLine(ImVec2(ElbowX, ElbowY), ImVec2(ElbowX + NodeHeight / (Row.bHasVisibleChildren ? 2.0f : 0.7f), ElbowY), Color, Thickness);
+		}
+	};
+	DrawHorizontalLines(false, RegularColor, ConnectorLineThickness);
+
+	if (bHighlightSelectedNodeConnectorLines)
+	{
+		DrawList->ChannelsSetCurrent(FE_SCENE_GRAPH_UI_DRAW_CHANNEL_HIGHLIGHTED_CONNECTOR_LINES);
+		for (size_t i = 0; i < ConnectorRuns.size(); i++)
+		{
+			const FESceneGraphUIConnectorRun& Run = ConnectorRuns[i];
+			if (Run.LastHighlightedChildRowIndex == -1)
+				continue;
 
-	int HorizontalOffset = static_cast<int>((Depth - 1) * NodeHeight);
-	ImVec2 VerticalStart = ImVec2(BaseX + HorizontalOffset + NodeHeight / 2.0f,
-								  ParentBottomY + NodeHeight);
+			float StartY = GetRowTopY(Run.ParentRowIndex) + NodeHeight;
+			DrawList->AddLine(ImVec2(Run.X, StartY), ImVec2(Run.X, GetRowTopY(Run.LastHighlightedChildRowIndex) + NodeHeight / 2.0f), HighlightedColor, SelectedConnectorLineThickness);
+		}
 
-	ImVec2 ElbowPoint = ImVec2(VerticalStart.x,
-							   ImGui::GetCursorScreenPos().y + NodeHeight / 2.0f);
+		DrawHorizontalLines(true, HighlightedColor, SelectedConnectorLineThickness);
+	}
 
-	ImGui::GetWindowDrawList()->AddLine(VerticalStart, ElbowPoint, ImColor(ConnectorLineColorToUse), ConnectorLineThicknessToUse);
+	DrawList->ChannelsSetCurrent(FE_SCENE_GRAPH_UI_DRAW_CHANNEL_DEFAULT);
+}
 
-	bool bHasChildren = AreNodeChildrenVisible(Node);
-	ImVec2 HorizontalEnd = ImVec2(ElbowPoint.x + NodeHeight / (bHasChildren ? 2.0f : 0.7f),
-		                          ElbowPoint.y);
+void FESceneGraphUI::FlushRowBackgroundBatch()
+{
+	if (RowBackgroundBatch.empty())
+		return;
 
-	ImGui::GetWindowDrawList()->AddLine(ElbowPoint, HorizontalEnd, ImColor(ConnectorLineColorToUse), ConnectorLineThicknessToUse);
+	ImDrawList* DrawList = ImGui::GetWindowDrawList();
+	DrawList->ChannelsSetCurrent(FE_SCENE_GRAPH_UI_DRAW_CHANNEL_BACKGROUND);
+	// One reservation for all rectangles, instead of AddRectFilled for each row.
+	int RectangleCount = static_cast<int>(RowBackgroundBatch.size());
+	DrawList->PrimReserve(RectangleCount * 6, RectangleCount * 4);
+	for (size_t i = 0; i < RowBackgroundBatch.size(); i++)
+		DrawList->PrimRect(RowBackgroundBatch[i].Min, RowBackgroundBatch[i].Max, RowBackgroundBatch[i].Color);
 
-	if (bNeedToHighlightNodeBranch)
-		ImGui::GetWindowDrawList()->ChannelsSetCurrent(0);
+	DrawList->ChannelsSetCurrent(FE_SCENE_GRAPH_UI_DRAW_CHANNEL_DEFAULT);
+	RowBackgroundBatch.clear();
 }
 
-void FESceneGraphUI::DrawAppropriateTreeArrow(FENaiveSceneGraphNode* Node)
+void FESceneGraphUI::DrawAppropriateTreeArrow(const FESceneGraphUIRow& Row)
 {
 	float ArrowRegionWidth = FontSize;
 	ImVec2 ArrowCursorPos = ImGui::GetCursorScreenPos();
 
-	bool bNodeExpanded = IsNodeExpanded(Node);
-	bool bHasChildren = AreNodeChildrenVisible(Node);
+	bool bNodeExpanded = Row.bExpanded;
+	bool bHasChildren = Row.bHasVisibleChildren;
 
 	if (bHasChildren)
 	{
@@ -411,9 +565,19 @@ void FESceneGraphUI::DrawAppropriateTreeArrow(FENaiveSceneGraphNode* Node)
 		}
 
 		// Occupy the space in ImGui layout.
-		ImGui::InvisibleButton(("##Arrow" + Node->GetObjectID()).c_str(), ImVec2(ArrowRegionWidth, NodeHeight));
+		ImGui::InvisibleButton(("##Arrow" + Row.NodeID + Row.GroupKey).c_str(), ImVec2(ArrowRegionWidth, NodeHeight));
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_STRING_BUILDS, 1);
 		if (ImGui::IsItemClicked())
-			SetNodeExpanded(Node, !bNodeExpanded);
+		{
+			if (Row.Type == FE_SCENE_GRAPH_UI_ROW_SIBLING_GROUP)
+			{
+				SetSiblingGroupExpanded(Row.Node, Row.GroupKey, !bNodeExpanded);
+			}
+			else
+			{
+				SetNodeExpanded(Row.Node, !bNodeExpanded);
+			}
+		}
 	}
 	else
 	{
@@ -432,58 +596,86 @@ void FESceneGraphUI::CheckInputs(FENaiveSceneGraphNode* Node)
 	{
 		HoveredNodeID = Node->GetObjectID();
 
-		for (auto& Callback : OnNodeHoveredCallbacks)
-			Callback(Node);
+		for (auto& Registration : OnNodeHoveredCallbacks)
+		{
+			FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, Registration.Name.c_str());
+			Registration.Function(Node);
+		}
 
 		if (ImGui::IsItemClicked(ImGuiMouseButton_Left))
 		{
-			SetNodeSelected(Node, !IsNodeSelected(Node));
+			if (bNodeDragAndDropEnabled && IsNodeSelected(Node))
+			{
+				NodeIDToDeselectOnRelease = Node->GetObjectID();
+			}
+			else
+			{
+				SetNodeSelected(Node, !IsNodeSelected(Node));
+			}
 
-			for (auto& Callback : OnNodeClickedCallbacks)
-				Callback(Node, ImGuiMouseButton_Left);
+			for (auto& Registration : OnNodeClickedCallbacks)
+			{
+				FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, Registration.Name.c_str());
+				Registration.Function(Node, ImGuiMouseButton_Left);
+			}
 		}
 
 		if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
 		{
-			for (auto& Callback : OnNodeClickedCallbacks)
-				Callback(Node, ImGuiMouseButton_Right);
+			for (auto& Registration : OnNodeClickedCallbacks)
+			{
+				FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, Registration.Name.c_str());
+				Registration.Function(Node, ImGuiMouseButton_Right);
+			}
 		}
 
 		if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
 		{
-			for (auto& Callback : OnNodeClickedCallbacks)
-				Callback(Node, ImGuiMouseButton_Middle);
+			for (auto& Registration : OnNodeClickedCallbacks)
+			{
+				FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, Registration.Name.c_str());
+				Registration.Function(Node, ImGuiMouseButton_Middle);
+			}
 		}
 
 		if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
 		{
-			for (auto& Callback : OnNodeDoubleClickedCallbacks)
-				Callback(Node, ImGuiMouseButton_Left);
+			for (auto& Registration : OnNodeDoubleClickedCallbacks)
+			{
+				FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, Registration.Name.c_str());
+				Registration.Function(Node, ImGuiMouseButton_Left);
+			}
 		}
 
 		if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Right))
 		{
-			for (auto& Callback : OnNodeDoubleClickedCallbacks)
-				Callback(Node, ImGuiMouseButton_Right);
+			for (auto& Registration : OnNodeDoubleClickedCallbacks)
+			{
+				FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, Registration.Name.c_str());
+				Registration.Function(Node, ImGuiMouseButton_Right);
+			}
 		}
 
 		if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Middle))
 		{
-			for (auto& Callback : OnNodeDoubleClickedCallbacks)
-				Callback(Node, ImGuiMouseButton_Middle);
+			for (auto& Registration : OnNodeDoubleClickedCallbacks)
+			{
+				FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, Registration.Name.c_str());
+				Registration.Function(Node, ImGuiMouseButton_Middle);
+			}
 		}
 	}
 }
 
-void FESceneGraphUI::AddOnNodeClickedCallback(std::function<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)> Callback)
+void FESceneGraphUI::AddOnNodeClickedCallback(std::function<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)> Callback, const std::string& Name)
 {
 	for (size_t i = 0; i < OnNodeClickedCallbacks.size(); i++)
 	{
-		if (OnNodeClickedCallbacks[i].target_type() == Callback.target_type())
+		if (OnNodeClickedCallbacks[i].Function.target_type() == Callback.target_type())
 			return;
 	}
 
-	OnNodeClickedCallbacks.push_back(Callback);
+	OnNodeClickedCallbacks.push_back({ GetCallbackRegistrationName("OnNodeClicked", Name), Callback });
 }
 
 void FESceneGraphUI::ClearOnNodeClickedCallbacks()
@@ -491,15 +683,15 @@ void FESceneGraphUI::ClearOnNodeClickedCallbacks()
 	OnNodeClickedCallbacks.clear();
 }
 
-void FESceneGraphUI::AddOnNodeDoubleClickedCallback(std::function<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)> Callback)
+void FESceneGraphUI::AddOnNodeDoubleClickedCallback(std::function<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)> Callback, const std::string& Name)
 {
 	for (size_t i = 0; i < OnNodeDoubleClickedCallbacks.size(); i++)
 	{
-		if (OnNodeDoubleClickedCallbacks[i].target_type() == Callback.target_type())
+		if (OnNodeDoubleClickedCallbacks[i].Function.target_type() == Callback.target_type())
 			return;
 	}
 
-	OnNodeDoubleClickedCallbacks.push_back(Callback);
+	OnNodeDoubleClickedCallbacks.push_back({ GetCallbackRegistrationName("OnNodeDoubleClicked", Name), Callback });
 }
 
 void FESceneGraphUI::ClearOnNodeDoubleClickedCallbacks()
@@ -507,15 +699,15 @@ void FESceneGraphUI::ClearOnNodeDoubleClickedCallbacks()
 	OnNodeDoubleClickedCallbacks.clear();
 }
 
-void FESceneGraphUI::AddOnNodeSelectionChangedCallback(std::function<void(FENaiveSceneGraphNode*, bool)> Callback)
+void FESceneGraphUI::AddOnNodeSelectionChangedCallback(std::function<void(FENaiveSceneGraphNode*, bool)> Callback, const std::string& Name)
 {
 	for (size_t i = 0; i < OnNodeSelectionChangedCallbacks.size(); i++)
 	{
-		if (OnNodeSelectionChangedCallbacks[i].target_type() == Callback.target_type())
+		if (OnNodeSelectionChangedCallbacks[i].Function.target_type() == Callback.target_type())
 			return;
 	}
 
-	OnNodeSelectionChangedCallbacks.push_back(Callback);
+	OnNodeSelectionChangedCallbacks.push_back({ GetCallbackRegistrationName("OnNodeSelectionChanged", Name), Callback });
 }
 
 void FESceneGraphUI::ClearOnNodeSelectionChangedCallbacks()
@@ -551,15 +743,15 @@ void FESceneGraphUI::ClearAllCallbacks()
 	ClearContextMenuRenderingFunction();
 }
 
-void FESceneGraphUI::AddOnNodeHoveredCallback(std::function<void(FENaiveSceneGraphNode*)> Callback)
+void FESceneGraphUI::AddOnNodeHoveredCallback(std::function<void(FENaiveSceneGraphNode*)> Callback, const std::string& Name)
 {
 	for (size_t i = 0; i < OnNodeHoveredCallbacks.size(); i++)
 	{
-		if (OnNodeHoveredCallbacks[i].target_type() == Callback.target_type())
+		if (OnNodeHoveredCallbacks[i].Function.target_type() == Callback.target_type())
 			return;
 	}
 
-	OnNodeHoveredCallbacks.push_back(Callback);
+	OnNodeHoveredCallbacks.push_back({ GetCallbackRegistrationName("OnNodeHovered", Name), Callback });
 }
 
 void FESceneGraphUI::ClearOnNodeHoveredCallbacks()
@@ -569,6 +761,9 @@ void FESceneGraphUI::ClearOnNodeHoveredCallbacks()
 
 FESceneGraphNodeWidget* FESceneGraphUI::GetNodeWidgetByID(const std::string& WidgetID)
 {
+	// Caller could modify returned widget.
+	MarkRowsDirty();
+
 	for (size_t i = 0; i < NodeWidgets.size(); i++)
 	{
 		if (NodeWidgets[i].GetID() == WidgetID)
@@ -592,6 +787,8 @@ bool FESceneGraphUI::AddNodeWidget(FESceneGraphNodeWidget& Widget)
 	}
 
 	NodeWidgets.push_back(Widget);
+	NodeWidgetsGeneration++;
+	MarkRowsDirty();
 	return true;
 }
 
@@ -602,6 +799,8 @@ bool FESceneGraphUI::RemoveNodeWidget(const std::string& WidgetID)
 		if (NodeWidgets[i].GetID() == WidgetID)
 		{
 			NodeWidgets.erase(NodeWidgets.begin() + i);
+			NodeWidgetsGeneration++;
+			MarkRowsDirty();
 			return true;
 		}
 	}
@@ -613,13 +812,18 @@ void FESceneGraphUI::ClearNodeWidgets()
 {
 	NodeWidgets.clear();
 	DebugNodeWidgets.clear();
+	NodeWidgetsGeneration++;
+	MarkRowsDirty();
 }
 
 bool FESceneGraphUI::ShouldRenderWidgetForNode(FENaiveSceneGraphNode* Node, FESceneGraphNodeWidget& Widget, FETexture** IconToUse)
 {
 	bool bVisible = Widget.bIsVisibleByDefault;
 	if (Widget.IsVisiblePredicate != nullptr)
+	{
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_PREDICATE_CALLS, 1);
 		bVisible = Widget.IsVisiblePredicate(Node);
+	}
 
 	if (!bVisible)
 		return false;
@@ -627,6 +831,7 @@ bool FESceneGraphUI::ShouldRenderWidgetForNode(FENaiveSceneGraphNode* Node, FESc
 	FETexture* ResultingIcon = Widget.Icon;
 	if (Widget.DynamicIconProvider != nullptr)
 	{
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_PROVIDER_CALLS, 1);
 		FETexture* ProviderIcon = Widget.DynamicIconProvider(Node);
 		if (ProviderIcon != nullptr)
 			ResultingIcon = ProviderIcon;
@@ -640,46 +845,32 @@ bool FESceneGraphUI::ShouldRenderWidgetForNode(FENaiveSceneGraphNode* Node, FESc
 	return true;
 }
 
-float FESceneGraphUI::GetNodeWidgetAreaWidth(FENaiveSceneGraphNode* Node)
+float FESceneGraphUI::GetNodeWidgetAreaWidth(size_t VisibleWidgetCount)
 {
 	float IconSpacing = GetFontSize() * 0.15f;
 
-	int VisibleWidgets = static_cast<int>(GetNodeWidgetCount(Node));
+	int VisibleWidgets = static_cast<int>(VisibleWidgetCount);
 	float SpaceNeededForIconsAtEnd = IconsSize.x * WidgetIconVisualRenderingFactor * VisibleWidgets + IconSpacing * std::max(0, VisibleWidgets - 1);
 	return SpaceNeededForIconsAtEnd + ImGui::GetStyle().WindowPadding.x + 6.0f;
 }
 
-size_t FESceneGraphUI::GetNodeWidgetCount(FENaiveSceneGraphNode* Node)
-{
-	int VisibleWidgets = 0;
-	for (size_t i = 0; i < NodeWidgets.size(); i++)
-	{
-		FESceneGraphNodeWidget& Widget = NodeWidgets[i];
-
-		if (!ShouldRenderWidgetForNode(Node, Widget, nullptr))
-			continue;
-
-		VisibleWidgets++;
-	}
-
-	return VisibleWidgets;
-}
-
-void FESceneGraphUI::RenderNodeWidgets(FENaiveSceneGraphNode* Node)
+void FESceneGraphUI::RenderNodeWidgets(const FESceneGraphUIRow& Row)
 {
+	FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, "RenderNodeWidgets");
 	YCursorPositionBeforeRenderingWidgets = ImGui::GetCursorPosY();
 	float IconSpacing = GetFontSize() * 0.15f;
 
-	size_t VisibleWidgetCount = GetNodeWidgetCount(Node);
+	// If widgets were added or removed during this frame (e.g. by a click callback),
+	// remaining rows are drawn without widgets until rows are rebuilt on the next frame.
 	size_t WidgetIndex = 0;
-	for (size_t i = 0; i < NodeWidgets.size(); i++)
+	for (size_t i = 0; i < Row.Widgets.size() && RowsNodeWidgetsGeneration == NodeWidgetsGeneration; i++)
 	{
-		FESceneGraphNodeWidget& Widget = NodeWidgets[i];
-
-		FETexture* IconToUse = nullptr;
-		if (!ShouldRenderWidgetForNode(Node, Widget, &IconToUse))
+		if (Row.Widgets[i].WidgetIndex >= NodeWidgets.size())
 			continue;
 
+		FESceneGraphNodeWidget& Widget = NodeWidgets[Row.Widgets[i].WidgetIndex];
+		FETexture* IconToUse = Row.Widgets[i].Icon;
+
 		// We change item spacing only for the widgets that are not the first one.
 		if (WidgetIndex == 1)
 			ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(IconSpacing, 0));
@@ -695,29 +886,43 @@ void FESceneGraphUI::RenderNodeWidgets(FENaiveSceneGraphNode* Node)
 			ImGui::PushStyleColor(ImGuiCol_ButtonHovered, Widget.HoveredColor);
 			ImGui::PushStyleColor(ImGuiCol_ButtonActive, Widget.ActiveColor);
 
-			std::string ButtonID = "##" + Widget.ID + "_" + Node->GetObjectID();
-			if (ImGui::ImageButton(ButtonID.c_str(), IconToUse->GetTextureID(), IconsSize * WidgetIconVisualRenderingFactor))
+			bool bWidgetsChanged = false;
+			std::string ButtonID = "##" + Widget.ID + "_" + Row.NodeID;
+			FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_STRING_BUILDS, 1);
+			ImTextureID TextureID;
+			ImVec2 UV0, UV1;
+			GetIconDrawData(IconToUse, TextureID, UV0, UV1);
+			if (ImGui::ImageButton(ButtonID.c_str(), TextureID, IconsSize * WidgetIconVisualRenderingFactor, UV0, UV1))
 			{
-				std::string NodeID = Node->GetObjectID();
+				// Callback should use Queue* functions to modify the scene graph, so node stays valid during traversal.
 				if (Widget.OnClickCallback != nullptr)
-					Widget.OnClickCallback(Node);
-
-				// After these callbacks, the node might not be valid anymore (e.g. it could be removed in the callback).
-				FENaiveSceneGraphNode* NodeAfterCallbacks = GetScene()->SceneGraph.GetNodeByID(NodeID);
-				if (NodeAfterCallbacks == nullptr)
 				{
-					ImGui::PopStyleVar();
-					ImGui::PopStyleColor(3);
-					break;
+					// Span name is built only when somebody receives it.
+					FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, TraceSink == nullptr ? nullptr : ("Widget " + Widget.ID).c_str());
+					Widget.OnClickCallback(Row.Node);
 				}
+
+				// Widget icon or visibility usually depends on the state that callback has just changed.
+				MarkRowsDirty();
+				// Callback could add or remove widgets, then Widget could be a dangling reference.
+				bWidgetsChanged = RowsNodeWidgetsGeneration != NodeWidgetsGeneration;
 			}
 
 			ImGui::PopStyleVar();
 			ImGui::PopStyleColor(3);
+
+			if (bWidgetsChanged)
+			{
+				WidgetIndex++;
+				break;
+			}
 		}
 		else
 		{
-			ImGui::Image(IconToUse->GetTextureID(), IconsSize * WidgetIconVisualRenderingFactor);
+			ImTextureID TextureID;
+			ImVec2 UV0, UV1;
+			GetIconDrawData(IconToUse, TextureID, UV0, UV1);
+			ImGui::Image(TextureID, IconsSize * WidgetIconVisualRenderingFactor, UV0, UV1);
 		}
 
 		if (ImGui::IsItemHovered() && !Widget.TooltipText.empty())
@@ -748,401 +953,2475 @@ void FESceneGraphUI::RenderNodeWidgets(FENaiveSceneGraphNode* Node)
 		ImGui::SetCursorPosY(YCursorPositionBeforeRenderingWidgets);
 }
 
-void FESceneGraphUI::RenderNode(FENaiveSceneGraphNode* Node)
+void FESceneGraphUI::MarkRowsDirty()
 {
-	if (!ShouldNodeBeVisible(Node))
+	bRowsDirty = true;
+	RowsGeneration++;
+}
+
+void FESceneGraphUI::MarkRowSubtreeDirty(FENaiveSceneGraphNode* Node)
+{
+	// Stored rows of other rendering roots are not updated, so they should not be reused.
+	RowsGeneration++;
+	if (bBuildingRows || ShouldRebuildRows())
+	{
+		MarkRowsDirty();
+		return;
+	}
+
+	// Children of rendering root that is not rendered itself are top level rows.
+	if (Node == RowModel.RenderingRoot && !RowModel.bRenderRootItself)
+	{
+		MarkRowsDirty();
 		return;
+	}
 
-	DrawAppropriateTreeArrow(Node);
+	if (RowModel.FindRowIndex(Node->GetObjectID()) != -1)
+		PendingRowSubtreeNodeIDs.push_back(Node->GetObjectID());
+}
 
-	FETexture* BeforeNodeIcon = GetNodeIcon(Node);
-	if (BeforeNodeIcon != nullptr)
+void FESceneGraphUI::MarkRowSelectionDirty(FENaiveSceneGraphNode* Node)
+{
+	RowsGeneration++;
+	// Selection predicate is evaluated only while rows are built.
+	if (bBuildingRows || ShouldRebuildRows() || NodeSelectionPredicate != nullptr)
 	{
-		ImGui::Image(BeforeNodeIcon->GetTextureID(), IconsSize);
-		ImGui::SameLine();
+		MarkRowsDirty();
+		return;
 	}
 
-	float IconSpacing = GetFontSize() * 0.15f;
-	float SpaceNeededForWidgetAtEnd = GetNodeWidgetAreaWidth(Node);
-	float NodeBodyWidth = ImGui::GetContentRegionAvail().x - SpaceNeededForWidgetAtEnd - IconSpacing;
+	PendingSelectionRowNodeIDs.insert(Node->GetObjectID());
+}
 
-	std::string DisplayedName = GetNodeDisplayName(Node);
-	std::string DisplayedText = APPLICATION.TruncateText(DisplayedName, NodeBodyWidth) + "##" + Node->GetObjectID();
+bool FESceneGraphUI::HasPendingRowUpdates() const
+{
+	return !PendingRowSubtreeNodeIDs.empty() || !PendingSelectionRowNodeIDs.empty();
+}
 
-	if (bAlternatingNodeBackground)
+void FESceneGraphUI::ApplyPendingRowUpdates()
+{
+	if (!HasPendingRowUpdates())
+		return;
+
+	if (PendingRowSubtreeNodeIDs.size() > MaxRowSubtreeUpdatesPerFrame)
 	{
-		bLastNodeWasEven = !bLastNodeWasEven;
-		ImVec2 RectMin = ImGui::GetCursorScreenPos();
-		ImVec2 RectMax = ImVec2(RectMin.x + NodeBodyWidth, RectMin.y + NodeHeight);
-		ImGui::GetWindowDrawList()->AddRectFilled(RectMin, RectMax, bLastNodeWasEven ? ImColor(EvenNodeBackgroundColor) : ImColor(OddNodeBackgroundColor));
+		RebuildRows();
+		return;
 	}
 
-	for (size_t i = 0; i < BeforeNodeRenderCallbacks.size(); i++)
-		BeforeNodeRenderCallbacks[i](Node);
-	
-	bool bIsSelected = IsNodeSelected(Node);
-	if (NodeIDBeingRenamed == Node->GetObjectID())
+	FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, "UpdateRows");
+	FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_ROW_REBUILD);
+	RowModel.VisitedNodeCount = 0;
+
+	// Minimap gets marks of changed rows only while other rows keep their places.
+	bool bMinimapInSync = Minimap.IsBuiltFrom(RowModel);
+
+	// Marks made while rows are updated (e.g. by widget callbacks) are applied on the next frame.
+	std::vector<std::string> SubtreeNodeIDs;
+	SubtreeNodeIDs.swap(PendingRowSubtreeNodeIDs);
+	for (size_t i = 0; i < SubtreeNodeIDs.size(); i++)
 	{
-		if (!bLastFrameRenameEditWasVisible)
+		// Row could be removed or moved by the previous subtree update.
+		int RowIndex = RowModel.FindRowIndex(SubtreeNodeIDs[i]);
+		if (RowIndex != -1)
 		{
-			ImGui::SetKeyboardFocusHere(0);
-
-			ImGuiContext* Context = ImGui::GetCurrentContext();
-			if (Context != nullptr)
-				ImGui::SetFocusID(ImGui::GetID("##SceneGraphRenameEditor"), Context->CurrentWindow);
-			
-			ImGui::SetItemDefaultFocus();
-			bLastFrameRenameEditWasVisible = true;
+			RebuildRowSubtree(static_cast<size_t>(RowIndex));
+			bMinimapInSync = false;
 		}
+	}
 
-		ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.2f, 0.2f, 0.3f, 1.0f));
-		ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(0.4f, 0.6f, 1.0f, 1.0f));
-		ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1.5f);
-		ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 2.0f);
+	std::unordered_set<std::string> SelectionNodeIDs;
+	SelectionNodeIDs.swap(PendingSelectionRowNodeIDs);
+	for (const std::string& NodeID : SelectionNodeIDs)
+	{
+		int RowIndex = RowModel.FindRowIndex(NodeID);
+		if (RowIndex == -1)
+			continue;
 
-		ImGui::SetNextItemWidth(NodeBodyWidth);
-		if (ImGui::InputText("##SceneGraphRenameEditor", RenameBuffer, IM_ARRAYSIZE(RenameBuffer), ImGuiInputTextFlags_EnterReturnsTrue) ||
-			ImGui::IsMouseClicked(0) && !ImGui::IsItemHovered() || !ImGui::IsItemFocused())
+		FESceneGraphUIRow& Row = RowModel.Rows[RowIndex];
+		Row.bSelected = NodeState[NodeID].bSelected;
+		// Widget visibility could depend on selection.
+		EvaluateRowWidgets(Row);
+
+		if (bMinimapInSync)
 		{
-			FEEntity* ObjectToRename = Node->GetEntity();
-			if (ObjectToRename != nullptr)
-				ObjectToRename->SetName(RenameBuffer);
-			
-			NodeIDBeingRenamed = "";
+			Minimap.SetMark(RowIndex, FE_SCENE_GRAPH_MINIMAP_MARK_SELECTION, Row.bSelected);
+			Minimap.SetMark(RowIndex, FE_SCENE_GRAPH_MINIMAP_MARK_ALERT, IsRowAlerted(Row));
 		}
-
-		ImGui::PopStyleVar(2);
-		ImGui::PopStyleColor(2);
 	}
-	else
+
+	UpdateSelectedBranchRows();
+	RowModel.Version++;
+	if (bMinimapInSync)
+		Minimap.SetRowModelVersion(RowModel);
+	ResolveFocusedRowIndex();
+}
+
+void FESceneGraphUI::RebuildRowSubtree(size_t RowIndex)
+{
+	std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	const size_t OldRowCount = Rows.size();
+	const size_t Indentation = Rows[RowIndex].Indentation;
+
+	// Rows are in depth-first order, so subtree ends at the first row that is not indented deeper.
+	size_t EndRowIndex = RowIndex + 1;
+	while (EndRowIndex < OldRowCount && Rows[EndRowIndex].Indentation > Indentation)
+		EndRowIndex++;
+
+	for (size_t i = RowIndex + 1; i < EndRowIndex; i++)
 	{
-		ImGui::Selectable(DisplayedText.c_str(), bIsSelected, ImGuiSelectableFlags_None, ImVec2(NodeBodyWidth, NodeHeight));
+		if (Rows[i].Type == FE_SCENE_GRAPH_UI_ROW_NODE)
+			RowModel.NodeRowIndices.erase(Rows[i].NodeID);
 	}
 
-	for (size_t i = 0; i < AfterNodeRenderCallbacks.size(); i++)
-		AfterNodeRenderCallbacks[i](Node);
+	std::vector<FESceneGraphUIRow> TailRows(std::make_move_iterator(Rows.begin() + EndRowIndex), std::make_move_iterator(Rows.end()));
+	Rows.erase(Rows.begin() + RowIndex + 1, Rows.end());
+
+	FENaiveSceneGraphNode* Node = Rows[RowIndex].Node;
+	Rows[RowIndex].bExpanded = IsNodeExpanded(Node);
+	std::vector<FESceneGraphUIRowBuildEntry> Stack;
+	if (Rows[RowIndex].bExpanded)
+		PushChildRowBuildEntries(Node, static_cast<int>(RowIndex), Indentation, Stack);
+	AppendRows(Stack);
+
+	// Following rows have parents either before the subtree or after it.
+	const size_t NewEndRowIndex = Rows.size();
+	const int Shift = static_cast<int>(NewEndRowIndex) - static_cast<int>(EndRowIndex);
+	Rows.reserve(NewEndRowIndex + TailRows.size());
+	for (size_t i = 0; i < TailRows.size(); i++)
+	{
+		if (TailRows[i].ParentRowIndex > static_cast<int>(RowIndex))
+			TailRows[i].ParentRowIndex += Shift;
 
-	CheckInputs(Node);
-	std::string NodeID = Node->GetObjectID();
-	RenderNodeWidgets(Node);
+		if (TailRows[i].Type == FE_SCENE_GRAPH_UI_ROW_NODE)
+			RowModel.NodeRowIndices[TailRows[i].NodeID] = Rows.size();
+		Rows.push_back(std::move(TailRows[i]));
+	}
 
-	// After RenderNodeWidgets, the node might not be valid anymore (e.g. it could be removed in widget callback).
-	FENaiveSceneGraphNode* NodeAfterCallbacks = GetScene()->SceneGraph.GetNodeByID(NodeID);
-	if (NodeAfterCallbacks == nullptr)
-		return;
+	// Truncated text of shifted rows is still valid.
+	if (RowTextCache.size() == OldRowCount)
+	{
+		RowTextCache.erase(RowTextCache.begin() + RowIndex + 1, RowTextCache.begin() + EndRowIndex);
+		RowTextCache.insert(RowTextCache.begin() + RowIndex + 1, NewEndRowIndex - RowIndex - 1, FESceneGraphUIRowTextCache());
+	}
+	else
+	{
+		RowTextCache.assign(Rows.size(), FESceneGraphUIRowTextCache());
+	}
+}
 
-	if (IsNodeExpanded(Node))
+void FESceneGraphUI::EvaluateRowWidgets(FESceneGraphUIRow& Row)
+{
+	FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_WIDGET_EVALUATION);
+	Row.Widgets.clear();
+	for (size_t i = 0; i < NodeWidgets.size(); i++)
 	{
-		std::vector<FENaiveSceneGraphNode*> Children = Node->GetChildren();
-		float ParentBottomY = ImGui::GetItemRectMin().y;
-		for (size_t i = 0; i < Children.size(); i++)
-		{
-			if (ShouldNodeBeVisible(Children[i]))
-			{
-				DrawTreeConnectorLines(Children[i], ParentBottomY);
-				ImGui::SetCursorPosX(ImGui::GetCursorPosX() + (Children[i]->GetDepth() - RenderingRoot->GetDepth() - (bRenderRootItself ? 0 : 1)) * NodeHeight);
-				RenderNode(Children[i]);
-			}
-		}
+		FETexture* IconToUse = nullptr;
+		if (ShouldRenderWidgetForNode(Row.Node, NodeWidgets[i], &IconToUse))
+			Row.Widgets.push_back({ i, IconToUse });
 	}
 }
 
-float FESceneGraphUI::GetFontSize() const
+void FESceneGraphUI::InvalidateCachedRows()
 {
-	return FontSize;
+	// Group membership depends on display names and tags, they could come from the same external state.
+	ClearSiblingGroupCaches();
 }
 
-void FESceneGraphUI::SetFontSize(float NewFontSize)
+bool FESceneGraphUI::IsRowCachingEnabled() const
 {
-	FontSize = NewFontSize;
-	TooltipFontSize = std::max(FontSize / 2.0f, 16.0f);
-	NodeHeight = FontSize;
-	IconsSize = ImVec2(FontSize, FontSize);
+	return bRowCachingEnabled;
 }
 
-void FESceneGraphUI::DebugCreateRandomWidgets(bool bInteractive)
+void FESceneGraphUI::SetRowCachingEnabled(bool bNewValue)
 {
-	FETexture* RandomIcon = GetRandomDebugIcon();
-	FESceneGraphNodeWidget NewDebugWidget;
-	NewDebugWidget.Icon = RandomIcon;
-	NewDebugWidget.bIsInteractive = bInteractive;
+	bRowCachingEnabled = bNewValue;
+	MarkRowsDirty();
+}
 
-	NewDebugWidget.IsVisiblePredicate = [WidgetID = NewDebugWidget.GetID()](FENaiveSceneGraphNode* Node) -> bool {
-		FEEntity* CurrentEntity = Node->GetEntity();
-		if (CurrentEntity == nullptr)
-			return true;
+bool FESceneGraphUI::IsSceneChangeJournalComplete() const
+{
+	return bSceneChangeJournalComplete;
+}
 
-		size_t Seed = std::hash<std::string>{}(CurrentEntity->GetObjectID() + WidgetID);
-		srand(static_cast<unsigned int>(Seed));
+void FESceneGraphUI::SetSceneChangeJournalComplete(bool bNewValue)
+{
+	bSceneChangeJournalComplete = bNewValue;
+	MarkRowsDirty();
+}
 
-		float RandomValue = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-		if (RandomValue < 0.6f)
-			return true;
-		else
-			return false;
-	};
+bool FESceneGraphUI::CanReuseRows() const
+{
+	return bRowCachingEnabled && bSceneChangeJournalComplete;
+}
 
-	bool AlreadyExistingWidgetWithSameProperties = false;
-	for (size_t i = 0; i < DebugNodeWidgets.size(); i++)
+bool FESceneGraphUI::ShouldRebuildRows() const
+{
+	if (!CanReuseRows() || bRowsDirty)
+		return true;
+
+	return RowModel.RenderingRoot != RenderingRoot || RowModel.bRenderRootItself != bRenderRootItself;
+}
+
+void FESceneGraphUI::RebuildRows()
+{
+	FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, "Traverse");
+	FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_ROW_REBUILD);
+	std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	Rows.clear();
+	RowModel.NodeRowIndices.clear();
+	RowModel.RenderingRoot = RenderingRoot;
+	RowModel.bRenderRootItself = bRenderRootItself;
+	RowModel.Version++;
+	RowModel.VisitedNodeCount = 0;
+	RowsNodeWidgetsGeneration = NodeWidgetsGeneration;
+	RowTextCache.clear();
+	PendingRowSubtreeNodeIDs.clear();
+	PendingSelectionRowNodeIDs.clear();
+	// Cleared before evaluation, because selection predicate could change state while rows are built.
+	bRowsDirty = false;
+
+	if (RenderingRoot == nullptr)
+		return;
+
+	// Explicit stack instead of recursion, so very deep hierarchies can not overflow call stack.
+	// Children are pushed in reverse order to keep depth-first order of the tree.
+	std::vector<FESceneGraphUIRowBuildEntry> Stack;
+	if (bRenderRootItself)
 	{
-		if (DebugNodeWidgets[i].Icon->GetObjectID() == NewDebugWidget.Icon->GetObjectID() && DebugNodeWidgets[i].bIsInteractive == NewDebugWidget.bIsInteractive)
-			AlreadyExistingWidgetWithSameProperties = true;
+		Stack.push_back({ RenderingRoot, -1, 0 });
 	}
-
-	if (!AlreadyExistingWidgetWithSameProperties)
+	else
 	{
-		AddNodeWidget(NewDebugWidget);
-		DebugNodeWidgets.push_back(NewDebugWidget);
+		std::vector<FENaiveSceneGraphNode*> Children = GetOrderedChildren(RenderingRoot);
+		for (size_t i = Children.size(); i > 0; i--)
+			Stack.push_back({ Children[i - 1], -1, 0 });
 	}
+
+	AppendRows(Stack);
+	UpdateSelectedBranchRows();
+
+	RowTextCache.resize(Rows.size());
+	ResolveFocusedRowIndex();
 }
 
-void FESceneGraphUI::DebugRenderUI()
+void FESceneGraphUI::AppendRows(std::vector<FESceneGraphUIRowBuildEntry>& Stack)
 {
-	if (ImGui::Button("Expand all"))
-		ExpandAllNodes();
-	
-	if (ImGui::Button("Collapse all"))
-		CollapseAllNodes();
+	std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	// Predicates could change panel state while rows are built, such changes should not modify rows in place.
+	bBuildingRows = true;
+	while (!Stack.empty())
+	{
+		FESceneGraphUIRowBuildEntry Entry = Stack.back();
+		Stack.pop_back();
 
-	ImGui::Checkbox("Render root", &bDebugRenderRoot);
+		if (Entry.bMoreChildren)
+		{
+			FESceneGraphUIRow MoreChildrenRow;
+			MoreChildrenRow.Type = FE_SCENE_GRAPH_UI_ROW_MORE_CHILDREN;
+			MoreChildrenRow.Node = Entry.Node;
+			MoreChildrenRow.NodeID = Entry.Node->GetObjectID();
+			MoreChildrenRow.ParentRowIndex = Entry.ParentRowIndex;
+			MoreChildrenRow.Indentation = Entry.Indentation;
+			MoreChildrenRow.LoadedChildCount = Entry.LoadedChildCount;
+			MoreChildrenRow.TotalChildCount = Entry.TotalChildCount;
+			Rows.push_back(std::move(MoreChildrenRow));
+			continue;
+		}
 
-	ImGui::Checkbox("Render random icons", &bDebugRenderRandomNodeIcons);
-		
-	if (bDebugRenderRandomNodeIcons)
-	{
-		SetNodeIconProvider([this] (FENaiveSceneGraphNode* Node) -> FETexture* {
-			FEEntity* CurrentEntity = Node->GetEntity();
-			if (CurrentEntity == nullptr)
-				return nullptr;
+		if (Entry.Group != nullptr)
+		{
+			if (!IsAnySiblingGroupMemberVisible(*Entry.Group))
+				continue;
 
-			// More elegant solution without rand().
-			size_t Hash = std::hash<std::string>{}(CurrentEntity->GetObjectID());
-			size_t IconCount = DebugIconsIDs.size();
-			if (IconCount == 0)
-				return nullptr;
+			FESceneGraphUIRow GroupRow;
+			GroupRow.Type = FE_SCENE_GRAPH_UI_ROW_SIBLING_GROUP;
+			GroupRow.Node = Entry.Node;
+			GroupRow.NodeID = Entry.Node->GetObjectID();
+			GroupRow.GroupKey = Entry.Group->Key;
+			GroupRow.ParentRowIndex = Entry.ParentRowIndex;
+			GroupRow.Indentation = Entry.Indentation;
+			GroupRow.bHasVisibleChildren = true;
+			GroupRow.bExpanded = IsSiblingGroupExpanded(Entry.Node, Entry.Group->Key);
+			GroupRow.DisplayName = Entry.Group->Label;
+
+			int GroupRowIndex = static_cast<int>(Rows.size());
+			Rows.push_back(std::move(GroupRow));
+
+			// Members are regular node rows, so selection and filtering work on them as usual.
+			if (Rows.back().bExpanded)
+			{
+				const std::vector<FENaiveSceneGraphNode*>& Members = Entry.Group->Members;
+				for (size_t i = Members.size(); i > 0; i--)
+					Stack.push_back({ Members[i - 1], GroupRowIndex, Entry.Indentation + 1 });
+			}
 
-			// +1 to include a "no icon" option.
-			size_t Index = Hash % (IconCount + 1);
-			if (Index >= IconCount)
-				return nullptr;
+			continue;
+		}
 
-			return GetDebugIconByIndex(Index);
-		});
-	}
-	else
-	{
-		SetNodeIconProvider(nullptr);
-	}
+		RowModel.VisitedNodeCount++;
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_NODES_VISITED, 1);
 
-	if (ImGui::Button("Clear Widgets"))
-		ClearNodeWidgets();
+		if (!ShouldNodeBeVisible(Entry.Node))
+			continue;
 
-	ImGui::SameLine();
-	if (ImGui::Button("Add interactive widget"))
-		DebugCreateRandomWidgets(true);
-	
-	ImGui::SameLine();
-	if (ImGui::Button("Add non interactive widget"))
-		DebugCreateRandomWidgets(false);
+		FESceneGraphUIRow NewRow;
+		NewRow.Node = Entry.Node;
+		NewRow.NodeID = Entry.Node->GetObjectID();
+		NewRow.ParentRowIndex = Entry.ParentRowIndex;
+		NewRow.Indentation = Entry.Indentation;
+		NewRow.bHasVisibleChildren = AreNodeChildrenVisible(Entry.Node);
+		NewRow.bExpanded = IsNodeExpanded(Entry.Node);
+		NewRow.bSelected = IsNodeSelected(Entry.Node);
+		NewRow.DisplayName = GetNodeDisplayName(Entry.Node);
+		NewRow.bFilterMatch = IsTextFilterActive() && DoesDisplayNameMatchFilter(NewRow.DisplayName);
+		NewRow.Icon = GetNodeIcon(Entry.Node);
+		EvaluateRowWidgets(NewRow);
+
+		// Node ID and display name.
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_STRING_BUILDS, 2);
+
+		int NewRowIndex = static_cast<int>(Rows.size());
+		RowModel.NodeRowIndices[NewRow.NodeID] = Rows.size();
+		Rows.push_back(std::move(NewRow));
+
+		if (Rows.back().bExpanded)
+			PushChildRowBuildEntries(Entry.Node, NewRowIndex, Entry.Indentation, Stack);
+	}
+
+	bBuildingRows = false;
 }
 
-void FESceneGraphUI::RenderContextMenu()
+void FESceneGraphUI::PushChildRowBuildEntries(FENaiveSceneGraphNode* Node, int RowIndex, size_t Indentation, std::vector<FESceneGraphUIRowBuildEntry>& Stack)
 {
-	FEScene* CurrentScene = GetScene();
-	if (CurrentScene == nullptr)
+	std::vector<FENaiveSceneGraphNode*> Children = GetOrderedChildren(Node);
+	if (ShouldGroupChildren(Children.size()))
+	{
+		const std::vector<FESceneGraphSiblingGroup>& Groups = GetSiblingGroups(Node, Children);
+		for (size_t i = Groups.size(); i > 0; i--)
+		{
+			FESceneGraphUIRowBuildEntry GroupEntry;
+			GroupEntry.Node = Node;
+			GroupEntry.ParentRowIndex = RowIndex;
+			GroupEntry.Indentation = Indentation + 1;
+			GroupEntry.Group = &Groups[i - 1];
+			Stack.push_back(GroupEntry);
+		}
+
 		return;
+	}
 
-	if (bShouldOpenContextMenu)
+	size_t MaterializedChildCount = GetMaterializedChildCount(Node, Children.size());
+	// With active filter pages are counted over children that could pass it,
+	// otherwise matches in not loaded pages would stay hidden behind non-matching children.
+	if (MaterializedChildCount < Children.size() && IsTextFilterActive())
 	{
-		HoveredNodeIDWhenContextMenuWasOpened = HoveredNodeID;
-		ImGui::OpenPopup(("##Scene Graph Context Menu " + CurrentScene->GetObjectID()).c_str());
-	}	
+		Children.erase(std::remove_if(Children.begin(), Children.end(), [this](FENaiveSceneGraphNode* Child) {
+			return Child->GetEntity() != nullptr && !DoesNodePassTextFilter(Child);
+		}), Children.end());
+		MaterializedChildCount = GetMaterializedChildCount(Node, Children.size());
+	}
 
-	bShouldOpenContextMenu = false;
+	// Pushed first, so it is placed after subtrees of all materialized children.
+	if (MaterializedChildCount < Children.size())
+		Stack.push_back({ Node, RowIndex, Indentation + 1, true, MaterializedChildCount, Children.size() });
 
-	if (ImGui::BeginPopup(("##Scene Graph Context Menu " + CurrentScene->GetObjectID()).c_str()))
+	for (size_t i = MaterializedChildCount; i > 0; i--)
+		Stack.push_back({ Children[i - 1], RowIndex, Indentation + 1 });
+}
+
+void FESceneGraphUI::UpdateSelectedBranchRows()
+{
+	std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	for (size_t i = 0; i < Rows.size(); i++)
+		Rows[i].bOnSelectedBranch = false;
+
+	// Connector lines on the branch from the rendering root to each selected node are highlighted.
+	for (size_t i = 0; i < Rows.size(); i++)
 	{
-		FENaiveSceneGraphNode* ContextNode = CurrentScene->SceneGraph.GetNodeByID(HoveredNodeIDWhenContextMenuWasOpened);
-		if (ContextMenuRenderingFunction)
+		if (!Rows[i].bSelected)
+			continue;
+
+		int CurrentRowIndex = static_cast<int>(i);
+		while (CurrentRowIndex != -1 && !Rows[CurrentRowIndex].bOnSelectedBranch)
 		{
-			ContextMenuRenderingFunction(ContextNode);
+			Rows[CurrentRowIndex].bOnSelectedBranch = true;
+			CurrentRowIndex = Rows[CurrentRowIndex].ParentRowIndex;
 		}
-		else
+	}
+}
+
+const FESceneGraphRowModel& FESceneGraphUI::UpdateRowModel(FENaiveSceneGraphNode* RenderingRoot, bool bRenderRootItself)
+{
+	ApplyDeferredCommands();
+
+	if (RenderingRoot != nullptr)
+	{
+		FEScene* CurrentScene = SCENE_MANAGER.GetSceneByNodeID(RenderingRoot->GetObjectID());
+		if (CurrentScene != nullptr)
 		{
-			ImGui::TextUnformatted("No context menu rendering function set.");
+			CurrentSceneID = CurrentScene->GetObjectID();
+			SyncWithChangeJournal();
 		}
-		
-		ImGui::EndPopup();
+	}
+	ViewHistory.CommitPendingStep();
+
+	bool bEffectiveRenderRootItself = bRenderRootItself;
+	FENaiveSceneGraphNode* EffectiveRoot = GetEffectiveRenderingRoot(RenderingRoot, bEffectiveRenderRootItself);
+	SetRenderingRootInternal(EffectiveRoot, bEffectiveRenderRootItself);
+
+	if (ShouldRebuildRows())
+	{
+		RebuildRows();
 	}
 	else
 	{
-		// Popup was closed (either by user dismissing or item selected).
-		HoveredNodeIDWhenContextMenuWasOpened = "";
+		ApplyPendingRowUpdates();
 	}
+
+	return RowModel;
 }
 
-void FESceneGraphUI::Render(FENaiveSceneGraphNode* RenderingRoot, bool bRenderRootItself)
+std::string FESceneGraphUI::GetRootViewKey(FENaiveSceneGraphNode* Root, bool bRenderRootItself) const
 {
-	if (!bVisible)
+	return Root->GetObjectID() + (bRenderRootItself ? "/1" : "/0");
+}
+
+void FESceneGraphUI::SetRenderingRootInternal(FENaiveSceneGraphNode* NewRoot, bool bNewRenderRootItself)
+{
+	if (NewRoot == RenderingRoot && bNewRenderRootItself == bRenderRootItself)
 		return;
 
-	// If in debug mode ignore the provided inputs.
-	if (IsInDebugMode())
+	FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, "SwitchRoot");
+	const bool bCurrentRowsValid = CanReuseRows() && !bRowsDirty && !HasPendingRowUpdates() && RenderingRoot != nullptr &&
+								   RowModel.RenderingRoot == RenderingRoot && RowModel.bRenderRootItself == bRenderRootItself;
+
+	FESceneGraphRowModel NewRowModel;
+	std::vector<FESceneGraphUIRowTextCache> NewRowTextCache;
+	bool bNewRowsReady = false;
+	float NewScrollY = 0.0f;
+
+	if (NewRoot != nullptr)
 	{
-		if (GetTestScene() == nullptr)
-			return;
+		auto ViewIterator = RootViews.find(GetRootViewKey(NewRoot, bNewRenderRootItself));
+		if (ViewIterator != RootViews.end())
+		{
+			FESceneGraphUIRootView& View = ViewIterator->second;
+			NewScrollY = View.ScrollY;
+			if (CanReuseRows() && !bRowsDirty && View.bRowsValid && View.RowsGeneration == RowsGeneration)
+			{
+				NewRowModel = std::move(View.RowModel);
+				NewRowTextCache = std::move(View.RowTextCache);
+				bNewRowsReady = true;
+			}
 
-		RenderingRoot = GetTestScene()->SceneGraph.GetRoot();
-		bRenderRootItself = bDebugRenderRoot;
+			// Rows are either taken or stale, in both cases view keeps only scroll.
+			View.bRowsValid = false;
+			View.RowModel = FESceneGraphRowModel();
+			View.RowTextCache.clear();
+		}
 
-		DebugRenderUI();
+		if (!bNewRowsReady && bCurrentRowsValid)
+			bNewRowsReady = TryDeriveRowsFromSubrange(NewRoot, bNewRenderRootItself, NewRowModel, NewRowTextCache);
 	}
 
-	if (RenderingRoot == nullptr)
-		return;
+	const uint64_t LastRowModelVersion = RowModel.Version;
+	if (RenderingRoot != nullptr)
+	{
+		std::string OldKey = GetRootViewKey(RenderingRoot, bRenderRootItself);
+		FESceneGraphUIRootView& OldView = RootViews[OldKey];
+		OldView.ScrollY = LastListBoxScrollY;
+		OldView.bRowsValid = bCurrentRowsValid;
+		if (bCurrentRowsValid)
+		{
+			OldView.RowsGeneration = RowsGeneration;
+			OldView.RowModel = std::move(RowModel);
+			OldView.RowTextCache = std::move(RowTextCache);
+		}
 
-	FEScene* CurrentScene = SCENE_MANAGER.GetSceneByNodeID(RenderingRoot->GetObjectID());
-	if (CurrentScene == nullptr)
-		return;
+		auto OrderIterator = std::find(RootViewOrder.begin(), RootViewOrder.end(), OldKey);
+		if (OrderIterator != RootViewOrder.end())
+			RootViewOrder.erase(OrderIterator);
+		RootViewOrder.push_back(OldKey);
 
-	CurrentSceneID = CurrentScene->GetObjectID();
-	HoveredNodeID = "";
+		while (RootViewOrder.size() > MaxRootViews)
+		{
+			RootViews.erase(RootViewOrder.front());
+			RootViewOrder.pop_front();
+		}
+	}
 
-	this->RenderingRoot = RenderingRoot;
-	this->bRenderRootItself = bRenderRootItself;
-	bLastNodeWasEven = false;
+	RenderingRoot = NewRoot;
+	bRenderRootItself = bNewRenderRootItself;
+	if (!bPendingScrollExplicit)
+		PendingScrollY = NewScrollY;
+
+	if (bNewRowsReady)
+	{
+		RowModel = std::move(NewRowModel);
+		RowTextCache = std::move(NewRowTextCache);
+		ResolveFocusedRowIndex();
+	}
+	else
+	{
+		// Root is different from RowModel.RenderingRoot, so rows would be rebuilt.
+		RowModel = FESceneGraphRowModel();
+		RowTextCache.clear();
+	}
 
-	if (CousineFont == nullptr)
-		CousineFont = ImGui::GetIO().Fonts->AddFontFromFileTTF("Resources/Cousine-Regular.ttf", 32.0f);
+	// Version only grows, so consumers would not confuse restored rows with rows they have seen.
+	RowModel.Version = std::max(RowModel.Version, LastRowModelVersion) + 1;
+}
 
-	if (bRenderTextFilterInput)
-		RenderFilterTextInput();
+bool FESceneGraphUI::TryDeriveRowsFromSubrange(FENaiveSceneGraphNode* NewRoot, bool bNewRenderRootItself, FESceneGraphRowModel& OutRowModel, std::vector<FESceneGraphUIRowTextCache>& OutRowTextCache) const
+{
+	int RootRowIndex = RowModel.FindRowIndex(NewRoot->GetObjectID());
+	if (RootRowIndex == -1)
+		return false;
 
-	if (bRenderUIScaleControl)
-	{
-		if (bRenderTextFilterInput)
-			ImGui::SameLine();
+	const std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	const FESceneGraphUIRow& RootRow = Rows[RootRowIndex];
 
-		RenderUIScaleControl();
-	}
+	// Subtree rows are contiguous, they end at the first row that is not deeper than root row.
+	size_t EndRowIndex = static_cast<size_t>(RootRowIndex) + 1;
+	while (EndRowIndex < Rows.size() && Rows[EndRowIndex].Indentation > RootRow.Indentation)
+		EndRowIndex++;
 
-	ImGui::PushStyleColor(ImGuiCol_FrameBg, BackgroundColor);
-	if (ImGui::BeginListBox(("##Scene Graph" + RenderingRoot->GetObjectID()).c_str(), ImVec2(ImGui::GetContentRegionAvail())))
+	size_t FirstRowIndex = static_cast<size_t>(RootRowIndex);
+	size_t IndentationOffset = RootRow.Indentation;
+	if (!bNewRenderRootItself)
 	{
-		// 0 - default.
-		// 1 - highlighted connector lines (e.g. for selected nodes).
-		ImGui::GetWindowDrawList()->ChannelsSplit(2);
-
-		if (CousineFont != nullptr)
-			ImGui::PushFont(CousineFont, GetFontSize());
+		if (RootRow.bHasVisibleChildren && !RootRow.bExpanded)
+			return false;
 
-		if (bRenderRootItself)
+		// Children of hidden root are not grouped or paged, so only plain rows can be reused.
+		for (size_t i = FirstRowIndex + 1; i < EndRowIndex; i++)
 		{
-			RenderNode(RenderingRoot);
+			if (Rows[i].ParentRowIndex == RootRowIndex && Rows[i].Type != FE_SCENE_GRAPH_UI_ROW_NODE)
+				return false;
 		}
-		else
-		{
-			std::vector<FENaiveSceneGraphNode*> Children = RenderingRoot->GetChildren();
-			std::vector<std::string> ChildrenIDs;
-			for (size_t i = 0; i < Children.size(); i++)
-				ChildrenIDs.push_back(Children[i]->GetObjectID());
 
-			// We snapshot children as IDs rather than pointers because rendering
-			// each node can trigger callbacks that modify the scene graph,
-			// potentially invalidating pointers. We re-resolve each ID before use
-			// and skip any nodes that were removed during iteration.
-			for (size_t i = 0; i < ChildrenIDs.size(); i++)
-			{
-				FENaiveSceneGraphNode* ChildNode = CurrentScene->SceneGraph.GetNodeByID(ChildrenIDs[i]);
-				if (ChildNode != nullptr)
-					RenderNode(ChildNode);
-			}
-		}
+		FirstRowIndex++;
+		IndentationOffset++;
+	}
 
-		// Node widgets render on the same line as the Selectable and shift the cursor Y position due to vertical centering adjustments.
-		// We restore the cursor to the pre-widget Y position so the next node starts at the correct vertical offset.
-		// After all nodes are rendered, we set the cursor to correct position to ensure the parent container (e.g. ListBox) accounts for the full content height.
-		// If not accounted for, ImGui will assert with request to use Dummy().
-		if (YCursorPositionBeforeRenderingWidgets > YCursorPositionAfterRenderingWidgets)
-			ImGui::SetCursorPosY(YCursorPositionAfterRenderingWidgets);
-		
-		if (CousineFont != nullptr)
-			ImGui::PopFont();
+	OutRowModel.Rows.assign(Rows.begin() + FirstRowIndex, Rows.begin() + EndRowIndex);
+	OutRowModel.NodeRowIndices.clear();
+	OutRowModel.RenderingRoot = NewRoot;
+	OutRowModel.bRenderRootItself = bNewRenderRootItself;
+	OutRowModel.VisitedNodeCount = 0;
+	for (size_t i = 0; i < OutRowModel.Rows.size(); i++)
+	{
+		FESceneGraphUIRow& Row = OutRowModel.Rows[i];
+		Row.Indentation -= IndentationOffset;
+		Row.ParentRowIndex = Row.ParentRowIndex < static_cast<int>(FirstRowIndex) ? -1 : Row.ParentRowIndex - static_cast<int>(FirstRowIndex);
+		if (Row.Type == FE_SCENE_GRAPH_UI_ROW_NODE)
+			OutRowModel.NodeRowIndices[Row.NodeID] = i;
+	}
 
-		ImGui::EndListBox();
+	if (EndRowIndex <= RowTextCache.size())
+	{
+		OutRowTextCache.assign(RowTextCache.begin() + FirstRowIndex, RowTextCache.begin() + EndRowIndex);
+	}
+	else
+	{
+		OutRowTextCache.assign(OutRowModel.Rows.size(), FESceneGraphUIRowTextCache());
 	}
-	ImGui::PopStyleColor();
 
-	ImGui::GetWindowDrawList()->ChannelsMerge();
+	return true;
+}
 
-	bSceneGraphWindowHovered = ImGui::IsWindowHovered(ImGuiHoveredFlags_AllowWhenBlockedByActiveItem | ImGuiHoveredFlags_ChildWindows);
-	if (bSceneGraphWindowHovered && ImGui::IsMouseClicked(ImGuiMouseButton_Right))
-		bShouldOpenContextMenu = true;
+const FESceneGraphRowModel& FESceneGraphUI::GetRowModel() const
+{
+	return RowModel;
+}
 
-	RenderContextMenu();
+bool FESceneGraphUI::IsProfilingEnabled() const
+{
+	return Profiler.IsEnabled();
 }
 
-void FESceneGraphUI::ExpandAllNodes()
+void FESceneGraphUI::SetProfilingEnabled(bool bNewValue)
 {
-	if (RenderingRoot == nullptr)
-		return;
+	Profiler.SetEnabled(bNewValue);
+}
 
-	std::vector<FENaiveSceneGraphNode*> Stack;
-	Stack.push_back(RenderingRoot);
-	while (!Stack.empty())
-	{
-		FENaiveSceneGraphNode* CurrentNode = Stack.back();
-		Stack.pop_back();
-		SetNodeExpanded(CurrentNode, true);
-		for (FENaiveSceneGraphNode* Child : CurrentNode->GetChildren())
-			Stack.push_back(Child);
-	}
+const FESceneGraphUIProfiler& FESceneGraphUI::GetProfiler() const
+{
+	return Profiler;
 }
 
-void FESceneGraphUI::CollapseAllNodes()
+FESceneGraphUIFrameProfile FESceneGraphUI::GetLastFrameProfile() const
 {
-	if (RenderingRoot == nullptr)
-		return;
+	return Profiler.GetLastFrame();
+}
 
-	std::vector<FENaiveSceneGraphNode*> Stack;
-	Stack.push_back(RenderingRoot);
-	while (!Stack.empty())
-	{
-		FENaiveSceneGraphNode* CurrentNode = Stack.back();
-		Stack.pop_back();
-		SetNodeExpanded(CurrentNode, false);
-		for (FENaiveSceneGraphNode* Child : CurrentNode->GetChildren())
-			Stack.push_back(Child);
-	}
+void FESceneGraphUI::RenderProfilerOverlay()
+{
+	Profiler.RenderOverlay("Scene graph profiler##" + std::to_string(reinterpret_cast<uintptr_t>(this)));
 }
 
-bool FESceneGraphUI::IsInDebugMode()
+FESceneGraphUITraceSink* FESceneGraphUI::GetTraceSink() const
 {
-	return bDebugMode;
+	return TraceSink;
 }
 
-bool FESceneGraphUI::InitiateTestScene()
+void FESceneGraphUI::SetTraceSink(FESceneGraphUITraceSink* NewSink)
 {
-	FEScene* SceneToWorkWith = GetTestScene();
-	if (SceneToWorkWith == nullptr)
-		return false;
+	TraceSink = NewSink;
+}
 
-	std::vector<FENaiveSceneGraphNode*> Nodes;
-	for (size_t i = 0; i < 30; i++)
+std::string FESceneGraphUI::GetCallbackRegistrationName(const std::string& Kind, const std::string& Name)
+{
+	size_t RegistrationIndex = CallbackRegistrationCount++;
+	if (!Name.empty())
+		return Name;
+
+	return Kind + " #" + std::to_string(RegistrationIndex);
+}
+
+void FESceneGraphUI::RenderRow(size_t RowIndex, float RowPitch)
+{
+	FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, "RenderNode");
+	DrawFocusedRowFrame(RowIndex);
+	const FESceneGraphUIRow& Row = RowModel.Rows[RowIndex];
+	if (Row.Type == FE_SCENE_GRAPH_UI_ROW_MORE_CHILDREN)
 	{
-		FEEntity* Entity = SceneToWorkWith->CreateEntity("Node_" + std::to_string(i));
-		Nodes.push_back(SceneToWorkWith->SceneGraph.GetNodeByEntityID(Entity->GetObjectID()));
+		RenderMoreChildrenRow(RowIndex, RowPitch);
+		return;
 	}
 
-	// Create a hierarchy:
-	//
-	//                  0
-	//          /       |       \
-    //         1        2        3
-	//       / | \    / | \    / | \
-    //      4  5  6  7  8  9  10 11 12
-	//     /\  |     |  |  |   |  |  |\
-    //   13 14 15   16 17 18  19 20 21 22
+	if (Row.Type == FE_SCENE_GRAPH_UI_ROW_SIBLING_GROUP)
+	{
+		RenderSiblingGroupRow(RowIndex, RowPitch);
+		return;
+	}
+	FENaiveSceneGraphNode* Node = Row.Node;
+	ImGui::SetCursorPosX(ImGui::GetCursorPosX() + Row.Indentation * NodeHeight);
+
+	DrawAppropriateTreeArrow(Row);
+
+	if (Row.Icon != nullptr)
+	{
+		ImTextureID TextureID;
+		ImVec2 UV0, UV1;
+		GetIconDrawData(Row.Icon, TextureID, UV0, UV1);
+		ImGui::Image(TextureID, IconsSize, UV0, UV1);
+		ImGui::SameLine();
+	}
+
+	float IconSpacing = GetFontSize() * 0.15f;
+	float SpaceNeededForWidgetAtEnd = GetNodeWidgetAreaWidth(Row.Widgets.size());
+	float NodeBodyWidth = ImGui::GetContentRegionAvail().x - SpaceNeededForWidgetAtEnd - IconSpacing;
+
+	FESceneGraphUIRowTextCache& TextCache = RowTextCache[RowIndex];
+	if (TextCache.Width != NodeBodyWidth)
+	{
+		FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_TEXT_TRUNCATION);
+		FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_STRING_BUILDS, 1);
+		TextCache.Text = APPLICATION.TruncateText(Row.DisplayName, NodeBodyWidth) + "##" + Row.NodeID;
+		TextCache.Width = NodeBodyWidth;
+	}
+
+	if (bAlternatingNodeBackground)
+	{
+		bool bEvenRow = RowIndex % 2 == 0;
+		ImVec2 RectMin = ImGui::GetCursorScreenPos();
+		ImVec2 RectMax = ImVec2(RectMin.x + NodeBodyWidth, RectMin.y + NodeHeight);
+		RowBackgroundBatch.push_back({ RectMin, RectMax, bEvenRow ? ImColor(EvenNodeBackgroundColor) : ImColor(OddNodeBackgroundColor) });
+	}
+
+	for (size_t i = 0; i < BeforeNodeRenderCallbacks.size(); i++)
+	{
+		FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, BeforeNodeRenderCallbacks[i].Name.c_str());
+		BeforeNodeRenderCallbacks[i].Function(Node);
+	}
+	
+	// Selection is checked every frame only for submitted rows, because selection predicate could depend on external state.
+	bool bIsSelected = IsNodeSelected(Node);
+	if (NodeIDBeingRenamed == Row.NodeID)
+	{
+		if (!bLastFrameRenameEditWasVisible)
+		{
+			ImGui::SetKeyboardFocusHere(0);
+
+			ImGuiContext* Context = ImGui::GetCurrentContext();
+			if (Context != nullptr)
+				ImGui::SetFocusID(ImGui::GetID("##SceneGraphRenameEditor"), Context->CurrentWindow);
+			
+			ImGui::SetItemDefaultFocus();
+			bLastFrameRenameEditWasVisible = true;
+		}
+
+		ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.2f, 0.2f, 0.3f, 1.0f));
+		ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(0.4f, 0.6f, 1.0f, 1.0f));
+		ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1.5f);
+		ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 2.0f);
+
+		ImGui::SetNextItemWidth(NodeBodyWidth);
+		if (ImGui::InputText("##SceneGraphRenameEditor", RenameBuffer, IM_ARRAYSIZE(RenameBuffer), ImGuiInputTextFlags_EnterReturnsTrue) ||
+			ImGui::IsMouseClicked(0) && !ImGui::IsItemHovered() || !ImGui::IsItemFocused())
+		{
+			QueueNodeRename(Node, RenameBuffer);
+			NodeIDBeingRenamed = "";
+		}
+
+		ImGui::PopStyleVar(2);
+		ImGui::PopStyleColor(2);
+	}
+	else
+	{
+		ImGui::Selectable(TextCache.Text.c_str(), bIsSelected, ImGuiSelectableFlags_None, ImVec2(NodeBodyWidth, NodeHeight));
+		if (bNodeDragAndDropEnabled)
+			HandleNodeDragAndDrop(RowIndex);
+	}
+
+	for (size_t i = 0; i < AfterNodeRenderCallbacks.size(); i++)
+	{
+		FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, AfterNodeRenderCallbacks[i].Name.c_str());
+		AfterNodeRenderCallbacks[i].Function(Node);
+	}
+
+	CheckInputs(Node);
+	if (ImGui::IsItemClicked(ImGuiMouseButton_Left))
+		SetFocusedRow(static_cast<int>(RowIndex));
+	RenderNodeWidgets(Row);
+
+	// Arrow button or spacer, optional icon, selectable or rename editor and widgets.
+	FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_IMGUI_ITEMS, 2 + (Row.Icon != nullptr ? 1 : 0) + Row.Widgets.size());
+	FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_ROWS_SUBMITTED, 1);
+}
+
+void FESceneGraphUI::RenderMoreChildrenRow(size_t RowIndex, float RowPitch)
+{
+	const FESceneGraphUIRow& Row = RowModel.Rows[RowIndex];
+	ImGui::SetCursorPosX(ImGui::GetCursorPosX() + Row.Indentation * NodeHeight);
+
+	// Same space as tree arrow of regular rows.
+	ImGui::Dummy(ImVec2(FontSize, NodeHeight));
+	ImGui::SameLine();
+
+	size_t HiddenChildCount = Row.TotalChildCount - Row.LoadedChildCount;
+	size_t NextPageChildCount = std::min(ChildPageSize, HiddenChildCount);
+	std::string NextPageLabel = "Show next " + std::to_string(NextPageChildCount) + " (" + std::to_string(HiddenChildCount) + " hidden)##NextChildPage" + Row.NodeID;
+	if (ImGui::Button(NextPageLabel.c_str(), ImVec2(0.0f, NodeHeight)))
+		LoadNextChildPage(Row.Node);
+
+	ImGui::SameLine();
+	if (ImGui::Button(("Show all##AllChildren" + Row.NodeID).c_str(), ImVec2(0.0f, NodeHeight)))
+		LoadAllChildren(Row.Node);
+
+	FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_IMGUI_ITEMS, 3);
+	FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_ROWS_SUBMITTED, 1);
+}
+
+size_t FESceneGraphUI::GetMaterializedChildCount(FENaiveSceneGraphNode* Node, size_t ChildCount)
+{
+	if (ChildPagingThreshold == 0 || ChildCount <= ChildPagingThreshold)
+		return ChildCount;
+
+	size_t LoadedChildCount = std::max(NodeState[Node->GetObjectID()].LoadedChildCount, ChildPageSize);
+	return std::min(LoadedChildCount, ChildCount);
+}
+
+void FESceneGraphUI::EnsureChildIsMaterialized(FENaiveSceneGraphNode* Parent, FENaiveSceneGraphNode* Child)
+{
+	std::vector<FENaiveSceneGraphNode*> Children = Parent->GetChildren();
+	if (ShouldGroupChildren(Children.size()))
+	{
+		const std::vector<FESceneGraphSiblingGroup>& Groups = GetSiblingGroups(Parent, GetOrderedChildren(Parent));
+		for (size_t i = 0; i < Groups.size(); i++)
+		{
+			if (std::find(Groups[i].Members.begin(), Groups[i].Members.end(), Child) != Groups[i].Members.end())
+			{
+				SetSiblingGroupExpanded(Parent, Groups[i].Key, true);
+				break;
+			}
+		}
+
+		return;
+	}
+
+	if (ChildPagingThreshold == 0 || Children.size() <= ChildPagingThreshold)
+		return;
+
+	// Position in sorted order comes from the cached permutation, only storage order needs a scan.
+	size_t ChildIndex = 0;
+	if (ChildrenSortMode == FE_SCENE_GRAPH_UI_CHILDREN_SORT_STORAGE)
+	{
+		auto Iterator = std::find(Children.begin(), Children.end(), Child);
+		if (Iterator == Children.end())
+			return;
+
+		ChildIndex = static_cast<size_t>(Iterator - Children.begin());
+	}
+	else
+	{
+		const FESceneGraphSortedChildren& SortedChildren = GetUpdatedSortedChildren(Parent, Children);
+		int Position = SortedChildren.FindPosition(Child->GetObjectID(), GetChildrenSortKey(Child));
+		// Key providers could change keys without journal record, then stored key is different from the current one.
+		if (Position == -1)
+		{
+			const std::vector<FESceneGraphSortedChild>& Entries = SortedChildren.GetEntries();
+			for (size_t i = 0; i < Entries.size() && Position == -1; i++)
+			{
+				if (Entries[i].Node == Child)
+					Position = static_cast<int>(i);
+			}
+		}
+
+		if (Position == -1)
+			return;
+
+		ChildIndex = static_cast<size_t>(Position);
+	}
+
+	// Loaded range is extended to the end of the page that contains child.
+	if (ChildIndex < GetMaterializedChildCount(Parent, Children.size()))
+		return;
+
+	size_t PageSize = std::max(ChildPageSize, static_cast<size_t>(1));
+	NodeState[Parent->GetObjectID()].LoadedChildCount = (ChildIndex / PageSize + 1) * PageSize;
+	MarkRowSubtreeDirty(Parent);
+}
+
+size_t FESceneGraphUI::GetChildPagingThreshold() const
+{
+	return ChildPagingThreshold;
+}
+
+void FESceneGraphUI::SetChildPagingThreshold(size_t NewValue)
+{
+	ChildPagingThreshold = NewValue;
+	MarkRowsDirty();
+}
+
+size_t FESceneGraphUI::GetChildPageSize() const
+{
+	return ChildPageSize;
+}
+
+void FESceneGraphUI::SetChildPageSize(size_t NewValue)
+{
+	ChildPageSize = std::max(NewValue, static_cast<size_t>(1));
+	MarkRowsDirty();
+}
+
+void FESceneGraphUI::LoadNextChildPage(FENaiveSceneGraphNode* Node)
+{
+	if (Node == nullptr)
+		return;
+
+	size_t& LoadedChildCount = NodeState[Node->GetObjectID()].LoadedChildCount;
+	if (LoadedChildCount > std::numeric_limits<size_t>::max() - 2 * ChildPageSize)
+		return;
+
+	LoadedChildCount = std::max(LoadedChildCount, ChildPageSize) + ChildPageSize;
+	MarkRowsDirty();
+}
+
+void FESceneGraphUI::LoadAllChildren(FENaiveSceneGraphNode* Node)
+{
+	if (Node == nullptr)
+		return;
+
+	NodeState[Node->GetObjectID()].LoadedChildCount = std::numeric_limits<size_t>::max();
+	MarkRowsDirty();
+}
+
+std::string FESceneGraphUI::GetChildrenSortKey(FENaiveSceneGraphNode* Node)
+{
+	switch (ChildrenSortMode)
+	{
+		case FE_SCENE_GRAPH_UI_CHILDREN_SORT_NAME:
+		case FE_SCENE_GRAPH_UI_CHILDREN_SORT_NATURAL_NAME:
+		{
+			std::string Key = GetNodeDisplayName(Node);
+			std::transform(Key.begin(), Key.end(), Key.begin(), ::tolower);
+			return Key;
+		}
+		case FE_SCENE_GRAPH_UI_CHILDREN_SORT_TAG:
+			return FESceneGraphSiblingGrouping::GetNodeTag(Node);
+		case FE_SCENE_GRAPH_UI_CHILDREN_SORT_ENTITY_TYPE:
+			if (EntityTypeProvider != nullptr)
+				return EntityTypeProvider(Node);
+			return Node->GetEntity() == nullptr ? "" : "Entity";
+		case FE_SCENE_GRAPH_UI_CHILDREN_SORT_CUSTOM:
+			return ChildrenSortKeyProvider != nullptr ? ChildrenSortKeyProvider(Node) : "";
+		default:
+			return "";
+	}
+}
+
+std::vector<FENaiveSceneGraphNode*> FESceneGraphUI::GetOrderedChildren(FENaiveSceneGraphNode* Node)
+{
+	std::vector<FENaiveSceneGraphNode*> Children = Node->GetChildren();
+	if (ChildrenSortMode == FE_SCENE_GRAPH_UI_CHILDREN_SORT_STORAGE || Children.size() < 2)
+		return Children;
+
+	return GetUpdatedSortedChildren(Node, Children).GetNodes();
+}
+
+FESceneGraphSortedChildren& FESceneGraphUI::GetUpdatedSortedChildren(FENaiveSceneGraphNode* Node, const std::vector<FENaiveSceneGraphNode*>& Children)
+{
+	auto KeyProvider = [this](FENaiveSceneGraphNode* Child) {
+		return GetChildrenSortKey(Child);
+	};
+
+	FESceneGraphSortedChildren& SortedChildren = SortedChildrenCaches[Node->GetObjectID()];
+	if (!SortedChildren.IsBuilt())
+	{
+		SortedChildren.Build(Children, KeyProvider, ChildrenSortMode == FE_SCENE_GRAPH_UI_CHILDREN_SORT_NATURAL_NAME, bChildrenSortAscending);
+	}
+	else
+	{
+		SortedChildren.Update(Children, KeyProvider);
+	}
+
+	return SortedChildren;
+}
+
+void FESceneGraphUI::MarkSortedChildStale(const std::string& ParentID, const std::string& NodeID)
+{
+	// Record without parent, it could be made by host through FESceneGraphChangeJournal::Record.
+	if (ParentID.empty())
+	{
+		for (auto& SortedChildrenPair : SortedChildrenCaches)
+			SortedChildrenPair.second.MarkStale(NodeID);
+		return;
+	}
+
+	auto Iterator = SortedChildrenCaches.find(ParentID);
+	if (Iterator != SortedChildrenCaches.end())
+		Iterator->second.MarkStale(NodeID);
+}
+
+FE_SCENE_GRAPH_UI_CHILDREN_SORT_MODE FESceneGraphUI::GetChildrenSortMode() const
+{
+	return ChildrenSortMode;
+}
+
+bool FESceneGraphUI::IsChildrenSortAscending() const
+{
+	return bChildrenSortAscending;
+}
+
+void FESceneGraphUI::SetChildrenSortMode(FE_SCENE_GRAPH_UI_CHILDREN_SORT_MODE NewMode, bool bAscending)
+{
+	if (ChildrenSortMode == NewMode && bChildrenSortAscending == bAscending)
+		return;
+
+	ChildrenSortMode = NewMode;
+	bChildrenSortAscending = bAscending;
+	SortedChildrenCaches.clear();
+	// Members of groups follow sort order.
+	ClearSiblingGroupCaches();
+}
+
+void FESceneGraphUI::SetChildrenSortKeyProvider(std::function<std::string(FENaiveSceneGraphNode*)> Provider)
+{
+	ChildrenSortKeyProvider = Provider;
+	InvalidateChildrenSortOrder();
+}
+
+void FESceneGraphUI::SetEntityTypeProvider(std::function<std::string(FENaiveSceneGraphNode*)> Provider)
+{
+	EntityTypeProvider = Provider;
+	InvalidateChildrenSortOrder();
+}
+
+void FESceneGraphUI::InvalidateChildrenSortOrder(FENaiveSceneGraphNode* Parent)
+{
+	if (Parent == nullptr)
+	{
+		SortedChildrenCaches.clear();
+	}
+	else
+	{
+		SortedChildrenCaches.erase(Parent->GetObjectID());
+	}
+
+	ClearSiblingGroupCaches();
+}
+
+bool FESceneGraphUI::ShouldGroupChildren(size_t ChildCount) const
+{
+	return SiblingGroupingMode != FE_SCENE_GRAPH_UI_SIBLING_GROUPING_NONE && ChildCount > SiblingGroupingThreshold;
+}
+
+const std::vector<FESceneGraphSiblingGroup>& FESceneGraphUI::GetSiblingGroups(FENaiveSceneGraphNode* Parent, const std::vector<FENaiveSceneGraphNode*>& Children)
+{
+	// Change journal invalidates caches, membership check also catches changes made outside of it,
+	// so groups never hold pointers of deleted nodes. Current children are alive, so only they are dereferenced.
+	FESceneGraphUISiblingGroupCache& Cache = SiblingGroupCaches[Parent->GetObjectID()];
+	bool bCacheValid = !Cache.Groups.empty() && Cache.Children == Children;
+	for (size_t i = 0; i < Children.size() && bCacheValid; i++)
+		bCacheValid = Cache.ChildIDs[i] == Children[i]->GetObjectID();
+
+	if (!bCacheValid)
+	{
+		Cache.Children = Children;
+		Cache.ChildIDs.resize(Children.size());
+		for (size_t i = 0; i < Children.size(); i++)
+			Cache.ChildIDs[i] = Children[i]->GetObjectID();
+
+		Cache.Groups = FESceneGraphSiblingGrouping::Build(Children, SiblingGroupingMode, [this](FENaiveSceneGraphNode* Node) {
+			return GetNodeDisplayName(Node);
+		}, AlphabeticalSiblingGroupSize);
+	}
+
+	return Cache.Groups;
+}
+
+void FESceneGraphUI::ClearSiblingGroupCaches()
+{
+	SiblingGroupCaches.clear();
+	MarkRowsDirty();
+}
+
+bool FESceneGraphUI::IsSiblingGroupExpanded(FENaiveSceneGraphNode* Parent, const std::string& GroupKey) const
+{
+	return ExpandedSiblingGroups.find(Parent->GetObjectID() + "/" + GroupKey) != ExpandedSiblingGroups.end();
+}
+
+void FESceneGraphUI::SetSiblingGroupExpanded(FENaiveSceneGraphNode* Parent, const std::string& GroupKey, bool bExpanded)
+{
+	if (bExpanded)
+	{
+		ExpandedSiblingGroups.insert(Parent->GetObjectID() + "/" + GroupKey);
+	}
+	else
+	{
+		ExpandedSiblingGroups.erase(Parent->GetObjectID() + "/" + GroupKey);
+	}
+
+	MarkRowSubtreeDirty(Parent);
+}
+
+bool FESceneGraphUI::IsAnySiblingGroupMemberVisible(const FESceneGraphSiblingGroup& Group)
+{
+	// Without filter, hidden tags and render predicate every member is visible, so members are not visited.
+	if (!bFilterEnabled && HiddenEntityTags.empty() && NodeRenderPredicate == nullptr)
+		return !Group.Members.empty();
+
+	for (size_t i = 0; i < Group.Members.size(); i++)
+	{
+		if (ShouldNodeBeVisible(Group.Members[i]))
+			return true;
+	}
+
+	return false;
+}
+
+void FESceneGraphUI::RenderSiblingGroupRow(size_t RowIndex, float RowPitch)
+{
+	const FESceneGraphUIRow& Row = RowModel.Rows[RowIndex];
+	ImGui::SetCursorPosX(ImGui::GetCursorPosX() + Row.Indentation * NodeHeight);
+
+	DrawAppropriateTreeArrow(Row);
+
+	FESceneGraphUIRowTextCache& TextCache = RowTextCache[RowIndex];
+	float GroupBodyWidth = ImGui::GetContentRegionAvail().x - ImGui::GetStyle().WindowPadding.x;
+	if (TextCache.Width != GroupBodyWidth)
+	{
+		TextCache.Text = APPLICATION.TruncateText(Row.DisplayName, GroupBodyWidth) + "##Group" + Row.NodeID + "/" + Row.GroupKey;
+		TextCache.Width = GroupBodyWidth;
+	}
+
+	ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
+	if (ImGui::Selectable(TextCache.Text.c_str(), false, ImGuiSelectableFlags_None, ImVec2(GroupBodyWidth, NodeHeight)))
+		SetSiblingGroupExpanded(Row.Node, Row.GroupKey, !Row.bExpanded);
+	ImGui::PopStyleColor();
+
+	FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_IMGUI_ITEMS, 2);
+	FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_ROWS_SUBMITTED, 1);
+}
+
+FE_SCENE_GRAPH_UI_SIBLING_GROUPING FESceneGraphUI::GetSiblingGroupingMode() const
+{
+	return SiblingGroupingMode;
+}
+
+void FESceneGraphUI::SetSiblingGroupingMode(FE_SCENE_GRAPH_UI_SIBLING_GROUPING NewValue)
+{
+	if (SiblingGroupingMode == NewValue)
+		return;
+
+	SiblingGroupingMode = NewValue;
+	// Group keys of different modes are not compatible.
+	ExpandedSiblingGroups.clear();
+	ClearSiblingGroupCaches();
+}
+
+size_t FESceneGraphUI::GetSiblingGroupingThreshold() const
+{
+	return SiblingGroupingThreshold;
+}
+
+void FESceneGraphUI::SetSiblingGroupingThreshold(size_t NewValue)
+{
+	SiblingGroupingThreshold = NewValue;
+	MarkRowsDirty();
+}
+
+size_t FESceneGraphUI::GetAlphabeticalSiblingGroupSize() const
+{
+	return AlphabeticalSiblingGroupSize;
+}
+
+void FESceneGraphUI::SetAlphabeticalSiblingGroupSize(size_t NewValue)
+{
+	AlphabeticalSiblingGroupSize = std::max(NewValue, static_cast<size_t>(1));
+	if (SiblingGroupingMode == FE_SCENE_GRAPH_UI_SIBLING_GROUPING_ALPHABETICAL)
+	{
+		ExpandedSiblingGroups.clear();
+		ClearSiblingGroupCaches();
+	}
+}
+
+void FESceneGraphUI::SetFocusedRow(int RowIndex)
+{
+	if (RowIndex < 0 || RowIndex >= static_cast<int>(RowModel.Rows.size()))
+		return;
+
+	const FESceneGraphUIRow& Row = RowModel.Rows[RowIndex];
+	FocusedRowIndex = RowIndex;
+	FocusedNode = Row.Node;
+	FocusedNodeID = Row.NodeID;
+	FocusedRowType = Row.Type;
+	FocusedGroupKey = Row.GroupKey;
+}
+
+void FESceneGraphUI::ResolveFocusedRowIndex()
+{
+	FocusedRowIndex = -1;
+	if (FocusedNode == nullptr)
+		return;
+
+	if (FocusedRowType == FE_SCENE_GRAPH_UI_ROW_NODE)
+	{
+		FocusedRowIndex = RowModel.FindRowIndex(FocusedNodeID);
+		return;
+	}
+
+	const std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	for (size_t i = 0; i < Rows.size(); i++)
+	{
+		if (Rows[i].Node == FocusedNode && Rows[i].Type == FocusedRowType && Rows[i].GroupKey == FocusedGroupKey)
+		{
+			FocusedRowIndex = static_cast<int>(i);
+			return;
+		}
+	}
+}
+
+void FESceneGraphUI::HandleKeyboardNavigation(float RowPitch)
+{
+	const std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	if (Rows.empty() || RowPitch <= 0.0f)
+		return;
+
+	int RowCount = static_cast<int>(Rows.size());
+	int CurrentRowIndex = FocusedRowIndex >= 0 && FocusedRowIndex < RowCount ? FocusedRowIndex : -1;
+	// While prefix is being typed Space is a part of it (names like "Point light"), otherwise it toggles selection.
+	const bool bTypeAheadActive = !TypeAheadBuffer.empty() && ImGui::GetTime() - LastTypeAheadTime <= TypeAheadTimeout;
+	int NewRowIndex = CurrentRowIndex;
+	int RowsPerPage = std::max(1, static_cast<int>(ImGui::GetWindowHeight() / RowPitch) - 1);
+
+	if (ImGui::IsKeyPressed(ImGuiKey_DownArrow))
+	{
+		NewRowIndex = CurrentRowIndex + 1;
+	}
+	else if (ImGui::IsKeyPressed(ImGuiKey_UpArrow))
+	{
+		NewRowIndex = CurrentRowIndex == -1 ? 0 : CurrentRowIndex - 1;
+	}
+	else if (ImGui::IsKeyPressed(ImGuiKey_PageDown))
+	{
+		NewRowIndex = std::max(CurrentRowIndex, 0) + RowsPerPage;
+	}
+	else if (ImGui::IsKeyPressed(ImGuiKey_PageUp))
+	{
+		NewRowIndex = std::max(CurrentRowIndex, 0) - RowsPerPage;
+	}
+	else if (ImGui::IsKeyPressed(ImGuiKey_Home))
+	{
+		NewRowIndex = 0;
+	}
+	else if (ImGui::IsKeyPressed(ImGuiKey_End))
+	{
+		NewRowIndex = RowCount - 1;
+	}
+	else if (CurrentRowIndex != -1)
+	{
+		const FESceneGraphUIRow& Row = Rows[CurrentRowIndex];
+		bool bGroupRow = Row.Type == FE_SCENE_GRAPH_UI_ROW_SIBLING_GROUP;
+		if (ImGui::IsKeyPressed(ImGuiKey_LeftArrow))
+		{
+			if (Row.bHasVisibleChildren && Row.bExpanded)
+			{
+				if (bGroupRow)
+				{
+					SetSiblingGroupExpanded(Row.Node, Row.GroupKey, false);
+				}
+				else
+				{
+					SetNodeExpanded(Row.Node, false);
+				}
+			}
+			else if (Row.ParentRowIndex != -1)
+			{
+				NewRowIndex = Row.ParentRowIndex;
+			}
+		}
+		else if (ImGui::IsKeyPressed(ImGuiKey_RightArrow))
+		{
+			if (Row.bHasVisibleChildren && !Row.bExpanded)
+			{
+				if (bGroupRow)
+				{
+					SetSiblingGroupExpanded(Row.Node, Row.GroupKey, true);
+				}
+				else
+				{
+					SetNodeExpanded(Row.Node, true);
+				}
+			}
+			else if (CurrentRowIndex + 1 < RowCount && Rows[CurrentRowIndex + 1].ParentRowIndex == CurrentRowIndex)
+			{
+				NewRowIndex = CurrentRowIndex + 1;
+			}
+		}
+		else if ((ImGui::IsKeyPressed(ImGuiKey_Space, false) && !bTypeAheadActive) || ImGui::IsKeyPressed(ImGuiKey_Enter, false))
+		{
+			bool bEnter = ImGui::IsKeyPressed(ImGuiKey_Enter, false);
+			if (Row.Type == FE_SCENE_GRAPH_UI_ROW_MORE_CHILDREN)
+			{
+				LoadNextChildPage(Row.Node);
+			}
+			else if (bGroupRow)
+			{
+				SetSiblingGroupExpanded(Row.Node, Row.GroupKey, !Row.bExpanded);
+			}
+			else if (bEnter)
+			{
+				// Enter keeps only focused node selected, even if multiple selection is allowed.
+				bool bOldMultipleSelection = bAllowMultipleNodeSelection;
+				bAllowMultipleNodeSelection = false;
+				SetNodeSelected(Row.Node, true);
+				bAllowMultipleNodeSelection = bOldMultipleSelection;
+			}
+			else
+			{
+				SetNodeSelected(Row.Node, !IsNodeSelected(Row.Node));
+			}
+		}
+	}
+
+	// Type-ahead, characters typed within timeout are collected into one prefix.
+	ImGuiIO& IO = ImGui::GetIO();
+	for (int i = 0; i < IO.InputQueueCharacters.Size; i++)
+	{
+		ImWchar Character = IO.InputQueueCharacters[i];
+		if (Character < 32 || Character > 126)
+			continue;
+
+		if (Character == ' ' && !bTypeAheadActive)
+			continue;
+
+		double CurrentTime = ImGui::GetTime();
+		if (CurrentTime - LastTypeAheadTime > TypeAheadTimeout)
+			TypeAheadBuffer.clear();
+		LastTypeAheadTime = CurrentTime;
+
+		TypeAheadBuffer += static_cast<char>(tolower(static_cast<int>(Character)));
+		// First character jumps to the next match, longer prefix could still match current row.
+		int StartRowIndex = TypeAheadBuffer.size() == 1 ? CurrentRowIndex + 1 : std::max(CurrentRowIndex, 0);
+		int MatchRowIndex = FindRowByTypeAhead(TypeAheadBuffer, StartRowIndex);
+		if (MatchRowIndex != -1)
+			NewRowIndex = MatchRowIndex;
+	}
+
+	if (NewRowIndex == CurrentRowIndex)
+		return;
+
+	NewRowIndex = std::max(0, std::min(NewRowIndex, RowCount - 1));
+	SetFocusedRow(NewRowIndex);
+	bScrollToFocusedRow = true;
+}
+
+int FESceneGraphUI::FindRowByTypeAhead(const std::string& Prefix, int StartRowIndex) const
+{
+	const std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	int RowCount = static_cast<int>(Rows.size());
+	for (int Offset = 0; Offset < RowCount; Offset++)
+	{
+		int RowIndex = (std::max(StartRowIndex, 0) + Offset) % RowCount;
+		const FESceneGraphUIRow& Row = Rows[RowIndex];
+		if (Row.Type != FE_SCENE_GRAPH_UI_ROW_NODE || Row.DisplayName.size() < Prefix.size())
+			continue;
+
+		bool bMatch = true;
+		for (size_t i = 0; i < Prefix.size(); i++)
+		{
+			if (tolower(static_cast<unsigned char>(Row.DisplayName[i])) != Prefix[i])
+			{
+				bMatch = false;
+				break;
+			}
+		}
+
+		if (bMatch)
+			return RowIndex;
+	}
+
+	return -1;
+}
+
+void FESceneGraphUI::DrawFocusedRowFrame(size_t RowIndex)
+{
+	if (static_cast<int>(RowIndex) != FocusedRowIndex)
+		return;
+
+	ImVec2 RectMin = ImGui::GetCursorScreenPos();
+	ImVec2 RectMax = ImVec2(RectMin.x + ImGui::GetContentRegionAvail().x, RectMin.y + NodeHeight);
+	ImGui::GetWindowDrawList()->AddRect(RectMin, RectMax, ImColor(FocusedRowFrameColor), 2.0f, 0, 1.5f);
+}
+
+void FESceneGraphUI::ScrollToRow(int RowIndex, float RowPitch, float Alignment)
+{
+	if (RowIndex < 0 || RowIndex >= static_cast<int>(RowModel.Rows.size()))
+		return;
+
+	// Rows have the same pitch, so row position is known without submitting rows before it.
+	float RowTop = RowsStartY + RowIndex * RowPitch;
+	float ScrollY = ImGui::GetScrollY();
+	float ViewHeight = ImGui::GetWindowHeight();
+
+	if (Alignment >= 0.0f)
+	{
+		ImGui::SetScrollY(std::max(0.0f, RowTop - (ViewHeight - NodeHeight) * Alignment));
+	}
+	else if (RowTop < ScrollY)
+	{
+		ImGui::SetScrollY(RowTop);
+	}
+	else if (RowTop + RowPitch > ScrollY + ViewHeight)
+	{
+		ImGui::SetScrollY(RowTop + RowPitch - ViewHeight);
+	}
+}
+
+void FESceneGraphUI::ScrollToNode(FENaiveSceneGraphNode* Node, float Alignment)
+{
+	if (Node == nullptr)
+		return;
+
+	// Node that already has a row does not need ancestors expansion, so rows stay valid.
+	std::string NodeID = Node->GetObjectID();
+	if (RowModel.FindRowIndex(NodeID) == -1 || bRowsDirty || !PendingRowSubtreeNodeIDs.empty())
+		ExpandToNode(Node);
+
+	// Scroll is applied in Render, after rows are rebuilt, so only the last request in a frame is used.
+	NodeIDToScrollTo = NodeID;
+	ScrollToNodeAlignment = Alignment;
+}
+
+void FESceneGraphUI::HoistNode(FENaiveSceneGraphNode* Node)
+{
+	HoistedNodeID = Node == nullptr ? "" : Node->GetObjectID();
+}
+
+FENaiveSceneGraphNode* FESceneGraphUI::GetHoistedNode()
+{
+	if (HoistedNodeID.empty())
+		return nullptr;
+
+	return FindNodeByID(HoistedNodeID);
+}
+
+bool FESceneGraphUI::IsBreadcrumbsVisible() const
+{
+	return bRenderBreadcrumbs;
+}
+
+void FESceneGraphUI::SetBreadcrumbsVisible(bool bNewValue)
+{
+	bRenderBreadcrumbs = bNewValue;
+}
+
+size_t FESceneGraphUI::GetMaxRootViews() const
+{
+	return MaxRootViews;
+}
+
+void FESceneGraphUI::SetMaxRootViews(size_t NewValue)
+{
+	MaxRootViews = NewValue;
+	while (RootViewOrder.size() > MaxRootViews)
+	{
+		RootViews.erase(RootViewOrder.front());
+		RootViewOrder.pop_front();
+	}
+}
+
+FENaiveSceneGraphNode* FESceneGraphUI::GetEffectiveRenderingRoot(FENaiveSceneGraphNode* RequestedRoot, bool& bInOutRenderRootItself)
+{
+	if (HoistedNodeID.empty() || RequestedRoot == nullptr)
+		return RequestedRoot;
+
+	FENaiveSceneGraphNode* HoistedNode = FindNodeByID(HoistedNodeID);
+	bool bInsideOfRequestedRoot = false;
+	for (FENaiveSceneGraphNode* Node = HoistedNode; Node != nullptr; Node = Node->GetParent())
+	{
+		if (Node == RequestedRoot)
+		{
+			bInsideOfRequestedRoot = true;
+			break;
+		}
+	}
+
+	// Hoisted node was deleted or moved out of requested root.
+	if (!bInsideOfRequestedRoot || HoistedNode == RequestedRoot)
+	{
+		HoistedNodeID = "";
+		return RequestedRoot;
+	}
+
+	// Hoisted node itself is the last breadcrumb.
+	bInOutRenderRootItself = false;
+	return HoistedNode;
+}
+
+void FESceneGraphUI::RenderBreadcrumbs(FENaiveSceneGraphNode* RequestedRoot)
+{
+	std::vector<FENaiveSceneGraphNode*> Path;
+	for (FENaiveSceneGraphNode* Node = RenderingRoot; Node != nullptr; Node = Node->GetParent())
+	{
+		Path.push_back(Node);
+		if (Node == RequestedRoot)
+			break;
+	}
+	std::reverse(Path.begin(), Path.end());
+
+	ImGui::PushID("##Breadcrumbs");
+	for (size_t i = 0; i < Path.size(); i++)
+	{
+		if (i > 0)
+		{
+			ImGui::SameLine();
+			ImGui::TextUnformatted(">");
+			ImGui::SameLine();
+		}
+
+		std::string DisplayName = GetNodeDisplayName(Path[i]);
+		if (i == Path.size() - 1)
+		{
+			ImGui::TextUnformatted(DisplayName.c_str());
+			break;
+		}
+
+		ImGui::PushID(static_cast<int>(i));
+		if (ImGui::SmallButton(DisplayName.c_str()))
+			HoistNode(i == 0 ? nullptr : Path[i]);
+		ImGui::PopID();
+	}
+	ImGui::PopID();
+}
+
+bool FESceneGraphUI::IsRowAlerted(const FESceneGraphUIRow& Row) const
+{
+	for (size_t i = 0; i < Row.Widgets.size(); i++)
+	{
+		if (Row.Widgets[i].WidgetIndex < NodeWidgets.size() && NodeWidgets[Row.Widgets[i].WidgetIndex].bIsAlert)
+			return true;
+	}
+
+	return false;
+}
+
+void FESceneGraphUI::UpdateMinimap()
+{
+	if (Minimap.IsBuiltFrom(RowModel))
+		return;
+
+	// Selection changes that keep rows in place are applied to the minimap together with rows,
+	// so it is rebuilt only when rows were rebuilt, moved or restored for another rendering root.
+	FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, "Minimap");
+	Minimap.Reset(RowModel);
+	const std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	for (size_t i = 0; i < Rows.size(); i++)
+	{
+		if (Rows[i].Type != FE_SCENE_GRAPH_UI_ROW_NODE)
+			continue;
+
+		if (Rows[i].bSelected)
+			Minimap.AddMark(i, FE_SCENE_GRAPH_MINIMAP_MARK_SELECTION);
+
+		if (Rows[i].bFilterMatch)
+			Minimap.AddMark(i, FE_SCENE_GRAPH_MINIMAP_MARK_FILTER_MATCH);
+
+		if (IsRowAlerted(Rows[i]))
+			Minimap.AddMark(i, FE_SCENE_GRAPH_MINIMAP_MARK_ALERT);
+	}
+}
+
+void FESceneGraphUI::RenderMinimap(ImVec2 Size)
+{
+	if (Size.x <= 0.0f || Size.y <= 0.0f)
+		return;
+
+	UpdateMinimap();
+
+	ImVec2 MinimapMin = ImGui::GetCursorScreenPos();
+	ImVec2 MinimapMax = ImVec2(MinimapMin.x + Size.x, MinimapMin.y + Size.y);
+	ImGui::InvisibleButton("##SceneGraphMinimap", Size);
+
+	ImDrawList* DrawList = ImGui::GetWindowDrawList();
+	DrawList->AddRectFilled(MinimapMin, MinimapMax, ImColor(BackgroundColor));
+
+	// Each kind of mark has its own lane, so they do not hide each other.
+	const ImVec4 MarkColors[FE_SCENE_GRAPH_MINIMAP_MARK_COUNT] = { MinimapSelectionMarkColor, MinimapFilterMatchMarkColor, MinimapAlertMarkColor };
+	size_t Resolution = Minimap.GetResolution();
+	float BucketHeight = Size.y / Resolution;
+	float MarkHeight = std::max(BucketHeight, 2.0f);
+	float LaneWidth = Size.x / FE_SCENE_GRAPH_MINIMAP_MARK_COUNT;
+	for (size_t i = 0; i < Resolution; i++)
+	{
+		float MarkTopY = MinimapMin.y + i * BucketHeight;
+		for (size_t j = 0; j < FE_SCENE_GRAPH_MINIMAP_MARK_COUNT; j++)
+		{
+			if (Minimap.GetMarkCount(i, static_cast<FE_SCENE_GRAPH_MINIMAP_MARK>(j)) == 0)
+				continue;
+
+			float LaneMinX = MinimapMin.x + j * LaneWidth;
+			DrawList->AddRectFilled(ImVec2(LaneMinX, MarkTopY), ImVec2(LaneMinX + LaneWidth, std::min(MarkTopY + MarkHeight, MinimapMax.y)), ImColor(MarkColors[j]));
+		}
+	}
+
+	float ContentHeight = LastListBoxScrollMaxY + LastListBoxHeight;
+	if (ContentHeight > 0.0f)
+	{
+		float ViewportTopY = MinimapMin.y + Size.y * LastListBoxScrollY / ContentHeight;
+		float ViewportBottomY = MinimapMin.y + Size.y * (LastListBoxScrollY + LastListBoxHeight) / ContentHeight;
+		DrawList->AddRect(ImVec2(MinimapMin.x, ViewportTopY), ImVec2(MinimapMax.x, ViewportBottomY), ImGui::GetColorU32(ImGuiCol_Text, 0.5f));
+	}
+
+	size_t RowCount = Minimap.GetRowCount();
+	if (!ImGui::IsItemActive() || RowCount == 0)
+		return;
+
+	float Fraction = std::max(0.0f, std::min((ImGui::GetMousePos().y - MinimapMin.y) / Size.y, 1.0f));
+	size_t RowIndex = std::min(static_cast<size_t>(Fraction * RowCount), RowCount - 1);
+
+	// Single marked row in a bucket is easy to miss, so click jumps to the first marked row of the bucket.
+	size_t BucketIndex = Minimap.GetBucketIndex(RowIndex);
+	if (ImGui::IsItemClicked() && Minimap.IsBucketMarked(BucketIndex))
+	{
+		size_t FirstRowIndex = 0;
+		size_t BucketRowCount = 0;
+		Minimap.GetBucketRowRange(BucketIndex, FirstRowIndex, BucketRowCount);
+		for (size_t i = FirstRowIndex; i < FirstRowIndex + BucketRowCount; i++)
+		{
+			const FESceneGraphUIRow& Row = RowModel.Rows[i];
+			if (Row.Type == FE_SCENE_GRAPH_UI_ROW_NODE && (Row.bSelected || Row.bFilterMatch || IsRowAlerted(Row)))
+			{
+				RowIndex = i;
+				break;
+			}
+		}
+	}
+
+	RowIndexToScrollTo = static_cast<int>(RowIndex);
+}
+
+void FESceneGraphUI::GetIconDrawData(FETexture* Icon, ImTextureID& OutTextureID, ImVec2& OutUV0, ImVec2& OutUV1)
+{
+	OutTextureID = Icon->GetTextureID();
+	OutUV0 = ImVec2(0.0f, 0.0f);
+	OutUV1 = ImVec2(1.0f, 1.0f);
+	if (!bIconAtlasEnabled)
+		return;
+
+	const FESceneGraphIconAtlasEntry* Entry = IconAtlas.GetEntry(Icon);
+	if (Entry == nullptr)
+	{
+		IconAtlas.AddIcon(Icon);
+		return;
+	}
+
+	// Resized texture surely has different content, other changes should be reported with RefreshIconInAtlas.
+	if (Entry->SourceWidth != Icon->GetWidth() || Entry->SourceHeight != Icon->GetHeight())
+	{
+		IconAtlas.RefreshIcon(Icon);
+		return;
+	}
+
+	FETexture* AtlasTexture = IconAtlas.GetTexture();
+	if (AtlasTexture == nullptr || !Entry->bUploaded)
+		return;
+
+	OutTextureID = AtlasTexture->GetTextureID();
+	OutUV0 = Entry->UV0;
+	OutUV1 = Entry->UV1;
+}
+
+bool FESceneGraphUI::IsIconAtlasEnabled() const
+{
+	return bIconAtlasEnabled;
+}
+
+void FESceneGraphUI::SetIconAtlasEnabled(bool bNewValue)
+{
+	bIconAtlasEnabled = bNewValue;
+}
+
+bool FESceneGraphUI::RegisterIconInAtlas(FETexture* Icon)
+{
+	return IconAtlas.AddIcon(Icon);
+}
+
+void FESceneGraphUI::RefreshIconInAtlas(FETexture* Icon)
+{
+	IconAtlas.RefreshIcon(Icon);
+}
+
+void FESceneGraphUI::ClearIconAtlas()
+{
+	IconAtlas.Clear();
+}
+
+FETexture* FESceneGraphUI::GetIconAtlasTexture() const
+{
+	return IconAtlas.GetTexture();
+}
+
+bool FESceneGraphUI::IsMinimapVisible() const
+{
+	return bMinimapVisible;
+}
+
+void FESceneGraphUI::SetMinimapVisible(bool bNewValue)
+{
+	bMinimapVisible = bNewValue;
+}
+
+size_t FESceneGraphUI::GetMinimapResolution() const
+{
+	return Minimap.GetResolution();
+}
+
+void FESceneGraphUI::SetMinimapResolution(size_t NewValue)
+{
+	Minimap.SetResolution(NewValue);
+}
+
+const FESceneGraphMinimap& FESceneGraphUI::GetMinimap()
+{
+	UpdateMinimap();
+	return Minimap;
+}
+
+std::vector<int> FESceneGraphUI::GetStickyAncestorRowIndices(size_t FirstVisibleRowIndex) const
+{
+	std::vector<int> Result;
+	const std::vector<FESceneGraphUIRow>& Rows = RowModel.Rows;
+	if (MaxStickyAncestorHeaders == 0 || FirstVisibleRowIndex == 0 || FirstVisibleRowIndex >= Rows.size())
+		return Result;
+
+	// Headers cover rows at the top, so context is taken from the first row below them.
+	size_t HeaderCount = 0;
+	int AncestorRowIndex = Rows[FirstVisibleRowIndex].ParentRowIndex;
+	while (AncestorRowIndex != -1 && HeaderCount < MaxStickyAncestorHeaders)
+	{
+		HeaderCount++;
+		AncestorRowIndex = Rows[AncestorRowIndex].ParentRowIndex;
+	}
+
+	size_t TopRowIndex = std::min(FirstVisibleRowIndex + HeaderCount, Rows.size() - 1);
+	AncestorRowIndex = Rows[TopRowIndex].ParentRowIndex;
+	while (AncestorRowIndex != -1 && Result.size() < MaxStickyAncestorHeaders)
+	{
+		Result.push_back(AncestorRowIndex);
+		AncestorRowIndex = Rows[AncestorRowIndex].ParentRowIndex;
+	}
+
+	// Nearest ancestors that are visible below the headers do not need a header.
+	while (!Result.empty() && static_cast<size_t>(Result.front()) >= FirstVisibleRowIndex + Result.size())
+		Result.erase(Result.begin());
+
+	std::reverse(Result.begin(), Result.end());
+	return Result;
+}
+
+void FESceneGraphUI::RenderStickyAncestorHeaders(float RowPitch)
+{
+	if (!bStickyAncestorHeaders || RowPitch <= 0.0f)
+		return;
+
+	// Rows start below list box padding, so it is subtracted like for connector lines.
+	float ScrollY = ImGui::GetScrollY();
+	float RowsScrollY = std::max(ScrollY - RowsStartY, 0.0f);
+	std::vector<int> AncestorRowIndices = GetStickyAncestorRowIndices(static_cast<size_t>(RowsScrollY / RowPitch));
+	if (AncestorRowIndices.empty())
+		return;
+
+	FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, "StickyHeaders");
+	ImVec2 OldCursorPos = ImGui::GetCursorPos();
+	float HeadersTopY = ScrollY + RowsStartY;
+	float WindowMinX = ImGui::GetWindowPos().x;
+	float WindowMaxX = WindowMinX + ImGui::GetWindowWidth();
+
+	ImDrawList* DrawList = ImGui::GetWindowDrawList();
+	DrawList->ChannelsSetCurrent(FE_SCENE_GRAPH_UI_DRAW_CHANNEL_STICKY_HEADERS);
+	// Ancestor rows could be submitted by the clipper too, so headers need their own ID scope.
+	ImGui::PushID("##StickyAncestorHeaders");
+	for (size_t i = 0; i < AncestorRowIndices.size(); i++)
+	{
+		int RowIndex = AncestorRowIndices[i];
+		const FESceneGraphUIRow& Row = RowModel.Rows[RowIndex];
+
+		ImGui::SetCursorPos(ImVec2(OldCursorPos.x, HeadersTopY + i * RowPitch));
+		float HeaderScreenY = ImGui::GetCursorScreenPos().y;
+		DrawList->AddRectFilled(ImVec2(WindowMinX, HeaderScreenY), ImVec2(WindowMaxX, HeaderScreenY + RowPitch), ImColor(BackgroundColor));
+		ImGui::SetCursorPosX(ImGui::GetCursorPosX() + Row.Indentation * NodeHeight);
+
+		DrawAppropriateTreeArrow(Row);
+
+		float HeaderBodyWidth = ImGui::GetContentRegionAvail().x - ImGui::GetStyle().WindowPadding.x;
+		std::string Label = APPLICATION.TruncateText(Row.DisplayName, HeaderBodyWidth) + "##" + Row.NodeID + Row.GroupKey;
+		if (ImGui::Selectable(Label.c_str(), Row.bSelected, ImGuiSelectableFlags_None, ImVec2(HeaderBodyWidth, NodeHeight)))
+		{
+			SetFocusedRow(RowIndex);
+			ScrollToRow(RowIndex, RowPitch, 0.0f);
+		}
+	}
+	ImGui::PopID();
+
+	float HeadersBottomY = ImGui::GetWindowPos().y - ScrollY + HeadersTopY + AncestorRowIndices.size() * RowPitch;
+	DrawList->AddLine(ImVec2(WindowMinX, HeadersBottomY), ImVec2(WindowMaxX, HeadersBottomY), ImGui::GetColorU32(ImGuiCol_Separator));
+
+	DrawList->ChannelsSetCurrent(FE_SCENE_GRAPH_UI_DRAW_CHANNEL_DEFAULT);
+	ImGui::SetCursorPos(OldCursorPos);
+
+	// Arrow button and selectable for each header.
+	FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, FE_SCENE_GRAPH_UI_COUNTER_IMGUI_ITEMS, AncestorRowIndices.size() * 2);
+}
+
+bool FESceneGraphUI::IsStickyAncestorHeadersEnabled() const
+{
+	return bStickyAncestorHeaders;
+}
+
+void FESceneGraphUI::SetStickyAncestorHeadersEnabled(bool bNewValue)
+{
+	bStickyAncestorHeaders = bNewValue;
+}
+
+size_t FESceneGraphUI::GetMaxStickyAncestorHeaders() const
+{
+	return MaxStickyAncestorHeaders;
+}
+
+void FESceneGraphUI::SetMaxStickyAncestorHeaders(size_t NewValue)
+{
+	MaxStickyAncestorHeaders = NewValue;
+}
+
+bool FESceneGraphUI::IsNodeDragAndDropEnabled() const
+{
+	return bNodeDragAndDropEnabled;
+}
+
+void FESceneGraphUI::SetNodeDragAndDropEnabled(bool bNewValue)
+{
+	bNodeDragAndDropEnabled = bNewValue;
+	DraggedNodeIDs.clear();
+	NodeIDToDeselectOnRelease = "";
+}
+
+void FESceneGraphUI::HandleNodeDragAndDrop(size_t RowIndex)
+{
+	const FESceneGraphUIRow& Row = RowModel.Rows[RowIndex];
+	// Payload carries the panel, so nodes could be dropped only on the panel they were dragged from.
+	static const char* PayloadType = "FE_SCENE_GRAPH_UI_NODES";
+
+	if (ImGui::BeginDragDropSource())
+	{
+		if (DraggedNodeIDs.empty())
+		{
+			if (IsNodeSelected(Row.Node))
+			{
+				DraggedNodeIDs = GetSelectedNodeIDs();
+			}
+			else
+			{
+				DraggedNodeIDs.push_back(Row.NodeID);
+			}
+
+			NodeIDToDeselectOnRelease = "";
+		}
+
+		FESceneGraphUI* SourcePanel = this;
+		ImGui::SetDragDropPayload(PayloadType, &SourcePanel, sizeof(SourcePanel));
+		if (DraggedNodeIDs.size() == 1)
+		{
+			ImGui::TextUnformatted(Row.DisplayName.c_str());
+		}
+		else
+		{
+			ImGui::Text("%zu nodes", DraggedNodeIDs.size());
+		}
+		ImGui::EndDragDropSource();
+	}
+
+	if (NodeIDToDeselectOnRelease == Row.NodeID && ImGui::IsMouseReleased(ImGuiMouseButton_Left))
+	{
+		if (ImGui::IsItemHovered())
+			SetNodeSelected(Row.Node, false);
+		NodeIDToDeselectOnRelease = "";
+	}
+
+	if (ImGui::BeginDragDropTarget())
+	{
+		const ImGuiPayload* Payload = ImGui::AcceptDragDropPayload(PayloadType, ImGuiDragDropFlags_AcceptBeforeDelivery | ImGuiDragDropFlags_AcceptNoDrawDefaultRect);
+		if (Payload != nullptr && *static_cast<FESceneGraphUI**>(Payload->Data) == this)
+		{
+			// Row under the cursor becomes the new parent, so it is highlighted as a whole.
+			ImGui::GetWindowDrawList()->AddRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax(), ImGui::GetColorU32(DropIndicatorColor), 0.0f, 0, 2.0f);
+
+			if (Payload->IsDelivery())
+				DropDraggedNodes(Row.Node);
+		}
+		ImGui::EndDragDropTarget();
+	}
+}
+
+void FESceneGraphUI::DropDraggedNodes(FENaiveSceneGraphNode* NewParent)
+{
+	FEScene* TargetScene = SCENE_MANAGER.GetSceneByNodeID(NewParent->GetObjectID());
+	if (TargetScene != nullptr)
+	{
+		FESceneGraphUICommand Command;
+		Command.Type = FE_SCENE_GRAPH_UI_COMMAND_MOVE_BATCH;
+		Command.SceneID = TargetScene->GetObjectID();
+		Command.NodeIDs = std::move(DraggedNodeIDs);
+		Command.TargetNodeID = NewParent->GetObjectID();
+		QueueCommand(Command);
+		SetNodeExpanded(NewParent, true);
+	}
+
+	DraggedNodeIDs.clear();
+}
+
+bool FESceneGraphUI::IsKeyboardNavigationEnabled() const
+{
+	return bKeyboardNavigationEnabled;
+}
+
+void FESceneGraphUI::SetKeyboardNavigationEnabled(bool bNewValue)
+{
+	bKeyboardNavigationEnabled = bNewValue;
+}
+
+FENaiveSceneGraphNode* FESceneGraphUI::GetFocusedNode() const
+{
+	if (FocusedRowType != FE_SCENE_GRAPH_UI_ROW_NODE)
+		return nullptr;
+
+	return FocusedNode;
+}
+
+void FESceneGraphUI::SetFocusedNode(FENaiveSceneGraphNode* Node)
+{
+	FocusedNode = Node;
+	FocusedNodeID = Node == nullptr ? "" : Node->GetObjectID();
+	FocusedRowType = FE_SCENE_GRAPH_UI_ROW_NODE;
+	FocusedGroupKey = "";
+	ResolveFocusedRowIndex();
+	bScrollToFocusedRow = FocusedRowIndex != -1;
+}
+
+std::string FESceneGraphUI::GetFontPath() const
+{
+	return FontPath;
+}
+
+void FESceneGraphUI::SetFontPath(const std::string& NewValue)
+{
+	if (NewValue == FontPath)
+		return;
+
+	FESceneGraphUIFontCache::Release(FontPath);
+	FontPath = NewValue;
+	CousineFont = nullptr;
+	FESceneGraphUIFontCache::Acquire(FontPath);
+}
+
+float FESceneGraphUI::GetFontSize() const
+{
+	return FontSize;
+}
+
+void FESceneGraphUI::SetFontSize(float NewFontSize)
+{
+	FontSize = NewFontSize;
+	TooltipFontSize = std::max(FontSize / 2.0f, 16.0f);
+	NodeHeight = FontSize;
+	IconsSize = ImVec2(FontSize, FontSize);
+
+	// Atlas cells should not be smaller than icons on screen, otherwise icons are blurry.
+	// Cell size grows in powers of two, so scaling does not repack the atlas on every change.
+	int RequiredIconSize = IconAtlas.GetMaxIconSize();
+	while (static_cast<float>(RequiredIconSize) < std::max(IconsSize.x, IconsSize.y))
+		RequiredIconSize *= 2;
+
+	if (RequiredIconSize != IconAtlas.GetMaxIconSize())
+	{
+		IconAtlas.SetMaxIconSize(RequiredIconSize);
+		IconAtlas.Clear();
+	}
+
+	MarkRowsDirty();
+}
+
+void FESceneGraphUI::DebugCreateRandomWidgets(bool bInteractive)
+{
+	FETexture* RandomIcon = GetRandomDebugIcon();
+	FESceneGraphNodeWidget NewDebugWidget;
+	NewDebugWidget.Icon = RandomIcon;
+	NewDebugWidget.bIsInteractive = bInteractive;
+
+	NewDebugWidget.IsVisiblePredicate = [WidgetID = NewDebugWidget.GetID()](FENaiveSceneGraphNode* Node) -> bool {
+		FEEntity* CurrentEntity = Node->GetEntity();
+		if (CurrentEntity == nullptr)
+			return true;
+
+		size_t Seed = std::hash<std::string>{}(CurrentEntity->GetObjectID() + WidgetID);
+		srand(static_cast<unsigned int>(Seed));
+
+		float RandomValue = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+		if (RandomValue < 0.6f)
+			return true;
+		else
+			return false;
+	};
+
+	bool AlreadyExistingWidgetWithSameProperties = false;
+	for (size_t i = 0; i < DebugNodeWidgets.size(); i++)
+	{
+		if (DebugNodeWidgets[i].Icon->GetObjectID() == NewDebugWidget.Icon->GetObjectID() && DebugNodeWidgets[i].bIsInteractive == NewDebugWidget.bIsInteractive)
+			AlreadyExistingWidgetWithSameProperties = true;
+	}
+
+	if (!AlreadyExistingWidgetWithSameProperties)
+	{
+		AddNodeWidget(NewDebugWidget);
+		DebugNodeWidgets.push_back(NewDebugWidget);
+	}
+}
+
+void FESceneGraphUI::DebugRenderUI()
+{
+	if (ImGui::Button("Expand all"))
+		ExpandAllNodes();
+	
+	if (ImGui::Button("Collapse all"))
+		CollapseAllNodes();
+
+	if (ImGui::Button("Bulk rename selected"))
+		OpenBulkRenamePopup();
+
+	ImGui::BeginDisabled(!CanUndoViewOperation());
+	if (ImGui::Button("Undo"))
+		UndoViewOperation();
+	ImGui::EndDisabled();
+
+	ImGui::SameLine();
+	ImGui::BeginDisabled(!CanRedoViewOperation());
+	if (ImGui::Button("Redo"))
+		RedoViewOperation();
+	ImGui::EndDisabled();
+
+	ImGui::Checkbox("Render root", &bDebugRenderRoot);
+
+	// Provider is changed only when checkbox is toggled, otherwise rows would be rebuilt every frame.
+	bool bRandomNodeIconsToggled = ImGui::Checkbox("Render random icons", &bDebugRenderRandomNodeIcons);
+	if (bRandomNodeIconsToggled && bDebugRenderRandomNodeIcons)
+	{
+		SetNodeIconProvider([this] (FENaiveSceneGraphNode* Node) -> FETexture* {
+			FEEntity* CurrentEntity = Node->GetEntity();
+			if (CurrentEntity == nullptr)
+				return nullptr;
+
+			// More elegant solution without rand().
+			size_t Hash = std::hash<std::string>{}(CurrentEntity->GetObjectID());
+			size_t IconCount = DebugIconsIDs.size();
+			if (IconCount == 0)
+				return nullptr;
+
+			// +1 to include a "no icon" option.
+			size_t Index = Hash % (IconCount + 1);
+			if (Index >= IconCount)
+				return nullptr;
+
+			return GetDebugIconByIndex(Index);
+		});
+	}
+	else if (bRandomNodeIconsToggled)
+	{
+		SetNodeIconProvider(nullptr);
+	}
+
+	if (ImGui::Button("Clear Widgets"))
+		ClearNodeWidgets();
+
+	ImGui::SameLine();
+	if (ImGui::Button("Add interactive widget"))
+		DebugCreateRandomWidgets(true);
+	
+	ImGui::SameLine();
+	if (ImGui::Button("Add non interactive widget"))
+		DebugCreateRandomWidgets(false);
+
+	ImGui::Checkbox("Show minimap", &bMinimapVisible);
+	ImGui::SameLine();
+	ImGui::Checkbox("Show profiler", &bDebugShowProfilerOverlay);
+	if (bDebugShowProfilerOverlay)
+		RenderProfilerOverlay();
+}
+
+void FESceneGraphUI::RenderContextMenu()
+{
+	FEScene* CurrentScene = GetScene();
+	if (CurrentScene == nullptr)
+		return;
+
+	if (bShouldOpenContextMenu)
+	{
+		HoveredNodeIDWhenContextMenuWasOpened = HoveredNodeID;
+		ImGui::OpenPopup(("##Scene Graph Context Menu " + CurrentScene->GetObjectID()).c_str());
+	}	
+
+	bShouldOpenContextMenu = false;
+
+	if (ImGui::BeginPopup(("##Scene Graph Context Menu " + CurrentScene->GetObjectID()).c_str()))
+	{
+		FENaiveSceneGraphNode* ContextNode = FindNodeByID(HoveredNodeIDWhenContextMenuWasOpened);
+		if (ContextMenuRenderingFunction)
+		{
+			FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, "ContextMenu");
+			ContextMenuRenderingFunction(ContextNode);
+		}
+		else
+		{
+			ImGui::TextUnformatted("No context menu rendering function set.");
+		}
+		
+		ImGui::EndPopup();
+	}
+	else
+	{
+		// Popup was closed (either by user dismissing or item selected).
+		HoveredNodeIDWhenContextMenuWasOpened = "";
+	}
+}
+
+void FESceneGraphUI::Render(FENaiveSceneGraphNode* RenderingRoot, bool bRenderRootItself)
+{
+	// Loaders keep queueing commands while panel is hidden or has nothing to show, so they are applied before any early return.
+	ApplyDeferredCommands();
+	if (!bVisible)
+		return;
+
+	// If in debug mode ignore the provided inputs.
+	if (IsInDebugMode())
+	{
+		if (GetTestScene() == nullptr)
+			return;
+
+		RenderingRoot = GetTestScene()->SceneGraph.GetRoot();
+		bRenderRootItself = bDebugRenderRoot;
+
+		DebugRenderUI();
+	}
+
+	if (RenderingRoot == nullptr)
+		return;
+
+	FEScene* CurrentScene = SCENE_MANAGER.GetSceneByNodeID(RenderingRoot->GetObjectID());
+	if (CurrentScene == nullptr)
+		return;
+
+	FE_SCENE_GRAPH_UI_PROFILE_FRAME(Profiler);
+	FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, "Render");
+	CurrentSceneID = CurrentScene->GetObjectID();
+	HoveredNodeID = "";
+	SyncWithChangeJournal();
+	ViewHistory.CommitPendingStep();
+
+	// Drag was cancelled or nodes were dropped outside of the panel.
+	if (!DraggedNodeIDs.empty() && ImGui::GetDragDropPayload() == nullptr)
+		DraggedNodeIDs.clear();
+
+	bool bEffectiveRenderRootItself = bRenderRootItself;
+	FENaiveSceneGraphNode* EffectiveRoot = GetEffectiveRenderingRoot(RenderingRoot, bEffectiveRenderRootItself);
+	SetRenderingRootInternal(EffectiveRoot, bEffectiveRenderRootItself);
+
+	// Host window is collapsed or completely clipped, nothing would be visible, so we only keep up with scene changes.
+	ImGuiWindow* HostWindow = ImGui::GetCurrentWindowRead();
+	if (HostWindow != nullptr && HostWindow->SkipItems)
+	{
+		SyncWithChangeJournal();
+		return;
+	}
+
+	// Atlas texture is recreated before any row of this frame references it.
+	if (bIconAtlasEnabled)
+		IconAtlas.UpdateTexture();
+
+	if (CousineFont == nullptr && !FontPath.empty())
+		CousineFont = FESceneGraphUIFontCache::GetFont(FontPath);
+
+	if (bRenderTextFilterInput)
+	{
+		FE_SCENE_GRAPH_UI_TRACE_SPAN(TraceSink, "FilterInput");
+		RenderFilterTextInput();
+	}
+
+	if (bRenderUIScaleControl)
+	{
+		if (bRenderTextFilterInput)
+			ImGui::SameLine();
+
+		RenderUIScaleControl();
+	}
+
+	if (bRenderBreadcrumbs && this->RenderingRoot != RenderingRoot)
+		RenderBreadcrumbs(RenderingRoot);
+
+	ImVec2 ListBoxSize = ImGui::GetContentRegionAvail();
+	if (bMinimapVisible)
+		ListBoxSize.x -= MinimapWidth + ImGui::GetStyle().ItemSpacing.x;
+
+	ImGui::PushStyleColor(ImGuiCol_FrameBg, BackgroundColor);
+	if (ImGui::BeginListBox(("##Scene Graph" + RenderingRoot->GetObjectID()).c_str(), ListBoxSize))
+	{
+		// Everything that is not batched is drawn to the default channel.
+		ImGui::GetWindowDrawList()->ChannelsSplit(FE_SCENE_GRAPH_UI_DRAW_CHANNEL_COUNT);
+		ImGui::GetWindowDrawList()->ChannelsSetCurrent(FE_SCENE_GRAPH_UI_DRAW_CHANNEL_DEFAULT);
+
+		if (CousineFont != nullptr)
+			ImGui::PushFont(CousineFont, GetFontSize());
+
+		// Scene graph is traversed only when something has changed, idle frames reuse rows from previous frames.
+		if (ShouldRebuildRows())
+		{
+			RebuildRows();
+		}
+		else
+		{
+			ApplyPendingRowUpdates();
+		}
+
+		// Only rows that intersect visible part of the list box are submitted to ImGui.
+		// ListClipper also takes care of the full content height, so scrollbar stays correct.
+		float RowPitch = NodeHeight + ImGui::GetStyle().ItemSpacing.y;
+		RowsStartY = ImGui::GetCursorPosY();
+		ImGuiListClipper Clipper;
+		Clipper.Begin(static_cast<int>(RowModel.GetRowCount()), RowPitch);
+
+		if (bKeyboardNavigationEnabled && NodeIDBeingRenamed.empty() && !ImGui::GetIO().WantTextInput && ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows))
+			HandleKeyboardNavigation(RowPitch);
+
+		if (bViewHistoryShortcutsEnabled && NodeIDBeingRenamed.empty() && !ImGui::GetIO().WantTextInput && ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows))
+			HandleViewHistoryShortcuts();
+
+		// Scroll that was remembered for this rendering root, explicit scroll requests below take priority.
+		if (PendingScrollY >= 0.0f)
+		{
+			ImGui::SetScrollY(PendingScrollY);
+			PendingScrollY = -1.0f;
+			bPendingScrollExplicit = false;
+		}
+
+		if (bScrollToFocusedRow)
+		{
+			ScrollToRow(FocusedRowIndex, RowPitch);
+			bScrollToFocusedRow = false;
+		}
+
+		if (!NodeIDToScrollTo.empty())
+		{
+			ScrollToRow(RowModel.FindRowIndex(NodeIDToScrollTo), RowPitch, ScrollToNodeAlignment);
+			NodeIDToScrollTo = "";
+		}
+
+		if (RowIndexToScrollTo != -1)
+		{
+			ScrollToRow(RowIndexToScrollTo, RowPitch, 0.5f);
+			RowIndexToScrollTo = -1;
+		}
+
+		LastListBoxScrollY = ImGui::GetScrollY();
+		LastListBoxScrollMaxY = ImGui::GetScrollMaxY();
+		LastListBoxHeight = ImGui::GetWindowHeight();
+
+		// Rename editor should be submitted even when it is scrolled out, otherwise it would lose focus.
+		if (!NodeIDBeingRenamed.empty())
+		{
+			int RenamedRowIndex = RowModel.FindRowIndex(NodeIDBeingRenamed);
+			if (RenamedRowIndex != -1)
+				Clipper.IncludeItemByIndex(RenamedRowIndex);
+		}
+
+		FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_DRAW_SUBMISSION);
+		RenderStickyAncestorHeaders(RowPitch);
+
+		size_t FirstVisibleRowIndex = 0;
+		size_t VisibleRowCount = 0;
+		RowModel.GetRowRangeInScrollWindow(ImGui::GetScrollY() - RowsStartY, ImGui::GetWindowHeight(), RowPitch, FirstVisibleRowIndex, VisibleRowCount);
+		DrawTreeConnectorLines(FirstVisibleRowIndex, VisibleRowCount, RowPitch);
+
+		while (Clipper.Step())
+		{
+			for (int i = Clipper.DisplayStart; i < Clipper.DisplayEnd; i++)
+				RenderRow(static_cast<size_t>(i), RowPitch);
+		}
+		Clipper.End();
+		FlushRowBackgroundBatch();
+		
+		if (CousineFont != nullptr)
+			ImGui::PopFont();
+
+		// Channels were split on the list box draw list, so they should be merged before leaving it.
+		ImGui::GetWindowDrawList()->ChannelsMerge();
+		ImGui::EndListBox();
+	}
+	ImGui::PopStyleColor();
+
+	if (bMinimapVisible)
+	{
+		ImGui::SameLine();
+		RenderMinimap(ImVec2(MinimapWidth, ListBoxSize.y));
+	}
+
+	bSceneGraphWindowHovered = ImGui::IsWindowHovered(ImGuiHoveredFlags_AllowWhenBlockedByActiveItem | ImGuiHoveredFlags_ChildWindows);
+	if (bSceneGraphWindowHovered && ImGui::IsMouseClicked(ImGuiMouseButton_Right))
+		bShouldOpenContextMenu = true;
+
+	RenderContextMenu();
+	RenderBulkRenamePopup();
+
+	// Traversal is finished, now it is safe to modify the scene graph.
+	ApplyDeferredCommands();
+	SyncWithChangeJournal();
+}
+
+void FESceneGraphUI::ExpandAllNodes()
+{
+	SetSubtreeExpanded(RenderingRoot, true);
+}
+
+void FESceneGraphUI::CollapseAllNodes()
+{
+	SetSubtreeExpanded(RenderingRoot, false);
+}
+
+void FESceneGraphUI::SetSubtreeExpanded(FENaiveSceneGraphNode* Root, bool bExpanded)
+{
+	if (Root == nullptr)
+		return;
+
+	// Nodes without state are collapsed, so collapsing does not need to add state for them.
+	std::vector<std::string> ExpandedNodeIDsBefore;
+	std::vector<FENaiveSceneGraphNode*> Stack;
+	Stack.push_back(Root);
+	while (!Stack.empty())
+	{
+		FENaiveSceneGraphNode* CurrentNode = Stack.back();
+		Stack.pop_back();
+
+		auto Iterator = NodeState.find(CurrentNode->GetObjectID());
+		if (Iterator != NodeState.end())
+		{
+			if (Iterator->second.bExpanded && ViewHistory.IsRecording())
+				ExpandedNodeIDsBefore.push_back(Iterator->first);
+
+			Iterator->second.bExpanded = bExpanded;
+		}
+		else if (bExpanded)
+		{
+			NodeState[CurrentNode->GetObjectID()].bExpanded = true;
+		}
+
+		for (FENaiveSceneGraphNode* Child : CurrentNode->GetChildren())
+			Stack.push_back(Child);
+	}
+
+	ViewHistory.RecordSubtreeExpansion(Root->GetObjectID(), bExpanded, ExpandedNodeIDsBefore);
+	MarkRowsDirty();
+}
+
+void FESceneGraphUI::ApplyViewHistoryStep(const FESceneGraphViewHistoryStep& Step, bool bUndo)
+{
+	ViewHistory.SetRecording(false);
+
+	const size_t OperationCount = Step.Operations.size();
+	for (size_t i = 0; i < OperationCount; i++)
+	{
+		const FESceneGraphViewHistoryOperation& Operation = Step.Operations[bUndo ? OperationCount - 1 - i : i];
+		if (Operation.Type == FE_SCENE_GRAPH_VIEW_HISTORY_NODE_CHANGES)
+		{
+			std::vector<uint64_t> Records = FESceneGraphViewHistory::DecodeVarints(Operation.Data);
+			for (size_t j = 0; j < Records.size(); j++)
+			{
+				const uint64_t Record = Records[bUndo ? Records.size() - 1 - j : j];
+				const std::string& NodeID = ViewHistory.GetNodeID(static_cast<uint32_t>(Record / 4));
+				const bool bValue = (Record % 2 == 1) != bUndo;
+
+				// Node could be deleted after the step was recorded.
+				FENaiveSceneGraphNode* Node = FindNodeByID(NodeID);
+				if (Node == nullptr)
+					continue;
+
+				if ((Record / 2) % 2 == FE_SCENE_GRAPH_VIEW_HISTORY_FIELD_EXPANDED)
+				{
+					NodeState[NodeID].bExpanded = bValue;
+				}
+				else
+				{
+					// Undo and redo should restore selection, not the expansion that selecting would cause.
+					SetNodeSelectionState(Node, bValue);
+				}
+			}
+		}
+		else if (Operation.Type == FE_SCENE_GRAPH_VIEW_HISTORY_SUBTREE_EXPANSION)
+		{
+			FENaiveSceneGraphNode* Root = FindNodeByID(ViewHistory.GetNodeID(Operation.SubtreeRootIndex));
+			if (Root == nullptr)
+				continue;
+
+			if (!bUndo)
+			{
+				SetSubtreeExpanded(Root, Operation.bSubtreeExpanded);
+				continue;
+			}
+
+			SetSubtreeExpanded(Root, false);
+			std::vector<uint64_t> ExpandedNodeIndices = FESceneGraphViewHistory::DecodeVarints(Operation.Data);
+			for (size_t j = 0; j < ExpandedNodeIndices.size(); j++)
+				NodeState[ViewHistory.GetNodeID(static_cast<uint32_t>(ExpandedNodeIndices[j]))].bExpanded = true;
+		}
+		else if (Operation.Type == FE_SCENE_GRAPH_VIEW_HISTORY_FILTER)
+		{
+			SetFilterText(bUndo ? Operation.OldFilterText : Operation.NewFilterText);
+		}
+	}
+
+	ViewHistory.SetRecording(true);
+	MarkRowsDirty();
+}
+
+void FESceneGraphUI::HandleViewHistoryShortcuts()
+{
+	const ImGuiIO& IO = ImGui::GetIO();
+	if (!IO.KeyCtrl)
+		return;
+
+	if (ImGui::IsKeyPressed(ImGuiKey_Y) || (IO.KeyShift && ImGui::IsKeyPressed(ImGuiKey_Z)))
+	{
+		RedoViewOperation();
+	}
+	else if (ImGui::IsKeyPressed(ImGuiKey_Z))
+	{
+		UndoViewOperation();
+	}
+}
+
+bool FESceneGraphUI::CanUndoViewOperation() const
+{
+	return ViewHistory.HasPendingStep() || ViewHistory.CanUndo();
+}
+
+bool FESceneGraphUI::CanRedoViewOperation() const
+{
+	return !ViewHistory.HasPendingStep() && ViewHistory.CanRedo();
+}
+
+void FESceneGraphUI::UndoViewOperation()
+{
+	ViewHistory.CommitPendingStep();
+	const FESceneGraphViewHistoryStep* Step = ViewHistory.PopUndoStep();
+	if (Step != nullptr)
+		ApplyViewHistoryStep(*Step, true);
+}
+
+void FESceneGraphUI::RedoViewOperation()
+{
+	ViewHistory.CommitPendingStep();
+	const FESceneGraphViewHistoryStep* Step = ViewHistory.PopRedoStep();
+	if (Step != nullptr)
+		ApplyViewHistoryStep(*Step, false);
+}
+
+void FESceneGraphUI::ClearViewHistory()
+{
+	ViewHistory.Clear();
+}
+
+const FESceneGraphViewHistory& FESceneGraphUI::GetViewHistory() const
+{
+	return ViewHistory;
+}
+
+size_t FESceneGraphUI::GetMaxViewHistorySteps() const
+{
+	return ViewHistory.GetMaxSteps();
+}
+
+void FESceneGraphUI::SetMaxViewHistorySteps(size_t NewValue)
+{
+	ViewHistory.SetMaxSteps(NewValue);
+}
+
+bool FESceneGraphUI::IsViewHistoryShortcutsEnabled() const
+{
+	return bViewHistoryShortcutsEnabled;
+}
+
+void FESceneGraphUI::SetViewHistoryShortcutsEnabled(bool bNewValue)
+{
+	bViewHistoryShortcutsEnabled = bNewValue;
+}
+
+bool FESceneGraphUI::IsInDebugMode()
+{
+	return bDebugMode;
+}
+
+bool FESceneGraphUI::InitiateTestScene()
+{
+	FEScene* SceneToWorkWith = GetTestScene();
+	if (SceneToWorkWith == nullptr)
+		return false;
+
+	std::vector<FENaiveSceneGraphNode*> Nodes;
+	for (size_t i = 0; i < 30; i++)
+	{
+		FEEntity* Entity = SceneToWorkWith->CreateEntity("Node_" + std::to_string(i));
+		Nodes.push_back(SceneToWorkWith->SceneGraph.GetNodeByEntityID(Entity->GetObjectID()));
+	}
+
+	// Create a hierarchy:
+	//
+	//                  0
+	//          /       |       \
+    //         1        2        3
+	//       / | \    / | \    / | \
+    //      4  5  6  7  8  9  10 11 12
+	//     /\  |     |  |  |   |  |  |\
+    //   13 14 15   16 17 18  19 20 21 22
 	//   |     |     |     |      |  |  \
     //  23    24    25    26      27 28  29
 
@@ -1184,204 +3463,825 @@ bool FESceneGraphUI::InitiateTestScene()
 	return true;
 }
 
-void FESceneGraphUI::SetDebugMode(bool bNewValue)
+void FESceneGraphUI::SetDebugMode(bool bNewValue)
+{
+	bool bModeChanged = bDebugMode != bNewValue;
+	bDebugMode = bNewValue;
+
+	if (bModeChanged)
+	{
+		NodeState.clear();
+		SelectedNodeIDSet.clear();
+		ViewHistory.Clear();
+		MarkRowsDirty();
+
+		if (bDebugMode)
+		{
+			FEScene* NewScene = SCENE_MANAGER.CreateScene("Test scene");
+			TestSceneID = NewScene->GetObjectID();
+			ClearAllCallbacks();
+			ClearNodeWidgets();
+
+			InitiateTestScene();
+		}
+		else
+		{
+			ClearAllCallbacks();
+			ClearNodeWidgets();
+			DebugNodeWidgets.clear();
+
+			FEScene* TestScene = GetTestScene();
+			if (TestScene != nullptr)
+			{
+				FESceneGraphChangeJournal::RemoveForScene(TestScene->GetObjectID());
+				FESceneGraphCommandQueue::RemoveForScene(TestScene->GetObjectID());
+				SCENE_MANAGER.DeleteScene(TestScene);
+			}
+		}
+	}
+	
+}
+
+FEScene* FESceneGraphUI::GetTestScene()
+{
+	return SCENE_MANAGER.GetSceneByID(TestSceneID);
+}
+
+FETexture* FESceneGraphUI::GetDebugIconByIndex(const size_t& IconIndex)
+{
+	FETexture* Result = RESOURCE_MANAGER.NoTexture;
+	if (IconIndex >= DebugIconsIDs.size())
+		return Result;
+
+	FETexture* FoundTexture = RESOURCE_MANAGER.GetTexture(DebugIconsIDs[IconIndex]);
+	if (FoundTexture != nullptr)
+		Result = FoundTexture;
+
+	return Result;
+}
+
+FETexture* FESceneGraphUI::GetRandomDebugIcon()
+{
+	size_t Seed = static_cast<size_t>(time(nullptr));
+	srand(static_cast<unsigned int>(Seed));
+	if (DebugIconsIDs.size() == 0)
+		return RESOURCE_MANAGER.NoTexture;
+
+	size_t RandomIndex = rand() % DebugIconsIDs.size();
+	return GetDebugIconByIndex(RandomIndex);
+}
+
+std::vector<std::string> FESceneGraphUI::GetDebugIconsIDs() const
+{
+	return DebugIconsIDs;
+}
+
+void FESceneGraphUI::SetDebugIconsIDs(const std::vector<std::string>& NewDebugIconsIDs)
+{
+	DebugIconsIDs = NewDebugIconsIDs;
+}
+
+void FESceneGraphUI::AddBeforeNodeRenderCallback(std::function<void(FENaiveSceneGraphNode*)> Callback, const std::string& Name)
+{
+	BeforeNodeRenderCallbacks.push_back({ GetCallbackRegistrationName("BeforeNodeRender", Name), Callback });
+}
+
+void FESceneGraphUI::AddAfterNodeRenderCallback(std::function<void(FENaiveSceneGraphNode*)> Callback, const std::string& Name)
+{
+	AfterNodeRenderCallbacks.push_back({ GetCallbackRegistrationName("AfterNodeRender", Name), Callback });
+}
+
+void FESceneGraphUI::RenderUIScaleControl(float Min, float Max)
+{
+	ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 4.0f);
+
+	float FrameHeight = ImGui::GetFrameHeight();
+	float TextHeight = ImGui::GetTextLineHeight();
+	float Offset = (FrameHeight - TextHeight) * 0.5f;
+
+	ImGui::Text("UI Scale");
+	ImGui::SameLine();
+	
+	ImGui::SetNextItemWidth(60.0f);
+	float LocalFontSize = FontSize;
+	ImGui::DragFloat("##FontSize", &LocalFontSize, 0.5f, Min, Max, "%.1f", ImGuiSliderFlags_AlwaysClamp);
+	if (LocalFontSize != FontSize)
+		SetFontSize(LocalFontSize);
+	
+	ImGui::PopStyleVar();
+}
+
+int FESceneGraphUI::FilterInputTextCallback(ImGuiInputTextCallbackData* Data)
+{
+	if (Data->EventFlag == ImGuiInputTextFlags_CallbackAlways)
+	{
+		bool bIsFocused = ImGui::IsItemActive();
+		if (bIsPlaceHolderTextUsed)
+		{
+			// Check if the input just gained focus
+			if (bIsFocused && !bFilterInputWasFocused)
+			{
+				strcpy_s(CharFilterText, "");
+
+				// Update ImGui's buffer.
+				Data->BufDirty = true;
+				Data->DeleteChars(0, Data->BufTextLen);
+				Data->InsertChars(0, CharFilterText);
+
+				bIsPlaceHolderTextUsed = false;
+			}
+		}
+
+		bFilterInputWasFocused = bIsFocused;
+	}
+
+	return 0;
+}
+
+void FESceneGraphUI::RenderFilterTextInput()
+{
+	const bool bIsPlaceHolderTextUsedWasOn = bIsPlaceHolderTextUsed;
+
+	if (bIsPlaceHolderTextUsedWasOn)
+		ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 255, 255, 150));
+
+	// Setting up the callback for the input text.
+	std::function<int(ImGuiInputTextCallbackData*)> Callback = std::bind(&FESceneGraphUI::FilterInputTextCallback, this, std::placeholders::_1);
+	auto StaticCallback = [](ImGuiInputTextCallbackData* Data) -> int {
+		const auto& Callback = *static_cast<std::function<int(ImGuiInputTextCallbackData*)>*>(Data->UserData);
+		return Callback(Data);
+	};
+
+	float AvailableWidth = ImGui::GetContentRegionAvail().x;
+	if (bRenderUIScaleControl)
+	{
+		ImVec2 TextSize = ImGui::CalcTextSize("UI Scale");
+		AvailableWidth -= TextSize.x + ImGui::GetStyle().ItemSpacing.x;
+		AvailableWidth -= 60.0f + 4.0f; // The width of the DragFloat control.
+	}
+	
+	ImGui::SetNextItemWidth(AvailableWidth);
+	if (ImGui::InputText("##SceneGraphWindowFilter", CharFilterText, FilterInputBufferSize, ImGuiInputTextFlags_CallbackAlways, StaticCallback, &Callback))
+	{
+		bFilterEnabled = true;
+		std::string OldFilterText = FilterText;
+		FilterText = CharFilterText;
+		ViewHistory.RecordFilterChange(OldFilterText, FilterText);
+		MarkRowsDirty();
+	}
+
+	if (!ImGui::IsItemActive())
+	{
+		if (strlen(CharFilterText) == 0)
+		{
+			strcpy_s(CharFilterText, PlaceHolderTextString.c_str());
+			bIsPlaceHolderTextUsed = true;
+			bFilterInputWasFocused = false;
+			if (bFilterEnabled)
+				MarkRowsDirty();
+			bFilterEnabled = false;
+		}
+	}
+
+	if (bIsPlaceHolderTextUsedWasOn)
+		ImGui::PopStyleColor();
+}
+
+bool FESceneGraphUI::IsNodeBeingRenamed(FENaiveSceneGraphNode* Node)
+{
+	if (Node == nullptr)
+		return false;
+
+	return NodeIDBeingRenamed == Node->GetObjectID();
+}
+
+bool FESceneGraphUI::ActivateRenameForNode(FENaiveSceneGraphNode* Node)
+{
+	if (Node == nullptr)
+		return false;
+
+	if (!ShouldNodeBeVisible(Node))
+		return false;
+
+	if (IsNodeBeingRenamed(Node))
+		return true;
+
+	if (!IsNodeSelected(Node))
+		SetNodeSelected(Node, true);
+
+	NodeIDBeingRenamed = Node->GetObjectID();
+
+	std::string NodeDisplayName = GetNodeDisplayName(Node);
+	strcpy_s(RenameBuffer, NodeDisplayName.size() + 1, NodeDisplayName.c_str());
+	bLastFrameRenameEditWasVisible = false;
+	return true;
+}
+
+void FESceneGraphUI::QueueNodeDeletion(FENaiveSceneGraphNode* Node)
+{
+	if (Node == nullptr)
+		return;
+
+	FEScene* NodeScene = SCENE_MANAGER.GetSceneByNodeID(Node->GetObjectID());
+	if (NodeScene == nullptr)
+		return;
+
+	FESceneGraphUICommand Command;
+	Command.Type = FE_SCENE_GRAPH_UI_COMMAND_DELETE;
+	Command.SceneID = NodeScene->GetObjectID();
+	Command.NodeID = Node->GetObjectID();
+	QueueCommand(Command);
+}
+
+void FESceneGraphUI::QueueNodeMove(FENaiveSceneGraphNode* Node, FENaiveSceneGraphNode* NewParent)
+{
+	if (Node == nullptr)
+		return;
+
+	FEScene* NodeScene = SCENE_MANAGER.GetSceneByNodeID(Node->GetObjectID());
+	if (NodeScene == nullptr)
+		return;
+
+	FESceneGraphUICommand Command;
+	Command.Type = FE_SCENE_GRAPH_UI_COMMAND_MOVE;
+	Command.SceneID = NodeScene->GetObjectID();
+	Command.NodeID = Node->GetObjectID();
+	Command.TargetNodeID = NewParent == nullptr ? "" : NewParent->GetObjectID();
+	QueueCommand(Command);
+}
+
+void FESceneGraphUI::QueueNodesMove(const std::vector<FENaiveSceneGraphNode*>& Nodes, FENaiveSceneGraphNode* NewParent)
+{
+	// Scene is taken from the first valid node, all nodes should belong to the same scene.
+	auto FirstNodeIterator = std::find_if(Nodes.begin(), Nodes.end(), [](FENaiveSceneGraphNode* Node) { return Node != nullptr; });
+	if (FirstNodeIterator == Nodes.end())
+		return;
+
+	FEScene* NodeScene = SCENE_MANAGER.GetSceneByNodeID((*FirstNodeIterator)->GetObjectID());
+	if (NodeScene == nullptr)
+		return;
+
+	FESceneGraphUICommand Command;
+	Command.Type = FE_SCENE_GRAPH_UI_COMMAND_MOVE_BATCH;
+	Command.SceneID = NodeScene->GetObjectID();
+	Command.NodeIDs.reserve(Nodes.size());
+	for (size_t i = 0; i < Nodes.size(); i++)
+	{
+		if (Nodes[i] != nullptr)
+			Command.NodeIDs.push_back(Nodes[i]->GetObjectID());
+	}
+	Command.TargetNodeID = NewParent == nullptr ? "" : NewParent->GetObjectID();
+	QueueCommand(Command);
+}
+
+void FESceneGraphUI::QueueNodeRename(FENaiveSceneGraphNode* Node, const std::string& NewName)
+{
+	if (Node == nullptr)
+		return;
+
+	FEScene* NodeScene = SCENE_MANAGER.GetSceneByNodeID(Node->GetObjectID());
+	if (NodeScene == nullptr)
+		return;
+
+	FESceneGraphUICommand Command;
+	Command.Type = FE_SCENE_GRAPH_UI_COMMAND_RENAME;
+	Command.SceneID = NodeScene->GetObjectID();
+	Command.NodeID = Node->GetObjectID();
+	Command.Name = NewName;
+	QueueCommand(Command);
+}
+
+void FESceneGraphUI::QueueNodesRename(const std::vector<FENaiveSceneGraphNode*>& Nodes, const std::vector<std::string>& NewNames)
+{
+	if (Nodes.size() != NewNames.size())
+		return;
+
+	// Scene is taken from the first valid node, all nodes should belong to the same scene.
+	auto FirstNodeIterator = std::find_if(Nodes.begin(), Nodes.end(), [](FENaiveSceneGraphNode* Node) { return Node != nullptr; });
+	if (FirstNodeIterator == Nodes.end())
+		return;
+
+	FEScene* NodeScene = SCENE_MANAGER.GetSceneByNodeID((*FirstNodeIterator)->GetObjectID());
+	if (NodeScene == nullptr)
+		return;
+
+	std::vector<std::string> NodeIDs;
+	std::vector<std::string> Names;
+	NodeIDs.reserve(Nodes.size());
+	Names.reserve(Nodes.size());
+	for (size_t i = 0; i < Nodes.size(); i++)
+	{
+		if (Nodes[i] == nullptr)
+			continue;
+
+		NodeIDs.push_back(Nodes[i]->GetObjectID());
+		Names.push_back(NewNames[i]);
+	}
+
+	QueueRenameBatch(NodeScene->GetObjectID(), NodeIDs, Names);
+}
+
+bool FESceneGraphUI::QueueSelectionRename(const FESceneGraphBulkRenameOptions& Options)
+{
+	FESceneGraphBulkRename Rename(Options);
+	if (!Rename.IsValid())
+		return false;
+
+	std::vector<FENaiveSceneGraphNode*> Nodes = GetSelectedNodesInRowOrder();
+	std::vector<std::string> NodeIDs;
+	std::vector<std::string> NewNames;
+	NodeIDs.reserve(Nodes.size());
+	NewNames.reserve(Nodes.size());
+	for (size_t i = 0; i < Nodes.size(); i++)
+	{
+		NodeIDs.push_back(Nodes[i]->GetObjectID());
+		NewNames.push_back(Rename.GetNewName(GetNodeName(Nodes[i]), i));
+	}
+
+	QueueRenameBatch(CurrentSceneID, NodeIDs, NewNames);
+	return true;
+}
+
+void FESceneGraphUI::QueueRenameBatch(const std::string& SceneID, const std::vector<std::string>& NodeIDs, const std::vector<std::string>& NewNames)
 {
-	bool bModeChanged = bDebugMode != bNewValue;
-	bDebugMode = bNewValue;
+	if (SceneID.empty() || NodeIDs.empty())
+		return;
 
-	if (bModeChanged)
+	FESceneGraphUICommand Command;
+	Command.Type = FE_SCENE_GRAPH_UI_COMMAND_RENAME_BATCH;
+	Command.SceneID = SceneID;
+	Command.NodeIDs = NodeIDs;
+	Command.Names = NewNames;
+	QueueCommand(Command);
+}
+
+std::vector<FENaiveSceneGraphNode*> FESceneGraphUI::GetSelectedNodesInRowOrder()
+{
+	std::vector<std::pair<size_t, FENaiveSceneGraphNode*>> OrderedNodes;
+	std::vector<std::string> SelectedNodeIDs = GetSelectedNodeIDs();
+	for (size_t i = 0; i < SelectedNodeIDs.size(); i++)
 	{
-		NodeState.clear();
+		FENaiveSceneGraphNode* Node = FindNodeByID(SelectedNodeIDs[i]);
+		if (Node == nullptr)
+			continue;
 
-		if (bDebugMode)
-		{
-			FEScene* NewScene = SCENE_MANAGER.CreateScene("Test scene");
-			TestSceneID = NewScene->GetObjectID();
-			ClearAllCallbacks();
-			ClearNodeWidgets();
+		int RowIndex = RowModel.FindRowIndex(SelectedNodeIDs[i]);
+		OrderedNodes.push_back(std::make_pair(RowIndex == -1 ? SIZE_MAX : static_cast<size_t>(RowIndex), Node));
+	}
 
-			InitiateTestScene();
-		}
-		else
-		{
-			ClearAllCallbacks();
-			ClearNodeWidgets();
-			DebugNodeWidgets.clear();
+	std::sort(OrderedNodes.begin(), OrderedNodes.end(), [](const std::pair<size_t, FENaiveSceneGraphNode*>& First, const std::pair<size_t, FENaiveSceneGraphNode*>& Second) {
+		if (First.first != Second.first)
+			return First.first < Second.first;
 
-			FEScene* TestScene = GetTestScene();
-			if (TestScene != nullptr)
-				SCENE_MANAGER.DeleteScene(TestScene);
-		}
-	}
-	
+		return First.second->GetObjectID() < Second.second->GetObjectID();
+	});
+
+	std::vector<FENaiveSceneGraphNode*> Result;
+	Result.reserve(OrderedNodes.size());
+	for (size_t i = 0; i < OrderedNodes.size(); i++)
+		Result.push_back(OrderedNodes[i].second);
+
+	return Result;
 }
 
-FEScene* FESceneGraphUI::GetTestScene()
+std::string FESceneGraphUI::GetNodeName(FENaiveSceneGraphNode* Node) const
 {
-	return SCENE_MANAGER.GetSceneByID(TestSceneID);
+	FEEntity* Entity = Node->GetEntity();
+	return Entity == nullptr ? Node->GetName() : Entity->GetName();
 }
 
-FETexture* FESceneGraphUI::GetDebugIconByIndex(const size_t& IconIndex)
+void FESceneGraphUI::OpenBulkRenamePopup()
 {
-	FETexture* Result = RESOURCE_MANAGER.NoTexture;
-	if (IconIndex >= DebugIconsIDs.size())
-		return Result;
+	bShouldOpenBulkRenamePopup = true;
+}
 
-	FETexture* FoundTexture = RESOURCE_MANAGER.GetTexture(DebugIconsIDs[IconIndex]);
-	if (FoundTexture != nullptr)
-		Result = FoundTexture;
+void FESceneGraphUI::RenderBulkRenamePopup()
+{
+	const char* PopupID = "Bulk rename##SceneGraphBulkRename";
+	if (bShouldOpenBulkRenamePopup)
+	{
+		bShouldOpenBulkRenamePopup = false;
 
-	return Result;
+		BulkRenameNodeIDs.clear();
+		BulkRenameCurrentNames.clear();
+		std::vector<FENaiveSceneGraphNode*> Nodes = GetSelectedNodesInRowOrder();
+		for (size_t i = 0; i < Nodes.size(); i++)
+		{
+			BulkRenameNodeIDs.push_back(Nodes[i]->GetObjectID());
+			BulkRenameCurrentNames.push_back(GetNodeName(Nodes[i]));
+		}
+
+		strcpy_s(BulkRenameTemplateBuffer, BulkRenameOptions.NameTemplate.substr(0, BulkRenameInputBufferSize - 1).c_str());
+		strcpy_s(BulkRenameFindBuffer, BulkRenameOptions.Find.substr(0, BulkRenameInputBufferSize - 1).c_str());
+		strcpy_s(BulkRenameReplaceBuffer, BulkRenameOptions.Replace.substr(0, BulkRenameInputBufferSize - 1).c_str());
+		strcpy_s(BulkRenamePrefixBuffer, BulkRenameOptions.Prefix.substr(0, BulkRenameInputBufferSize - 1).c_str());
+		strcpy_s(BulkRenameSuffixBuffer, BulkRenameOptions.Suffix.substr(0, BulkRenameInputBufferSize - 1).c_str());
+		ImGui::OpenPopup(PopupID);
+	}
+
+	if (!ImGui::BeginPopup(PopupID))
+		return;
+
+	ImGui::InputText("Name template", BulkRenameTemplateBuffer, BulkRenameInputBufferSize);
+	ImGui::InputText("Find", BulkRenameFindBuffer, BulkRenameInputBufferSize);
+	ImGui::InputText("Replace", BulkRenameReplaceBuffer, BulkRenameInputBufferSize);
+	ImGui::Checkbox("Regex", &BulkRenameOptions.bUseRegex);
+	ImGui::SameLine();
+	ImGui::Checkbox("Case sensitive", &BulkRenameOptions.bCaseSensitive);
+	ImGui::InputText("Prefix", BulkRenamePrefixBuffer, BulkRenameInputBufferSize);
+	ImGui::InputText("Suffix", BulkRenameSuffixBuffer, BulkRenameInputBufferSize);
+
+	int CounterStart = static_cast<int>(BulkRenameOptions.CounterStart);
+	if (ImGui::InputInt("Counter start", &CounterStart))
+		BulkRenameOptions.CounterStart = static_cast<size_t>(std::max(CounterStart, 0));
+
+	int CounterStep = static_cast<int>(BulkRenameOptions.CounterStep);
+	if (ImGui::InputInt("Counter step", &CounterStep))
+		BulkRenameOptions.CounterStep = static_cast<size_t>(std::max(CounterStep, 1));
+
+	BulkRenameOptions.NameTemplate = BulkRenameTemplateBuffer;
+	BulkRenameOptions.Find = BulkRenameFindBuffer;
+	BulkRenameOptions.Replace = BulkRenameReplaceBuffer;
+	BulkRenameOptions.Prefix = BulkRenamePrefixBuffer;
+	BulkRenameOptions.Suffix = BulkRenameSuffixBuffer;
+
+	// Only previewed names are computed every frame, the rest are computed once on apply.
+	FESceneGraphBulkRename Rename(BulkRenameOptions);
+	ImGui::Separator();
+	if (!Rename.IsValid())
+	{
+		ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", Rename.GetError().c_str());
+	}
+	else
+	{
+		size_t PreviewCount = std::min(BulkRenamePreviewCount, BulkRenameCurrentNames.size());
+		for (size_t i = 0; i < PreviewCount; i++)
+			ImGui::Text("%s -> %s", BulkRenameCurrentNames[i].c_str(), Rename.GetNewName(BulkRenameCurrentNames[i], i).c_str());
+
+		if (BulkRenameCurrentNames.size() > PreviewCount)
+			ImGui::Text("... and %zu more", BulkRenameCurrentNames.size() - PreviewCount);
+	}
+
+	ImGui::BeginDisabled(!Rename.IsValid() || BulkRenameNodeIDs.empty());
+	if (ImGui::Button(("Rename " + std::to_string(BulkRenameNodeIDs.size()) + " nodes").c_str()))
+	{
+		QueueRenameBatch(CurrentSceneID, BulkRenameNodeIDs, Rename.GetNewNames(BulkRenameCurrentNames));
+		ImGui::CloseCurrentPopup();
+	}
+	ImGui::EndDisabled();
+
+	ImGui::SameLine();
+	if (ImGui::Button("Cancel"))
+		ImGui::CloseCurrentPopup();
+
+	ImGui::EndPopup();
 }
 
-FETexture* FESceneGraphUI::GetRandomDebugIcon()
+void FESceneGraphUI::QueueEntityCreation(const std::string& Name, FENaiveSceneGraphNode* Parent)
 {
-	size_t Seed = static_cast<size_t>(time(nullptr));
-	srand(static_cast<unsigned int>(Seed));
-	if (DebugIconsIDs.size() == 0)
-		return RESOURCE_MANAGER.NoTexture;
+	FEScene* TargetScene = Parent == nullptr ? GetScene() : SCENE_MANAGER.GetSceneByNodeID(Parent->GetObjectID());
+	if (TargetScene == nullptr)
+		return;
 
-	size_t RandomIndex = rand() % DebugIconsIDs.size();
-	return GetDebugIconByIndex(RandomIndex);
+	FESceneGraphUICommand Command;
+	Command.Type = FE_SCENE_GRAPH_UI_COMMAND_CREATE;
+	Command.SceneID = TargetScene->GetObjectID();
+	Command.TargetNodeID = Parent == nullptr ? "" : Parent->GetObjectID();
+	Command.Name = Name;
+	QueueCommand(Command);
 }
 
-std::vector<std::string> FESceneGraphUI::GetDebugIconsIDs() const
+void FESceneGraphUI::QueueCommand(const FESceneGraphUICommand& Command)
 {
-	return DebugIconsIDs;
+	FESceneGraphCommandQueue::Push(Command);
 }
 
-void FESceneGraphUI::SetDebugIconsIDs(const std::vector<std::string>& NewDebugIconsIDs)
+size_t FESceneGraphUI::GetQueuedCommandCount()
 {
-	DebugIconsIDs = NewDebugIconsIDs;
+	return FESceneGraphCommandQueue::GetQueuedCommandCount(CurrentSceneID);
 }
 
-void FESceneGraphUI::AddBeforeNodeRenderCallback(std::function<void(FENaiveSceneGraphNode*)> Callback)
+void FESceneGraphUI::ApplyDeferredCommands()
 {
-	BeforeNodeRenderCallbacks.push_back(Callback);
+	FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, FE_SCENE_GRAPH_UI_PHASE_DEFERRED_COMMANDS);
+	FESceneGraphCommandQueue::ApplyAll(bSceneChangeJournalComplete);
 }
 
-void FESceneGraphUI::AddAfterNodeRenderCallback(std::function<void(FENaiveSceneGraphNode*)> Callback)
+void FESceneGraphUI::SyncWithChangeJournal()
 {
-	AfterNodeRenderCallbacks.push_back(Callback);
+	if (CurrentSceneID.empty())
+		return;
+
+	// State of the previously shown scene is kept, new scene is followed from its current position.
+	// Scene that was shown before continues from where panel has left it.
+	if (JournalSceneID != CurrentSceneID)
+	{
+		JournalSceneID = CurrentSceneID;
+
+		for (auto Iterator = LastSeenJournalSequences.begin(); Iterator != LastSeenJournalSequences.end();)
+		{
+			if (SCENE_MANAGER.GetSceneByID(Iterator->first) == nullptr)
+			{
+				FESceneGraphChangeJournal::Release(Iterator->first);
+				Iterator = LastSeenJournalSequences.erase(Iterator);
+			}
+			else
+			{
+				Iterator++;
+			}
+		}
+
+		if (LastSeenJournalSequences.find(CurrentSceneID) == LastSeenJournalSequences.end())
+		{
+			FESceneGraphChangeJournal::Acquire(CurrentSceneID);
+			LastSeenJournalSequences[CurrentSceneID] = FESceneGraphChangeJournal::GetForScene(CurrentSceneID).GetLastSequence();
+		}
+
+		// Steps refer to nodes of the previous scene.
+		ViewHistory.Clear();
+		FESceneGraphIndex::Release(SceneIndex);
+		SceneIndex = FESceneGraphIndex::Acquire(CurrentSceneID);
+	}
+
+	FESceneGraphChangeJournal& Journal = FESceneGraphChangeJournal::GetForScene(CurrentSceneID);
+	uint64_t& LastSeenJournalSequence = LastSeenJournalSequences[CurrentSceneID];
+
+	// The first panel that sees new changes updates the index for all panels of the scene.
+	SceneIndex->Update();
+
+	if (LastSeenJournalSequence == Journal.GetLastSequence())
+		return;
+
+	std::vector<FESceneGraphChangeRecord> Changes;
+	if (Journal.GetChangesSince(LastSeenJournalSequence, Changes))
+	{
+		for (size_t i = 0; i < Changes.size(); i++)
+			ApplyChangeRecord(Changes[i]);
+	}
+	else
+	{
+		// Panel was not rendered for too long and journal has already discarded part of the changes.
+		RemoveStateOfDeletedNodes();
+	}
+
+	LastSeenJournalSequence = Journal.GetLastSequence();
 }
 
-void FESceneGraphUI::RenderUIScaleControl(float Min, float Max)
+FENaiveSceneGraphNode* FESceneGraphUI::FindNodeByID(const std::string& NodeID)
 {
-	ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 4.0f);
+	// Index keeps node pointers, without complete journal they could belong to already deleted nodes.
+	if (SceneIndex != nullptr && bSceneChangeJournalComplete)
+	{
+		SceneIndex->Update();
+		return SceneIndex->GetNodeByID(NodeID);
+	}
 
-	float FrameHeight = ImGui::GetFrameHeight();
-	float TextHeight = ImGui::GetTextLineHeight();
-	float Offset = (FrameHeight - TextHeight) * 0.5f;
+	FEScene* CurrentScene = GetScene();
+	if (CurrentScene == nullptr)
+		return nullptr;
 
-	ImGui::Text("UI Scale");
-	ImGui::SameLine();
-	
-	ImGui::SetNextItemWidth(60.0f);
-	float LocalFontSize = FontSize;
-	ImGui::DragFloat("##FontSize", &LocalFontSize, 0.5f, Min, Max, "%.1f", ImGuiSliderFlags_AlwaysClamp);
-	if (LocalFontSize != FontSize)
-		SetFontSize(LocalFontSize);
-	
-	ImGui::PopStyleVar();
+	return CurrentScene->SceneGraph.GetNodeByID(NodeID);
 }
 
-int FESceneGraphUI::FilterInputTextCallback(ImGuiInputTextCallbackData* Data)
+FESceneGraphIndex* FESceneGraphUI::GetSceneIndex() const
 {
-	if (Data->EventFlag == ImGuiInputTextFlags_CallbackAlways)
+	return SceneIndex;
+}
+
+bool FESceneGraphUI::IsSyncedWithChangeJournal() const
+{
+	auto Iterator = LastSeenJournalSequences.find(CurrentSceneID);
+	return Iterator != LastSeenJournalSequences.end() && Iterator->second == FESceneGraphChangeJournal::GetForScene(CurrentSceneID).GetLastSequence();
+}
+
+void FESceneGraphUI::ApplyChangeRecord(const FESceneGraphChangeRecord& Change)
+{
+	switch (Change.Type)
 	{
-		bool bIsFocused = ImGui::IsItemActive();
-		if (bIsPlaceHolderTextUsed)
-		{
-			// Check if the input just gained focus
-			if (bIsFocused && !bFilterInputWasFocused)
-			{
-				strcpy_s(CharFilterText, "");
+		case FE_SCENE_GRAPH_CHANGE_NODE_REMOVED:
+			OnNodeRemoved(Change.NodeID);
+			break;
 
-				// Update ImGui's buffer.
-				Data->BufDirty = true;
-				Data->DeleteChars(0, Data->BufTextLen);
-				Data->InsertChars(0, CharFilterText);
+		default:
+			break;
+	}
 
-				bIsPlaceHolderTextUsed = false;
-			}
-		}
+	// Added, removed and moved nodes are picked up by the membership check in the next update of parent permutation.
+	// Renamed node keeps its place among siblings, but its sort key has changed.
+	if (Change.Type == FE_SCENE_GRAPH_CHANGE_NODE_RENAMED)
+		MarkSortedChildStale(Change.ParentID, Change.NodeID);
 
-		bFilterInputWasFocused = bIsFocused;
+	// Records from hosts could miss the previous parent, then it is not known which groups have changed.
+	const bool bPreviousParentNeeded = Change.Type == FE_SCENE_GRAPH_CHANGE_NODE_REMOVED || Change.Type == FE_SCENE_GRAPH_CHANGE_NODE_REPARENTED;
+	if (bPreviousParentNeeded && Change.PreviousParentID.empty())
+	{
+		SiblingGroupCaches.clear();
+	}
+	else
+	{
+		SiblingGroupCaches.erase(Change.ParentID);
+		SiblingGroupCaches.erase(Change.PreviousParentID);
 	}
 
-	return 0;
+	MarkRowsDirty();
 }
 
-void FESceneGraphUI::RenderFilterTextInput()
+void FESceneGraphUI::RemoveStateOfDeletedNodes()
 {
-	const bool bIsPlaceHolderTextUsedWasOn = bIsPlaceHolderTextUsed;
+	std::vector<std::string> DeletedNodeIDs;
+	for (const auto& NodeStatePair : NodeState)
+	{
+		if (SCENE_MANAGER.GetSceneByNodeID(NodeStatePair.first) == nullptr)
+			DeletedNodeIDs.push_back(NodeStatePair.first);
+	}
 
-	if (bIsPlaceHolderTextUsedWasOn)
-		ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 255, 255, 150));
+	for (size_t i = 0; i < DeletedNodeIDs.size(); i++)
+		OnNodeRemoved(DeletedNodeIDs[i]);
 
-	// Setting up the callback for the input text.
-	std::function<int(ImGuiInputTextCallbackData*)> Callback = std::bind(&FESceneGraphUI::FilterInputTextCallback, this, std::placeholders::_1);
-	auto StaticCallback = [](ImGuiInputTextCallbackData* Data) -> int {
-		const auto& Callback = *static_cast<std::function<int(ImGuiInputTextCallbackData*)>*>(Data->UserData);
-		return Callback(Data);
-	};
+	SortedChildrenCaches.clear();
+	SiblingGroupCaches.clear();
 
-	float AvailableWidth = ImGui::GetContentRegionAvail().x;
-	if (bRenderUIScaleControl)
+	MarkRowsDirty();
+}
+
+void FESceneGraphUI::OnNodeRemoved(const std::string& NodeID)
+{
+	NodeState.erase(NodeID);
+	SelectedNodeIDSet.erase(NodeID);
+	SortedChildrenCaches.erase(NodeID);
+
+	if (NodeIDToScrollTo == NodeID)
+		NodeIDToScrollTo = "";
+
+	if (HoistedNodeID == NodeID)
+		HoistedNodeID = "";
+
+	const std::string RootViewKeys[2] = { NodeID + "/0", NodeID + "/1" };
+	for (const std::string& RootViewKey : RootViewKeys)
 	{
-		ImVec2 TextSize = ImGui::CalcTextSize("UI Scale");
-		AvailableWidth -= TextSize.x + ImGui::GetStyle().ItemSpacing.x;
-		AvailableWidth -= 60.0f + 4.0f; // The width of the DragFloat control.
+		if (RootViews.erase(RootViewKey) == 0)
+			continue;
+
+		auto OrderIterator = std::find(RootViewOrder.begin(), RootViewOrder.end(), RootViewKey);
+		if (OrderIterator != RootViewOrder.end())
+			RootViewOrder.erase(OrderIterator);
 	}
-	
-	ImGui::SetNextItemWidth(AvailableWidth);
-	if (ImGui::InputText("##SceneGraphWindowFilter", CharFilterText, FilterInputBufferSize, ImGuiInputTextFlags_CallbackAlways, StaticCallback, &Callback))
+
+	if (FocusedNodeID == NodeID)
 	{
-		bFilterEnabled = true;
-		FilterText = CharFilterText;
+		FocusedNode = nullptr;
+		FocusedNodeID = "";
+		FocusedRowIndex = -1;
 	}
 
-	if (!ImGui::IsItemActive())
+	SiblingGroupCaches.erase(NodeID);
+	for (auto Iterator = ExpandedSiblingGroups.begin(); Iterator != ExpandedSiblingGroups.end();)
 	{
-		if (strlen(CharFilterText) == 0)
+		if (Iterator->compare(0, NodeID.size() + 1, NodeID + "/") == 0)
 		{
-			strcpy_s(CharFilterText, PlaceHolderTextString.c_str());
-			bIsPlaceHolderTextUsed = true;
-			bFilterInputWasFocused = false;
-			bFilterEnabled = false;
+			Iterator = ExpandedSiblingGroups.erase(Iterator);
+		}
+		else
+		{
+			Iterator++;
 		}
 	}
 
-	if (bIsPlaceHolderTextUsedWasOn)
-		ImGui::PopStyleColor();
+	if (HoveredNodeID == NodeID)
+		HoveredNodeID = "";
+
+	if (HoveredNodeIDWhenContextMenuWasOpened == NodeID)
+		HoveredNodeIDWhenContextMenuWasOpened = "";
+
+	if (NodeIDBeingRenamed == NodeID)
+		NodeIDBeingRenamed = "";
 }
 
-bool FESceneGraphUI::IsNodeBeingRenamed(FENaiveSceneGraphNode* Node)
+FESceneGraphUIPersistentState FESceneGraphUI::CaptureState()
 {
-	if (Node == nullptr)
-		return false;
+	FESceneGraphUIPersistentState State;
+	State.SceneID = CurrentSceneID;
+	State.ScrollY = LastListBoxScrollY;
+	State.FilterText = FilterText;
+	State.bCaseSensitiveFiltering = bCaseSensitiveFiltering;
+	State.ChildrenSortMode = static_cast<uint32_t>(ChildrenSortMode);
+	State.bChildrenSortAscending = bChildrenSortAscending;
+
+	bool bHoistedNodeStored = HoistedNodeID.empty();
+	for (const auto& NodeStatePair : NodeState)
+	{
+		const FESceneGraphNodeStateData& Data = NodeStatePair.second;
+		const bool bHoisted = NodeStatePair.first == HoistedNodeID;
+		if (!Data.bExpanded && !Data.bSelected && Data.LoadedChildCount == 0 && !bHoisted)
+			continue;
 
-	return NodeIDBeingRenamed == Node->GetObjectID();
+		FESceneGraphUIPersistentNodeState NodeData;
+		NodeData.NodeID = NodeStatePair.first;
+		NodeData.bExpanded = Data.bExpanded;
+		NodeData.bSelected = Data.bSelected;
+		NodeData.bHoisted = bHoisted;
+		NodeData.LoadedChildCount = Data.LoadedChildCount;
+		State.Nodes.push_back(NodeData);
+
+		bHoistedNodeStored = bHoistedNodeStored || bHoisted;
+	}
+
+	if (!bHoistedNodeStored)
+	{
+		FESceneGraphUIPersistentNodeState NodeData;
+		NodeData.NodeID = HoistedNodeID;
+		NodeData.bHoisted = true;
+		State.Nodes.push_back(NodeData);
+	}
+
+	return State;
 }
 
-bool FESceneGraphUI::ActivateRenameForNode(FENaiveSceneGraphNode* Node)
+bool FESceneGraphUI::ApplyState(const FESceneGraphUIPersistentState& State)
 {
-	if (Node == nullptr)
+	if (SCENE_MANAGER.GetSceneByID(State.SceneID) == nullptr)
 		return false;
 
-	if (!ShouldNodeBeVisible(Node))
-		return false;
+	// Index of the saved scene gives O(1) validation of every stored node ID.
+	FESceneGraphIndex* StateSceneIndex = FESceneGraphIndex::AcquireUpToDate(State.SceneID, bSceneChangeJournalComplete);
 
-	if (IsNodeBeingRenamed(Node))
-		return true;
+	std::vector<std::string> SelectedNodeIDs = GetSelectedNodeIDs();
+	for (size_t i = 0; i < SelectedNodeIDs.size(); i++)
+		SetNodeSelectedInternal(FindNodeByID(SelectedNodeIDs[i]), false);
 
-	if (!IsNodeSelected(Node))
-		SetNodeSelected(Node, true);
+	NodeState.clear();
+	SelectedNodeIDSet.clear();
+	HoistedNodeID = "";
 
-	NodeIDBeingRenamed = Node->GetObjectID();
+	std::vector<std::pair<FENaiveSceneGraphNode*, const FESceneGraphUIPersistentNodeState*>> ValidNodes;
+	ValidNodes.reserve(State.Nodes.size());
+	for (size_t i = 0; i < State.Nodes.size(); i++)
+	{
+		FENaiveSceneGraphNode* Node = StateSceneIndex->GetNodeByID(State.Nodes[i].NodeID);
+		if (Node != nullptr)
+			ValidNodes.push_back(std::make_pair(Node, &State.Nodes[i]));
+	}
 
-	std::string NodeDisplayName = GetNodeDisplayName(Node);
-	strcpy_s(RenameBuffer, NodeDisplayName.size() + 1, NodeDisplayName.c_str());
-	bLastFrameRenameEditWasVisible = false;
+	// Selection expands ancestors, so stored expansion is applied after it.
+	for (size_t i = 0; i < ValidNodes.size(); i++)
+	{
+		if (!ValidNodes[i].second->bSelected)
+			continue;
+
+		SetNodeSelectedInternal(ValidNodes[i].first, true);
+		if (!bAllowMultipleNodeSelection)
+			break;
+	}
+
+	for (size_t i = 0; i < ValidNodes.size(); i++)
+	{
+		const FESceneGraphUIPersistentNodeState& NodeData = *ValidNodes[i].second;
+		if (NodeData.bExpanded || NodeData.LoadedChildCount != 0)
+		{
+			FESceneGraphNodeStateData& Data = NodeState[NodeData.NodeID];
+			Data.bExpanded = NodeData.bExpanded;
+			Data.LoadedChildCount = NodeData.LoadedChildCount;
+		}
+		else
+		{
+			auto Iterator = NodeState.find(NodeData.NodeID);
+			if (Iterator != NodeState.end())
+				Iterator->second.bExpanded = false;
+		}
+
+		if (NodeData.bHoisted)
+			HoistedNodeID = NodeData.NodeID;
+	}
+
+	FESceneGraphIndex::Release(StateSceneIndex);
+
+	bCaseSensitiveFiltering = State.bCaseSensitiveFiltering;
+	SetFilterText(State.FilterText);
+	if (State.ChildrenSortMode <= FE_SCENE_GRAPH_UI_CHILDREN_SORT_CUSTOM)
+		SetChildrenSortMode(static_cast<FE_SCENE_GRAPH_UI_CHILDREN_SORT_MODE>(State.ChildrenSortMode), State.bChildrenSortAscending);
+
+	PendingScrollY = State.ScrollY;
+	// Hoisted node from the state changes rendering root on the next frame, that should not reset the loaded scroll.
+	bPendingScrollExplicit = State.ScrollY >= 0.0f;
+	// Loaded state replaces the whole NodeState, steps recorded before it can not be applied on top of it.
+	ViewHistory.Clear();
+	MarkRowsDirty();
 	return true;
+}
+
+bool FESceneGraphUI::SaveState(const std::string& FilePath)
+{
+	if (CurrentSceneID.empty())
+		return false;
+
+	return FESceneGraphUIStateFile::Save(FilePath, CaptureState());
+}
+
+bool FESceneGraphUI::LoadState(const std::string& FilePath)
+{
+	FESceneGraphUIPersistentState State;
+	if (!FESceneGraphUIStateFile::Load(FilePath, State))
+		return false;
+
+	return ApplyState(State);
 }
\ No newline at end of file
@@ -1,10 +1,106 @@
 #pragma once
 #include "FEngine.h"
+#include "FESceneGraphChangeJournal.h"
+#include "FESceneGraphCommandQueue.h"
+#include "FESceneGraphIndex.h"
+#include "FESceneGraphRowModel.h"
+#include "FESceneGraphMinimap.h"
+#include "FESceneGraphIconAtlas.h"
+#include "FESceneGraphUIFontCache.h"
+#include "FESceneGraphUIStateFile.h"
+#include "FESceneGraphViewHistory.h"
+#include "FESceneGraphBulkRename.h"
+#include "FESceneGraphSiblingGrouping.h"
+#include "FESceneGraphChildrenSorting.h"
+#include "FESceneGraphUIProfiler.h"
+#include "FESceneGraphUITrace.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
 
 struct FESceneGraphNodeStateData
 {
 	bool bExpanded = false;
 	bool bSelected = false;
+	// Number of children that have rows when node has paged children, 0 means only the first page.
+	size_t LoadedChildCount = 0;
+};
+
+// User callback together with the name it is reported under in trace spans.
+template<typename FunctionType>
+struct FESceneGraphUICallbackRegistration
+{
+	std::string Name = "";
+	std::function<FunctionType> Function = nullptr;
+};
+
+// Groups of one parent, they are rebuilt only when children of that parent change.
+struct FESceneGraphUISiblingGroupCache
+{
+	// Children that groups were built from, IDs catch memory of deleted nodes that was reused by new children.
+	std::vector<FENaiveSceneGraphNode*> Children;
+	std::vector<std::string> ChildIDs;
+	std::vector<FESceneGraphSiblingGroup> Groups;
+};
+
+// Draw list channels of the list box, they are merged in this order.
+enum FE_SCENE_GRAPH_UI_DRAW_CHANNEL
+{
+	// Row backgrounds and regular connector lines, they are emitted in batches.
+	FE_SCENE_GRAPH_UI_DRAW_CHANNEL_BACKGROUND = 0,
+	FE_SCENE_GRAPH_UI_DRAW_CHANNEL_DEFAULT = 1,
+	FE_SCENE_GRAPH_UI_DRAW_CHANNEL_HIGHLIGHTED_CONNECTOR_LINES = 2,
+	FE_SCENE_GRAPH_UI_DRAW_CHANNEL_STICKY_HEADERS = 3,
+	FE_SCENE_GRAPH_UI_DRAW_CHANNEL_COUNT = 4
+};
+
+// Vertical connector line shared by all visible children of one parent row.
+struct FESceneGraphUIConnectorRun
+{
+	int ParentRowIndex = -1;
+	float X = 0.0f;
+	int LastChildRowIndex = -1;
+	int LastHighlightedChildRowIndex = -1;
+};
+
+struct FESceneGraphUIRowBackground
+{
+	ImVec2 Min;
+	ImVec2 Max;
+	ImU32 Color = 0;
+};
+
+// Node, "more children" or sibling group row that is waiting to be appended during row building.
+struct FESceneGraphUIRowBuildEntry
+{
+	FENaiveSceneGraphNode* Node = nullptr;
+	int ParentRowIndex = -1;
+	size_t Indentation = 0;
+	// Entry for "more children" row of paged Node.
+	bool bMoreChildren = false;
+	size_t LoadedChildCount = 0;
+	size_t TotalChildCount = 0;
+	// Entry for sibling group row, Node is parent of the group.
+	const FESceneGraphSiblingGroup* Group = nullptr;
+};
+
+// Renderer side cache of truncated row text, it depends on available width, so it is stored together with width it was computed for.
+struct FESceneGraphUIRowTextCache
+{
+	float Width = -1.0f;
+	std::string Text = "";
+};
+
+// Rows and scroll of a rendering root that was shown before, so switching back to it does not need traversal.
+struct FESceneGraphUIRootView
+{
+	bool bRowsValid = false;
+	// Rows are reused only if nothing has marked rows dirty since they were stored.
+	uint64_t RowsGeneration = 0;
+	FESceneGraphRowModel RowModel;
+	std::vector<FESceneGraphUIRowTextCache> RowTextCache;
+	float ScrollY = 0.0f;
 };
 
 struct FESceneGraphNodeWidget
@@ -36,6 +132,8 @@ public:
 	std::function<void(FENaiveSceneGraphNode*)> OnClickCallback = nullptr;
 	bool bIsVisibleByDefault = true;
 	std::function<bool(FENaiveSceneGraphNode*)> IsVisiblePredicate = nullptr;
+	// Rows where this widget is visible are marked on the minimap.
+	bool bIsAlert = false;
 };
 
 class FESceneGraphUI
@@ -45,7 +143,63 @@ class FESceneGraphUI
 	bool bVisible = true;
 	FENaiveSceneGraphNode* RenderingRoot = nullptr;
 	bool bRenderRootItself = false;
-	void RenderNode(FENaiveSceneGraphNode* Node);
+
+
+	// Cached rows.
+	bool bRowCachingEnabled = true;
+	// Rows keep node pointers, so they are reused between frames only if host promises that
+	// nodes are never deleted or moved without a journal record.
+	bool bSceneChangeJournalComplete = false;
+	bool bRowsDirty = true;
+	FESceneGraphRowModel RowModel;
+	std::vector<FESceneGraphUIRowTextCache> RowTextCache;
+	// Local Y of the first row in the list box, it does not depend on scroll.
+	float RowsStartY = 0.0f;
+	uint64_t RowsGeneration = 0;
+	bool bBuildingRows = false;
+	void MarkRowsDirty();
+	bool CanReuseRows() const;
+	bool ShouldRebuildRows() const;
+	void RebuildRows();
+	void AppendRows(std::vector<FESceneGraphUIRowBuildEntry>& Stack);
+	void PushChildRowBuildEntries(FENaiveSceneGraphNode* Node, int RowIndex, size_t Indentation, std::vector<FESceneGraphUIRowBuildEntry>& Stack);
+	void UpdateSelectedBranchRows();
+
+	// Changes that affect only a few rows (e.g. revealing a node) are applied to valid rows before they are used on the next frame,
+	// rows are never modified while they are rendered. Rows of other nodes are only shifted, nodes are not visited again.
+	std::vector<std::string> PendingRowSubtreeNodeIDs;
+	std::unordered_set<std::string> PendingSelectionRowNodeIDs;
+	// Each subtree update shifts all following rows, so for more updates one rebuild is cheaper.
+	size_t MaxRowSubtreeUpdatesPerFrame = 16;
+	// Node without a row is ignored, its children do not have rows either.
+	void MarkRowSubtreeDirty(FENaiveSceneGraphNode* Node);
+	void MarkRowSelectionDirty(FENaiveSceneGraphNode* Node);
+	bool HasPendingRowUpdates() const;
+	void ApplyPendingRowUpdates();
+	void RebuildRowSubtree(size_t RowIndex);
+	void EvaluateRowWidgets(FESceneGraphUIRow& Row);
+	void RenderRow(size_t RowIndex, float RowPitch);
+
+
+	// Rendering root switching.
+	// Views are keyed by root ID and bRenderRootItself, least recently used ones are dropped.
+	std::unordered_map<std::string, FESceneGraphUIRootView> RootViews;
+	std::deque<std::string> RootViewOrder;
+	size_t MaxRootViews = 8;
+	float PendingScrollY = -1.0f;
+	// Scroll from loaded state is not replaced by the stored scroll of the root that panel switches to before it is applied.
+	bool bPendingScrollExplicit = false;
+	std::string GetRootViewKey(FENaiveSceneGraphNode* Root, bool bRenderRootItself) const;
+	void SetRenderingRootInternal(FENaiveSceneGraphNode* NewRoot, bool bNewRenderRootItself);
+	// Copies rows of new root subtree out of current rows, instead of traversing scene graph again.
+	bool TryDeriveRowsFromSubrange(FENaiveSceneGraphNode* NewRoot, bool bNewRenderRootItself, FESceneGraphRowModel& OutRowModel, std::vector<FESceneGraphUIRowTextCache>& OutRowTextCache) const;
+
+	// Hoisting.
+	// Hoisted node replaces rendering root that was passed to Render, while it is inside of that root.
+	std::string HoistedNodeID = "";
+	bool bRenderBreadcrumbs = true;
+	FENaiveSceneGraphNode* GetEffectiveRenderingRoot(FENaiveSceneGraphNode* RequestedRoot, bool& bInOutRenderRootItself);
+	void RenderBreadcrumbs(FENaiveSceneGraphNode* RequestedRoot);
 
 
 	// Appearance.
@@ -59,23 +213,74 @@ class FESceneGraphUI
 	float SelectedConnectorLineThickness = 2.6f;
 	bool bAlternatingNodeBackground = true;
 	//bool bOnlyTextPartOfNodeUsesBackground = true;
-	static bool bLastNodeWasEven;
 	
+	// Font is shared between panels and read in background, default ImGui font is used until it is ready.
+	std::string FontPath = "Resources/Cousine-Regular.ttf";
 	ImFont* CousineFont = nullptr;
 	float FontSize = 32.0f;
 	float TooltipFontSize = FontSize / 2.0f;
 	float NodeHeight = 32.0f;
 	ImVec2 IconsSize = ImVec2(NodeHeight, NodeHeight);
+	// Node and widget icons are rendered from one shared texture, so they do not split draw commands.
+	// Off by default, because atlas keeps a CPU copy of icons and changes how they are sampled.
+	bool bIconAtlasEnabled = false;
+	FESceneGraphIconAtlas IconAtlas;
+	// Icons that are not in the atlas yet are added and rendered with their own texture until the atlas is updated.
+	void GetIconDrawData(FETexture* Icon, ImTextureID& OutTextureID, ImVec2& OutUV0, ImVec2& OutUV1);
 	bool bRenderUIScaleControl = true;
 	void RenderUIScaleControl(float Min = 8.0f, float Max = 128.0f);
 
 
 	// Node state (expand/collapse/selection).
 	std::unordered_map<std::string, FESceneGraphNodeStateData> NodeState;
+	// IDs of NodeState entries with bSelected, so single selection does not scan all node states.
+	std::unordered_set<std::string> SelectedNodeIDSet;
 	bool bAllowMultipleNodeSelection = false;
 	std::function<bool(FENaiveSceneGraphNode*)> NodeSelectionPredicate = nullptr;
-	std::vector<std::function<void(FENaiveSceneGraphNode*, bool)>> OnNodeSelectionChangedCallbacks;
+	std::vector<FESceneGraphUICallbackRegistration<void(FENaiveSceneGraphNode*, bool)>> OnNodeSelectionChangedCallbacks;
 	void SetNodeSelectedInternal(FENaiveSceneGraphNode* Node, bool bSelected);
+	// Changes selection and notifies callbacks without expanding ancestors of the node.
+	void SetNodeSelectionState(FENaiveSceneGraphNode* Node, bool bSelected);
+
+
+	// Paged children.
+	// Nodes with more children than threshold show only loaded pages, followed by "show next/show all" row.
+	size_t ChildPagingThreshold = 1000;
+	size_t ChildPageSize = 250;
+	size_t GetMaterializedChildCount(FENaiveSceneGraphNode* Node, size_t ChildCount);
+	void EnsureChildIsMaterialized(FENaiveSceneGraphNode* Parent, FENaiveSceneGraphNode* Child);
+	bool IsTextFilterActive() const;
+	void RenderMoreChildrenRow(size_t RowIndex, float RowPitch);
+
+
+	// Sorted children.
+	// Permutation is cached per parent and updated incrementally from the change journal.
+	FE_SCENE_GRAPH_UI_CHILDREN_SORT_MODE ChildrenSortMode = FE_SCENE_GRAPH_UI_CHILDREN_SORT_STORAGE;
+	bool bChildrenSortAscending = true;
+	std::function<std::string(FENaiveSceneGraphNode*)> ChildrenSortKeyProvider = nullptr;
+	std::function<std::string(FENaiveSceneGraphNode*)> EntityTypeProvider = nullptr;
+	std::unordered_map<std::string, FESceneGraphSortedChildren> SortedChildrenCaches;
+	std::string GetChildrenSortKey(FENaiveSceneGraphNode* Node);
+	std::vector<FENaiveSceneGraphNode*> GetOrderedChildren(FENaiveSceneGraphNode* Node);
+	FESceneGraphSortedChildren& GetUpdatedSortedChildren(FENaiveSceneGraphNode* Node, const std::vector<FENaiveSceneGraphNode*>& Children);
+	void MarkSortedChildStale(const std::string& ParentID, const std::string& NodeID);
+
+
+	// Virtual grouping of siblings.
+	// Takes place of paging for parents with more children than threshold.
+	FE_SCENE_GRAPH_UI_SIBLING_GROUPING SiblingGroupingMode = FE_SCENE_GRAPH_UI_SIBLING_GROUPING_NONE;
+	size_t SiblingGroupingThreshold = 1000;
+	size_t AlphabeticalSiblingGroupSize = 1000;
+	std::unordered_map<std::string, FESceneGraphUISiblingGroupCache> SiblingGroupCaches;
+	// Keys are parent ID + "/" + group key.
+	std::unordered_set<std::string> ExpandedSiblingGroups;
+	bool ShouldGroupChildren(size_t ChildCount) const;
+	const std::vector<FESceneGraphSiblingGroup>& GetSiblingGroups(FENaiveSceneGraphNode* Parent, const std::vector<FENaiveSceneGraphNode*>& Children);
+	void ClearSiblingGroupCaches();
+	bool IsSiblingGroupExpanded(FENaiveSceneGraphNode* Parent, const std::string& GroupKey) const;
+	void SetSiblingGroupExpanded(FENaiveSceneGraphNode* Parent, const std::string& GroupKey, bool bExpanded);
+	bool IsAnySiblingGroupMemberVisible(const FESceneGraphSiblingGroup& Group);
+	void RenderSiblingGroupRow(size_t RowIndex, float RowPitch);
 
 
 	// Predicates and providers.
@@ -89,14 +294,13 @@ class FESceneGraphUI
 
 	// Visibility/filtering.
 	std::vector<std::string> HiddenEntityTags;
-	bool ShouldNodeBeVisible(FENaiveSceneGraphNode* Node);
 	bool AreNodeChildrenVisible(FENaiveSceneGraphNode* Node);
 
 	bool bRenderTextFilterInput = true;
 	bool bFilterEnabled = false;
 	bool bCaseSensitiveFiltering = false;
 	std::string FilterText = "";
-	bool DoesNodePassTextFilter(FENaiveSceneGraphNode* Node);
+	bool DoesDisplayNameMatchFilter(const std::string& DisplayName) const;
 	void RenderFilterTextInput();
 	static constexpr size_t FilterInputBufferSize = 2048;
 	char CharFilterText[FilterInputBufferSize];
@@ -104,15 +308,30 @@ class FESceneGraphUI
 	bool bFilterInputWasFocused = false;
 	std::string PlaceHolderTextString = "Filter entities...";
 	int FilterInputTextCallback(ImGuiInputTextCallbackData* Data);
+
+
+	// View history.
+	// Expansion, selection and filter changes between two frames are one undo step.
+	FESceneGraphViewHistory ViewHistory;
+	bool bViewHistoryShortcutsEnabled = true;
+	// Recorded as one subtree operation, instead of a change per node.
+	void SetSubtreeExpanded(FENaiveSceneGraphNode* Root, bool bExpanded);
+	void ApplyViewHistoryStep(const FESceneGraphViewHistoryStep& Step, bool bUndo);
+	void HandleViewHistoryShortcuts();
 	
 
 	// Tree visualization.
 	float TreeArrowsThicknessCoefficient = 0.07f;
 	float LineJoinOverlapFactor = 0.77f;
-	bool IsNodePartOfBranch(FENaiveSceneGraphNode* NodeToCheck, FENaiveSceneGraphNode* BranchRoot, FENaiveSceneGraphNode* BranchLeaf);
 	bool bHighlightSelectedNodeConnectorLines = true;
-	void DrawTreeConnectorLines(FENaiveSceneGraphNode* Node, float ParentBottomY);
-	void DrawAppropriateTreeArrow(FENaiveSceneGraphNode* Node);
+	// Connector lines of visible rows are emitted in one pass before rows are submitted, one vertical run per parent.
+	std::vector<FESceneGraphUIConnectorRun> ConnectorRuns;
+	std::unordered_map<int, size_t> ConnectorRunIndices;
+	void DrawTreeConnectorLines(size_t FirstRowIndex, size_t RowCount, float RowPitch);
+	// Filled while rows are submitted and emitted with one vertex reservation.
+	std::vector<FESceneGraphUIRowBackground> RowBackgroundBatch;
+	void FlushRowBackgroundBatch();
+	void DrawAppropriateTreeArrow(const FESceneGraphUIRow& Row);
 
 
 	// Input handling.
@@ -123,15 +342,79 @@ class FESceneGraphUI
 	std::function<void(FENaiveSceneGraphNode*)> ContextMenuRenderingFunction = nullptr;
 	void RenderContextMenu();
 
-	std::vector<std::function<void(FENaiveSceneGraphNode*)>> OnNodeHoveredCallbacks;
-	std::vector<std::function<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)>> OnNodeClickedCallbacks;
-	std::vector<std::function<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)>> OnNodeDoubleClickedCallbacks;
+	std::vector<FESceneGraphUICallbackRegistration<void(FENaiveSceneGraphNode*)>> OnNodeHoveredCallbacks;
+	std::vector<FESceneGraphUICallbackRegistration<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)>> OnNodeClickedCallbacks;
+	std::vector<FESceneGraphUICallbackRegistration<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)>> OnNodeDoubleClickedCallbacks;
 	void CheckInputs(FENaiveSceneGraphNode* Node);
 
 
+	// Drag and drop.
+	// Dragging a selected row drags the whole selection, IDs are captured when drag starts.
+	// Nodes are always dropped into the row, scene graph has no API to change order of children.
+	bool bNodeDragAndDropEnabled = false;
+	std::vector<std::string> DraggedNodeIDs;
+	// Selected row is deselected on release instead of press, so pressing it could start dragging of the selection.
+	std::string NodeIDToDeselectOnRelease = "";
+	ImVec4 DropIndicatorColor = ImVec4(90.0f / 255.0f, 150.0f / 255.0f, 1.0f, 1.0f);
+	void HandleNodeDragAndDrop(size_t RowIndex);
+	void DropDraggedNodes(FENaiveSceneGraphNode* NewParent);
+
+
+	// Keyboard navigation.
+	// It moves focus over flattened rows, so each key press is O(1) and does not rebuild rows.
+	// Focus is separate from selection, Space toggles selection and Enter selects only focused node.
+	bool bKeyboardNavigationEnabled = true;
+	FENaiveSceneGraphNode* FocusedNode = nullptr;
+	std::string FocusedNodeID = "";
+	FE_SCENE_GRAPH_UI_ROW_TYPE FocusedRowType = FE_SCENE_GRAPH_UI_ROW_NODE;
+	std::string FocusedGroupKey = "";
+	int FocusedRowIndex = -1;
+	bool bScrollToFocusedRow = false;
+	ImVec4 FocusedRowFrameColor = ImVec4(48.0f / 255.0f, 95.0f / 255.0f, 213.0f / 255.0f, 1.0f);
+	std::string TypeAheadBuffer = "";
+	double LastTypeAheadTime = 0.0;
+	double TypeAheadTimeout = 1.0;
+	void SetFocusedRow(int RowIndex);
+	void ResolveFocusedRowIndex();
+	void HandleKeyboardNavigation(float RowPitch);
+	int FindRowByTypeAhead(const std::string& Prefix, int StartRowIndex) const;
+	void DrawFocusedRowFrame(size_t RowIndex);
+	// Negative alignment scrolls only as much as needed to make row visible.
+	// Should be called inside of the list box.
+	void ScrollToRow(int RowIndex, float RowPitch, float Alignment = -1.0f);
+
+	std::string NodeIDToScrollTo = "";
+	float ScrollToNodeAlignment = 0.5f;
+
+	// Minimap.
+	// Overview strip beside the list box, marks are rebuilt from rows only when row model changes.
+	bool bMinimapVisible = false;
+	float MinimapWidth = 12.0f;
+	FESceneGraphMinimap Minimap;
+	ImVec4 MinimapSelectionMarkColor = ImVec4(48.0f / 255.0f, 95.0f / 255.0f, 213.0f / 255.0f, 1.0f);
+	ImVec4 MinimapFilterMatchMarkColor = ImVec4(230.0f / 255.0f, 190.0f / 255.0f, 60.0f / 255.0f, 1.0f);
+	ImVec4 MinimapAlertMarkColor = ImVec4(220.0f / 255.0f, 60.0f / 255.0f, 60.0f / 255.0f, 1.0f);
+	int RowIndexToScrollTo = -1;
+	float LastListBoxScrollY = 0.0f;
+	float LastListBoxScrollMaxY = 0.0f;
+	float LastListBoxHeight = 0.0f;
+	bool IsRowAlerted(const FESceneGraphUIRow& Row) const;
+	void UpdateMinimap();
+	void RenderMinimap(ImVec2 Size);
+
+	// Sticky ancestor headers.
+	// Ancestors of the top visible row are pinned over the rows, they are found by following ParentRowIndex.
+	bool bStickyAncestorHeaders = true;
+	size_t MaxStickyAncestorHeaders = 5;
+	// Outermost ancestor first.
+	std::vector<int> GetStickyAncestorRowIndices(size_t FirstVisibleRowIndex) const;
+	// Should be called before rows are submitted, so headers are hovered instead of rows under them.
+	void RenderStickyAncestorHeaders(float RowPitch);
+
+
 	// Before/After render callbacks.
-	std::vector<std::function<void(FENaiveSceneGraphNode*)>> BeforeNodeRenderCallbacks;
-	std::vector<std::function<void(FENaiveSceneGraphNode*)>> AfterNodeRenderCallbacks;
+	std::vector<FESceneGraphUICallbackRegistration<void(FENaiveSceneGraphNode*)>> BeforeNodeRenderCallbacks;
+	std::vector<FESceneGraphUICallbackRegistration<void(FENaiveSceneGraphNode*)>> AfterNodeRenderCallbacks;
 
 
 	// Renaming functionality.
@@ -139,23 +422,76 @@ class FESceneGraphUI
 	char RenameBuffer[1024];
 	bool bLastFrameRenameEditWasVisible = false;
 
+	// Bulk rename.
+	// Selection and current names are captured when popup is opened, so preview does not scan NodeState every frame.
+	bool bShouldOpenBulkRenamePopup = false;
+	FESceneGraphBulkRenameOptions BulkRenameOptions;
+	std::vector<std::string> BulkRenameNodeIDs;
+	std::vector<std::string> BulkRenameCurrentNames;
+	size_t BulkRenamePreviewCount = 8;
+	static constexpr size_t BulkRenameInputBufferSize = 256;
+	char BulkRenameTemplateBuffer[BulkRenameInputBufferSize];
+	char BulkRenameFindBuffer[BulkRenameInputBufferSize];
+	char BulkRenameReplaceBuffer[BulkRenameInputBufferSize];
+	char BulkRenamePrefixBuffer[BulkRenameInputBufferSize];
+	char BulkRenameSuffixBuffer[BulkRenameInputBufferSize];
+	// Order of rows, so counters follow what user sees. Selected nodes without rows go last.
+	std::vector<FENaiveSceneGraphNode*> GetSelectedNodesInRowOrder();
+	// Entity name, display name provider is not used, because it is not what gets renamed.
+	std::string GetNodeName(FENaiveSceneGraphNode* Node) const;
+	void QueueRenameBatch(const std::string& SceneID, const std::vector<std::string>& NodeIDs, const std::vector<std::string>& NewNames);
+	void RenderBulkRenamePopup();
+
 
 	// Node widgets.
 	std::vector<FESceneGraphNodeWidget> NodeWidgets;
+	// Incremented when widgets are added or removed, rows store indices that are valid only for generation they were built with.
+	uint64_t NodeWidgetsGeneration = 0;
+	uint64_t RowsNodeWidgetsGeneration = 0;
 	float WidgetIconVisualRenderingFactor = 0.9f;
 	float YCursorPositionBeforeRenderingWidgets = 0.0f;
 	float YCursorPositionAfterRenderingWidgets = 0.0f;
 
 	bool ShouldRenderWidgetForNode(FENaiveSceneGraphNode* Node, FESceneGraphNodeWidget& Widget, FETexture** IconToUse);
-	float GetNodeWidgetAreaWidth(FENaiveSceneGraphNode* Node);
-	size_t GetNodeWidgetCount(FENaiveSceneGraphNode* Node);
-	void RenderNodeWidgets(FENaiveSceneGraphNode* Node);
+	float GetNodeWidgetAreaWidth(size_t VisibleWidgetCount);
+	void RenderNodeWidgets(const FESceneGraphUIRow& Row);
+
+
+	// Deferred scene graph modifications, commands are kept in per-scene FESceneGraphCommandQueue.
+	// Render applies them on every path, also when panel is hidden or has nothing to show.
+	void ApplyDeferredCommands();
+
+
+	// Change journal consumption.
+	std::string JournalSceneID = "";
+	// Kept for every scene panel has shown, so changes made while a scene was hidden are applied when it is shown again.
+	// Panel holds a journal reference for each of them.
+	std::unordered_map<std::string, uint64_t> LastSeenJournalSequences;
+	// Shared with other panels of the same scene, panel keeps only its view state.
+	FESceneGraphIndex* SceneIndex = nullptr;
+	void SyncWithChangeJournal();
+	// Rows could be outdated if commands or host have recorded changes since the last sync.
+	bool IsSyncedWithChangeJournal() const;
+	// Uses scene index when journal is complete, otherwise falls back to O(n) scene graph search.
+	FENaiveSceneGraphNode* FindNodeByID(const std::string& NodeID);
+	void ApplyChangeRecord(const FESceneGraphChangeRecord& Change);
+	void RemoveStateOfDeletedNodes();
+	void OnNodeRemoved(const std::string& NodeID);
+
+
+	// Profiling.
+	FESceneGraphUIProfiler Profiler;
+	FESceneGraphUITraceSink* TraceSink = nullptr;
+	size_t CallbackRegistrationCount = 0;
+	// Callbacks without explicit name get "<Kind> #<Registration index>".
+	std::string GetCallbackRegistrationName(const std::string& Kind, const std::string& Name);
 
 	
 	// Debug stuff.
 	bool bDebugMode = false;
 	bool bDebugRenderRoot = true;
 	bool bDebugRenderRandomNodeIcons = false;
+	bool bDebugShowProfilerOverlay = false;
 
 	std::vector<std::string> DebugIconsIDs;
 	FETexture* GetDebugIconByIndex(const size_t& IconIndex);
@@ -178,7 +514,39 @@ public:
 	FENaiveSceneGraphNode* GetCurrentRenderingRoot() const;
 
 	void Render(FENaiveSceneGraphNode* RenderingRoot, bool bRenderRootItself = true);
+
+	// Rows are rebuilt automatically when panel state or scene graph (through change journal) changes.
+	// If predicates, providers or widgets depend on some external state, call this when that state changes.
+	// Sibling groups are rebuilt as well.
+	void InvalidateCachedRows();
+	bool IsRowCachingEnabled() const;
+	void SetRowCachingEnabled(bool bNewValue);
+	// Host should enable it only if every scene graph change is recorded in FESceneGraphChangeJournal (including renames).
+	// Until then rows are rebuilt every frame, and filtering and node lookups use the scene instead of the scene index,
+	// so deleted nodes are never accessed through cached pointers and names are never outdated.
+	// Rows can not be validated without the journal: any check would read pointers of nodes that could be already deleted.
+	bool IsSceneChangeJournalComplete() const;
+	void SetSceneChangeJournalComplete(bool bNewValue);
+
+	// Headless access to rows, it does not need ImGui context, so it can be used in tests and benchmarks.
+	// It applies queued commands, catches up with the change journal and rebuilds rows if needed.
+	const FESceneGraphRowModel& UpdateRowModel(FENaiveSceneGraphNode* RenderingRoot, bool bRenderRootItself = true);
+	const FESceneGraphRowModel& GetRowModel() const;
+
+	// Per-phase timings and counters, collected only when FE_SCENE_GRAPH_UI_PROFILING is defined and profiling is enabled.
+	bool IsProfilingEnabled() const;
+	void SetProfilingEnabled(bool bNewValue);
+	const FESceneGraphUIProfiler& GetProfiler() const;
+	FESceneGraphUIFrameProfile GetLastFrameProfile() const;
+	void RenderProfilerOverlay();
+
+	// Sink is not owned by the panel and should outlive it or be reset to nullptr.
+	FESceneGraphUITraceSink* GetTraceSink() const;
+	void SetTraceSink(FESceneGraphUITraceSink* NewSink);
 	float GetFontSize() const;
+	std::string GetFontPath() const;
+	// Empty path keeps default ImGui font.
+	void SetFontPath(const std::string& NewValue);
 	void SetFontSize(float NewFontSize);
 
 	void SetNodeRenderPredicate(std::function<bool(FENaiveSceneGraphNode*)> Predicate);
@@ -188,9 +556,11 @@ public:
 	void SetNodeIconProvider(std::function<FETexture* (FENaiveSceneGraphNode*)> Provider);
 	void ClearAllProvidersAndPredicates();
 
-	void AddBeforeNodeRenderCallback(std::function<void(FENaiveSceneGraphNode*)> Callback);
-	void AddAfterNodeRenderCallback(std::function<void(FENaiveSceneGraphNode*)> Callback);
+	void AddBeforeNodeRenderCallback(std::function<void(FENaiveSceneGraphNode*)> Callback, const std::string& Name = "");
+	void AddAfterNodeRenderCallback(std::function<void(FENaiveSceneGraphNode*)> Callback, const std::string& Name = "");
 
+	bool IsMultipleNodeSelectionAllowed() const;
+	void SetMultipleNodeSelectionAllowed(bool bNewValue);
 	std::vector<std::string> GetSelectedNodeIDs() const;
 	bool IsNodeSelected(FENaiveSceneGraphNode* Node);
 	void SetNodeSelected(FENaiveSceneGraphNode* Node, bool bSelected);
@@ -198,14 +568,107 @@ public:
 	void SetNodeExpanded(FENaiveSceneGraphNode* Node, bool bExpanded);
 	bool IsNodeExpandedTo(FENaiveSceneGraphNode* Node);
 	void ExpandToNode(FENaiveSceneGraphNode* Node);
+	// Expands ancestors and scrolls list box to node on the next Render.
+	// With complete change journal only rows of the revealed subtree are built, rows of other nodes are shifted.
+	// Alignment is 0.0f for top, 0.5f for center and 1.0f for bottom, negative value scrolls only if node is not visible.
+	void ScrollToNode(FENaiveSceneGraphNode* Node, float Alignment = 0.5f);
+
+	// Only children of hoisted node are shown, path to it is shown as breadcrumbs.
+	// nullptr returns to rendering root that is passed to Render.
+	void HoistNode(FENaiveSceneGraphNode* Node);
+	FENaiveSceneGraphNode* GetHoistedNode();
+	bool IsBreadcrumbsVisible() const;
+	void SetBreadcrumbsVisible(bool bNewValue);
+	size_t GetMaxRootViews() const;
+	void SetMaxRootViews(size_t NewValue);
+
+	// Expansion, selection, hoisted node, scroll, filter and sort mode of the current scene.
+	// Custom sort key provider and other callbacks are not part of the state.
+	FESceneGraphUIPersistentState CaptureState();
+	// Nodes that are no longer in the scene are skipped, returns false if the scene itself does not exist.
+	bool ApplyState(const FESceneGraphUIPersistentState& State);
+	bool SaveState(const std::string& FilePath);
+	bool LoadState(const std::string& FilePath);
 	void ExpandAllNodes();
 	void CollapseAllNodes();
+
+	bool CanUndoViewOperation() const;
+	bool CanRedoViewOperation() const;
+	void UndoViewOperation();
+	void RedoViewOperation();
+	void ClearViewHistory();
+	const FESceneGraphViewHistory& GetViewHistory() const;
+	size_t GetMaxViewHistorySteps() const;
+	void SetMaxViewHistorySteps(size_t NewValue);
+	// Ctrl+Z and Ctrl+Y (Ctrl+Shift+Z) when the list box is focused.
+	bool IsViewHistoryShortcutsEnabled() const;
+	void SetViewHistoryShortcutsEnabled(bool bNewValue);
+
+	// 0 disables paging of children.
+	size_t GetChildPagingThreshold() const;
+	void SetChildPagingThreshold(size_t NewValue);
+	size_t GetChildPageSize() const;
+	void SetChildPageSize(size_t NewValue);
+	void LoadNextChildPage(FENaiveSceneGraphNode* Node);
+	void LoadAllChildren(FENaiveSceneGraphNode* Node);
+
+	FE_SCENE_GRAPH_UI_CHILDREN_SORT_MODE GetChildrenSortMode() const;
+	bool IsChildrenSortAscending() const;
+	void SetChildrenSortMode(FE_SCENE_GRAPH_UI_CHILDREN_SORT_MODE NewMode, bool bAscending = true);
+	// Used by FE_SCENE_GRAPH_UI_CHILDREN_SORT_CUSTOM.
+	void SetChildrenSortKeyProvider(std::function<std::string(FENaiveSceneGraphNode*)> Provider);
+	// Used by FE_SCENE_GRAPH_UI_CHILDREN_SORT_ENTITY_TYPE, without it nodes without entity go first.
+	void SetEntityTypeProvider(std::function<std::string(FENaiveSceneGraphNode*)> Provider);
+	// Sort keys that are not tracked by the change journal (tags, custom keys) should be reported with this.
+	// nullptr drops cached order of all parents.
+	void InvalidateChildrenSortOrder(FENaiveSceneGraphNode* Parent = nullptr);
+
+	// Selection and filtering see through groups, scene graph itself is not changed.
+	FE_SCENE_GRAPH_UI_SIBLING_GROUPING GetSiblingGroupingMode() const;
+	void SetSiblingGroupingMode(FE_SCENE_GRAPH_UI_SIBLING_GROUPING NewValue);
+	size_t GetSiblingGroupingThreshold() const;
+	void SetSiblingGroupingThreshold(size_t NewValue);
+	size_t GetAlphabeticalSiblingGroupSize() const;
+	void SetAlphabeticalSiblingGroupSize(size_t NewValue);
 	
+	// Minimap marks selected rows, filter matches and rows with alert widgets, click on it scrolls there.
+	bool IsMinimapVisible() const;
+	void SetMinimapVisible(bool bNewValue);
+	size_t GetMinimapResolution() const;
+	void SetMinimapResolution(size_t NewValue);
+	const FESceneGraphMinimap& GetMinimap();
+
+	bool IsIconAtlasEnabled() const;
+	void SetIconAtlasEnabled(bool bNewValue);
+	// Icons are also added on first use, this allows to pack them before they are visible.
+	bool RegisterIconInAtlas(FETexture* Icon);
+	// Atlas keeps a copy of icon pixels, this should be called after content of icon texture has changed.
+	void RefreshIconInAtlas(FETexture* Icon);
+	void ClearIconAtlas();
+	// nullptr until the first icon is packed.
+	FETexture* GetIconAtlasTexture() const;
+
+	// Click on header scrolls to its row, click on its arrow collapses it.
+	bool IsStickyAncestorHeadersEnabled() const;
+	void SetStickyAncestorHeadersEnabled(bool bNewValue);
+	// Nearest ancestors are kept if hierarchy is deeper, 0 disables headers.
+	size_t GetMaxStickyAncestorHeaders() const;
+	void SetMaxStickyAncestorHeaders(size_t NewValue);
+
 	std::vector<std::string> GetHiddenEntityTags() const;
 	void SetHiddenEntityTags(const std::vector<std::string>& NewHiddenEntityTags);
 	void AddHiddenEntityTag(const std::string& TagToAdd);
 	void RemoveHiddenEntityTag(const std::string& TagToRemove);
 	void ClearHiddenEntityTags();
+	// Checks hidden tags, text filter and render predicate.
+	bool ShouldNodeBeVisible(FENaiveSceneGraphNode* Node);
+
+	std::string GetFilterText() const;
+	void SetFilterText(const std::string& NewFilterText);
+	bool DoesNodePassTextFilter(FENaiveSceneGraphNode* Node);
+
+	// nullptr until panel was rendered or rendering root was set.
+	FESceneGraphIndex* GetSceneIndex() const;
 
 	FESceneGraphNodeWidget* GetNodeWidgetByID(const std::string& WidgetID);
 	std::vector<FESceneGraphNodeWidget> GetAllNodeWidgets() const;
@@ -213,16 +676,16 @@ public:
 	bool RemoveNodeWidget(const std::string& WidgetID);
 	void ClearNodeWidgets();
 
-	void AddOnNodeHoveredCallback(std::function<void(FENaiveSceneGraphNode*)> Callback);
+	void AddOnNodeHoveredCallback(std::function<void(FENaiveSceneGraphNode*)> Callback, const std::string& Name = "");
 	void ClearOnNodeHoveredCallbacks();
 
-	void AddOnNodeClickedCallback(std::function<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)> Callback);
+	void AddOnNodeClickedCallback(std::function<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)> Callback, const std::string& Name = "");
 	void ClearOnNodeClickedCallbacks();
 
-	void AddOnNodeDoubleClickedCallback(std::function<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)> Callback);
+	void AddOnNodeDoubleClickedCallback(std::function<void(FENaiveSceneGraphNode*, ImGuiMouseButton_)> Callback, const std::string& Name = "");
 	void ClearOnNodeDoubleClickedCallbacks();
 
-	void AddOnNodeSelectionChangedCallback(std::function<void(FENaiveSceneGraphNode*, bool)> Callback);
+	void AddOnNodeSelectionChangedCallback(std::function<void(FENaiveSceneGraphNode*, bool)> Callback, const std::string& Name = "");
 	void ClearOnNodeSelectionChangedCallbacks();
 
 	void ClearAllInputCallbacks();
@@ -231,9 +694,37 @@ public:
 	void SetContextMenuRenderingFunction(std::function<void(FENaiveSceneGraphNode*)> Function);
 	void ClearContextMenuRenderingFunction();
 
+	// Off by default, when enabled pressing a selected row deselects it on release instead of press.
+	bool IsNodeDragAndDropEnabled() const;
+	void SetNodeDragAndDropEnabled(bool bNewValue);
+
+	bool IsKeyboardNavigationEnabled() const;
+	void SetKeyboardNavigationEnabled(bool bNewValue);
+	FENaiveSceneGraphNode* GetFocusedNode() const;
+	// Focus is applied if node has a visible row.
+	void SetFocusedNode(FENaiveSceneGraphNode* Node);
+
 	bool IsNodeBeingRenamed(FENaiveSceneGraphNode* Node);
 	bool ActivateRenameForNode(FENaiveSceneGraphNode* Node);
 
+	// Callbacks invoked during Render should not modify the scene graph directly.
+	// Instead they should queue changes, that will be applied after traversal of the scene graph is finished.
+	// Queue* helpers read the live scene, so they should be called on the UI thread, only QueueCommand is thread-safe.
+	void QueueNodeDeletion(FENaiveSceneGraphNode* Node);
+	void QueueNodeMove(FENaiveSceneGraphNode* Node, FENaiveSceneGraphNode* NewParent);
+	// Nodes that are inside of other moved nodes keep their place in the moved subtree.
+	void QueueNodesMove(const std::vector<FENaiveSceneGraphNode*>& Nodes, FENaiveSceneGraphNode* NewParent);
+	void QueueNodeRename(FENaiveSceneGraphNode* Node, const std::string& NewName);
+	void QueueNodesRename(const std::vector<FENaiveSceneGraphNode*>& Nodes, const std::vector<std::string>& NewNames);
+	// Renames all selected nodes with one command, returns false if options are not valid (e.g. wrong regex).
+	bool QueueSelectionRename(const FESceneGraphBulkRenameOptions& Options);
+	void OpenBulkRenamePopup();
+	void QueueEntityCreation(const std::string& Name, FENaiveSceneGraphNode* Parent = nullptr);
+	// Thread-safe, command should reference nodes and scene by IDs. Same as FESceneGraphCommandQueue::Push.
+	void QueueCommand(const FESceneGraphUICommand& Command);
+	// Commands of the current scene. Per-frame limit is set with FESceneGraphCommandQueue::SetMaxCommandsAppliedPerFrame.
+	size_t GetQueuedCommandCount();
+
 	bool IsInDebugMode();
 	void SetDebugMode(bool bNewValue);
 
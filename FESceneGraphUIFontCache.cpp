@@ -0,0 +1,107 @@
+#include "FESceneGraphUIFontCache.h"
+
+std::unordered_map<std::string, FESceneGraphUIFontCacheEntry>& FESceneGraphUIFontCache::GetEntries()
+{
+	static std::unordered_map<std::string, FESceneGraphUIFontCacheEntry> Entries;
+	return Entries;
+}
+
+void FESceneGraphUIFontCache::Acquire(const std::string& Path)
+{
+	if (Path.empty())
+		return;
+
+	FESceneGraphUIFontCacheEntry& Entry = GetEntries()[Path];
+	Entry.ReferenceCount++;
+	if (Entry.ReferenceCount > 1)
+		return;
+
+	Entry.PendingFileData = std::async(std::launch::async, [Path]() {
+		std::vector<char> Result;
+		std::ifstream File(Path, std::ios::binary | std::ios::ate);
+		if (!File.is_open())
+			return Result;
+
+		std::streamsize FileSize = File.tellg();
+		if (FileSize <= 0)
+			return Result;
+
+		Result.resize(static_cast<size_t>(FileSize));
+		File.seekg(0, std::ios::beg);
+		if (!File.read(Result.data(), FileSize))
+			Result.clear();
+
+		return Result;
+	});
+}
+
+void FESceneGraphUIFontCache::Release(const std::string& Path)
+{
+	std::unordered_map<std::string, FESceneGraphUIFontCacheEntry>& Entries = GetEntries();
+	auto Iterator = Entries.find(Path);
+	if (Iterator == Entries.end())
+		return;
+
+	FESceneGraphUIFontCacheEntry& Entry = Iterator->second;
+	if (--Entry.ReferenceCount > 0)
+		return;
+
+	// Atlas could be already destroyed together with its context, so font is removed only from the current one.
+	if (Entry.Font != nullptr && ImGui::GetCurrentContext() != nullptr && ImGui::GetIO().Fonts == Entry.Atlas)
+		Entry.Atlas->RemoveFont(Entry.Font);
+
+	// Waits for background read if it is still running.
+	Entries.erase(Iterator);
+}
+
+ImFont* FESceneGraphUIFontCache::GetFont(const std::string& Path, float SizePixels)
+{
+	std::unordered_map<std::string, FESceneGraphUIFontCacheEntry>& Entries = GetEntries();
+	auto Iterator = Entries.find(Path);
+	if (Iterator == Entries.end() || ImGui::GetCurrentContext() == nullptr)
+		return nullptr;
+
+	FESceneGraphUIFontCacheEntry& Entry = Iterator->second;
+	if (Entry.Font != nullptr || Entry.bFailed)
+		return Entry.Font;
+
+	if (!Entry.PendingFileData.valid() || Entry.PendingFileData.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return nullptr;
+
+	Entry.FileData = Entry.PendingFileData.get();
+	if (Entry.FileData.empty())
+	{
+		Entry.bFailed = true;
+		return nullptr;
+	}
+
+	// Data stays in the cache, so atlas should not free it.
+	ImFontConfig FontConfig;
+	FontConfig.FontDataOwnedByAtlas = false;
+	Entry.Atlas = ImGui::GetIO().Fonts;
+	Entry.Font = Entry.Atlas->AddFontFromMemoryTTF(Entry.FileData.data(), static_cast<int>(Entry.FileData.size()), SizePixels, &FontConfig);
+	if (Entry.Font == nullptr)
+		Entry.bFailed = true;
+
+	return Entry.Font;
+}
+
+bool FESceneGraphUIFontCache::IsLoading(const std::string& Path)
+{
+	std::unordered_map<std::string, FESceneGraphUIFontCacheEntry>& Entries = GetEntries();
+	auto Iterator = Entries.find(Path);
+	if (Iterator == Entries.end())
+		return false;
+
+	return Iterator->second.Font == nullptr && !Iterator->second.bFailed;
+}
+
+bool FESceneGraphUIFontCache::HasFailed(const std::string& Path)
+{
+	std::unordered_map<std::string, FESceneGraphUIFontCacheEntry>& Entries = GetEntries();
+	auto Iterator = Entries.find(Path);
+	if (Iterator == Entries.end())
+		return false;
+
+	return Iterator->second.bFailed;
+}
\ No newline at end of file
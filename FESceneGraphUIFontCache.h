@@ -0,0 +1,32 @@
+#pragma once
+#include "FEngine.h"
+#include <future>
+
+struct FESceneGraphUIFontCacheEntry
+{
+	size_t ReferenceCount = 0;
+	// File is read on a background thread, font is created from memory on UI thread when data is ready.
+	std::future<std::vector<char>> PendingFileData;
+	std::vector<char> FileData;
+	ImFontAtlas* Atlas = nullptr;
+	ImFont* Font = nullptr;
+	bool bFailed = false;
+};
+
+// Fonts shared by all scene graph panels, so each font file is read and parsed once.
+// All functions should be called from UI thread.
+class FESceneGraphUIFontCache
+{
+	static std::unordered_map<std::string, FESceneGraphUIFontCacheEntry>& GetEntries();
+public:
+	// Starts reading of the file in background, if it is not loaded yet.
+	static void Acquire(const std::string& Path);
+	// Font is removed from ImGui font atlas when the last reference is released.
+	static void Release(const std::string& Path);
+
+	// Does not block, returns nullptr while file is still being read or if it could not be read.
+	// Should be called with ImGui context, font is added to its font atlas.
+	static ImFont* GetFont(const std::string& Path, float SizePixels = 32.0f);
+	static bool IsLoading(const std::string& Path);
+	static bool HasFailed(const std::string& Path);
+};
\ No newline at end of file
@@ -0,0 +1,308 @@
+#include "FESceneGraphUIProfiler.h"
+
+std::string FESceneGraphUIProfiler::PhaseToString(FE_SCENE_GRAPH_UI_PROFILER_PHASE Phase)
+{
+	switch (Phase)
+	{
+		case FE_SCENE_GRAPH_UI_PHASE_ROW_REBUILD:
+			return "Row rebuild";
+		case FE_SCENE_GRAPH_UI_PHASE_FILTERING:
+			return "Filtering";
+		case FE_SCENE_GRAPH_UI_PHASE_PREDICATES:
+			return "Predicates";
+		case FE_SCENE_GRAPH_UI_PHASE_PROVIDERS:
+			return "Providers";
+		case FE_SCENE_GRAPH_UI_PHASE_WIDGET_EVALUATION:
+			return "Widget evaluation";
+		case FE_SCENE_GRAPH_UI_PHASE_TEXT_TRUNCATION:
+			return "Text truncation";
+		case FE_SCENE_GRAPH_UI_PHASE_DRAW_SUBMISSION:
+			return "Draw submission";
+		case FE_SCENE_GRAPH_UI_PHASE_DEFERRED_COMMANDS:
+			return "Deferred commands";
+		default:
+			return "Unknown";
+	}
+}
+
+std::string FESceneGraphUIProfiler::CounterToString(FE_SCENE_GRAPH_UI_PROFILER_COUNTER Counter)
+{
+	switch (Counter)
+	{
+		case FE_SCENE_GRAPH_UI_COUNTER_NODES_VISITED:
+			return "Nodes visited";
+		case FE_SCENE_GRAPH_UI_COUNTER_PREDICATE_CALLS:
+			return "Predicate calls";
+		case FE_SCENE_GRAPH_UI_COUNTER_PROVIDER_CALLS:
+			return "Provider calls";
+		case FE_SCENE_GRAPH_UI_COUNTER_STRING_BUILDS:
+			return "String builds";
+		case FE_SCENE_GRAPH_UI_COUNTER_IMGUI_ITEMS:
+			return "ImGui items";
+		case FE_SCENE_GRAPH_UI_COUNTER_ROWS_SUBMITTED:
+			return "Rows submitted";
+		default:
+			return "Unknown";
+	}
+}
+
+bool FESceneGraphUIProfiler::IsEnabled() const
+{
+	return bEnabled;
+}
+
+void FESceneGraphUIProfiler::SetEnabled(bool bNewValue)
+{
+	if (!IsCompiledIn())
+		return;
+
+	bEnabled = bNewValue;
+	bFrameActive = false;
+}
+
+void FESceneGraphUIProfiler::BeginFrame()
+{
+	if (!bEnabled)
+		return;
+
+	CurrentFrame = FESceneGraphUIFrameProfile();
+	CurrentFrame.FrameIndex = FrameIndex++;
+	FrameStartTime = std::chrono::high_resolution_clock::now();
+	bFrameActive = true;
+}
+
+void FESceneGraphUIProfiler::EndFrame()
+{
+	if (!bEnabled || !bFrameActive)
+		return;
+
+	std::chrono::duration<double, std::milli> Elapsed = std::chrono::high_resolution_clock::now() - FrameStartTime;
+	CurrentFrame.FrameMilliseconds = Elapsed.count();
+	bFrameActive = false;
+
+	if (HistoryCapacity == 0)
+		return;
+
+	if (History.size() < HistoryCapacity)
+	{
+		History.push_back(CurrentFrame);
+	}
+	else
+	{
+		History[HistoryStart] = CurrentFrame;
+		HistoryStart = (HistoryStart + 1) % History.size();
+	}
+}
+
+void FESceneGraphUIProfiler::AddPhaseTime(FE_SCENE_GRAPH_UI_PROFILER_PHASE Phase, double Milliseconds)
+{
+	if (!bFrameActive || Phase >= FE_SCENE_GRAPH_UI_PHASE_COUNT)
+		return;
+
+	CurrentFrame.PhaseMilliseconds[Phase] += Milliseconds;
+}
+
+void FESceneGraphUIProfiler::IncrementCounter(FE_SCENE_GRAPH_UI_PROFILER_COUNTER Counter, uint64_t Amount)
+{
+	if (!bFrameActive || Counter >= FE_SCENE_GRAPH_UI_COUNTER_COUNT)
+		return;
+
+	CurrentFrame.Counters[Counter] += Amount;
+}
+
+FESceneGraphUIFrameProfile FESceneGraphUIProfiler::GetLastFrame() const
+{
+	if (History.empty())
+		return FESceneGraphUIFrameProfile();
+
+	size_t LastIndex = (HistoryStart + History.size() - 1) % History.size();
+	return History[LastIndex];
+}
+
+std::vector<FESceneGraphUIFrameProfile> FESceneGraphUIProfiler::GetHistory() const
+{
+	std::vector<FESceneGraphUIFrameProfile> Result;
+	Result.reserve(History.size());
+	for (size_t i = 0; i < History.size(); i++)
+		Result.push_back(History[(HistoryStart + i) % History.size()]);
+
+	return Result;
+}
+
+FESceneGraphUIFrameProfile FESceneGraphUIProfiler::GetAverageOverHistory() const
+{
+	FESceneGraphUIFrameProfile Result;
+	if (History.empty())
+		return Result;
+
+	for (const FESceneGraphUIFrameProfile& Frame : History)
+	{
+		Result.FrameMilliseconds += Frame.FrameMilliseconds;
+		for (size_t i = 0; i < FE_SCENE_GRAPH_UI_PHASE_COUNT; i++)
+			Result.PhaseMilliseconds[i] += Frame.PhaseMilliseconds[i];
+		for (size_t i = 0; i < FE_SCENE_GRAPH_UI_COUNTER_COUNT; i++)
+			Result.Counters[i] += Frame.Counters[i];
+	}
+
+	Result.FrameIndex = GetLastFrame().FrameIndex;
+	Result.FrameMilliseconds /= static_cast<double>(History.size());
+	for (size_t i = 0; i < FE_SCENE_GRAPH_UI_PHASE_COUNT; i++)
+		Result.PhaseMilliseconds[i] /= static_cast<double>(History.size());
+	for (size_t i = 0; i < FE_SCENE_GRAPH_UI_COUNTER_COUNT; i++)
+		Result.Counters[i] /= History.size();
+
+	return Result;
+}
+
+void FESceneGraphUIProfiler::ClearHistory()
+{
+	History.clear();
+	HistoryStart = 0;
+}
+
+size_t FESceneGraphUIProfiler::GetHistoryCapacity() const
+{
+	return HistoryCapacity;
+}
+
+void FESceneGraphUIProfiler::SetHistoryCapacity(size_t NewValue)
+{
+	std::vector<FESceneGraphUIFrameProfile> OrderedHistory = GetHistory();
+	if (OrderedHistory.size() > NewValue)
+		OrderedHistory.erase(OrderedHistory.begin(), OrderedHistory.begin() + (OrderedHistory.size() - NewValue));
+
+	History = OrderedHistory;
+	HistoryStart = 0;
+	HistoryCapacity = NewValue;
+}
+
+void FESceneGraphUIProfiler::RenderOverlay(const std::string& WindowName)
+{
+	ImGui::SetNextWindowSize(ImVec2(420.0f, 460.0f), ImGuiCond_FirstUseEver);
+	if (!ImGui::Begin(WindowName.c_str()))
+	{
+		ImGui::End();
+		return;
+	}
+
+	if (!IsCompiledIn())
+	{
+		ImGui::TextUnformatted("Profiling is not compiled in, define FE_SCENE_GRAPH_UI_PROFILING to use it.");
+		ImGui::End();
+		return;
+	}
+
+	bool bNewEnabled = bEnabled;
+	if (ImGui::Checkbox("Enabled", &bNewEnabled))
+		SetEnabled(bNewEnabled);
+
+	ImGui::SameLine();
+	if (ImGui::Button("Clear history"))
+		ClearHistory();
+
+	FESceneGraphUIFrameProfile LastFrame = GetLastFrame();
+	FESceneGraphUIFrameProfile AverageFrame = GetAverageOverHistory();
+	std::vector<FESceneGraphUIFrameProfile> OrderedHistory = GetHistory();
+
+	ImGui::Text("Frame: %.3f ms (average %.3f ms over %d frames)", LastFrame.FrameMilliseconds, AverageFrame.FrameMilliseconds, static_cast<int>(OrderedHistory.size()));
+
+	if (ImGui::BeginTable("##Scene graph profiler phases", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Phase");
+		ImGui::TableSetupColumn("Last ms");
+		ImGui::TableSetupColumn("Average ms");
+		ImGui::TableSetupColumn("Max ms");
+		ImGui::TableHeadersRow();
+
+		for (size_t i = 0; i < FE_SCENE_GRAPH_UI_PHASE_COUNT; i++)
+		{
+			double MaxMilliseconds = 0.0;
+			for (const FESceneGraphUIFrameProfile& Frame : OrderedHistory)
+				MaxMilliseconds = std::max(MaxMilliseconds, Frame.PhaseMilliseconds[i]);
+
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0);
+			ImGui::TextUnformatted(PhaseToString(static_cast<FE_SCENE_GRAPH_UI_PROFILER_PHASE>(i)).c_str());
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text("%.3f", LastFrame.PhaseMilliseconds[i]);
+			ImGui::TableSetColumnIndex(2);
+			ImGui::Text("%.3f", AverageFrame.PhaseMilliseconds[i]);
+			ImGui::TableSetColumnIndex(3);
+			ImGui::Text("%.3f", MaxMilliseconds);
+		}
+
+		ImGui::EndTable();
+	}
+
+	if (ImGui::BeginTable("##Scene graph profiler counters", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Counter");
+		ImGui::TableSetupColumn("Last");
+		ImGui::TableSetupColumn("Average");
+		ImGui::TableHeadersRow();
+
+		for (size_t i = 0; i < FE_SCENE_GRAPH_UI_COUNTER_COUNT; i++)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0);
+			ImGui::TextUnformatted(CounterToString(static_cast<FE_SCENE_GRAPH_UI_PROFILER_COUNTER>(i)).c_str());
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text("%llu", static_cast<unsigned long long>(LastFrame.Counters[i]));
+			ImGui::TableSetColumnIndex(2);
+			ImGui::Text("%llu", static_cast<unsigned long long>(AverageFrame.Counters[i]));
+		}
+
+		ImGui::EndTable();
+	}
+
+	// -1 - whole frame, otherwise phase index.
+	std::vector<std::string> GraphSourceNames = { "Frame" };
+	for (size_t i = 0; i < FE_SCENE_GRAPH_UI_PHASE_COUNT; i++)
+		GraphSourceNames.push_back(PhaseToString(static_cast<FE_SCENE_GRAPH_UI_PROFILER_PHASE>(i)));
+
+	std::vector<const char*> GraphSourceNamesCStr;
+	for (const std::string& Name : GraphSourceNames)
+		GraphSourceNamesCStr.push_back(Name.c_str());
+
+	int SelectedGraphSource = OverlayGraphPhase + 1;
+	if (ImGui::Combo("Graph", &SelectedGraphSource, GraphSourceNamesCStr.data(), static_cast<int>(GraphSourceNamesCStr.size())))
+		OverlayGraphPhase = SelectedGraphSource - 1;
+
+	std::vector<float> GraphValues;
+	GraphValues.reserve(OrderedHistory.size());
+	for (const FESceneGraphUIFrameProfile& Frame : OrderedHistory)
+		GraphValues.push_back(static_cast<float>(OverlayGraphPhase == -1 ? Frame.FrameMilliseconds : Frame.PhaseMilliseconds[OverlayGraphPhase]));
+
+	ImGui::PlotLines("##Scene graph profiler history", GraphValues.data(), static_cast<int>(GraphValues.size()), 0, "ms", 0.0f, FLT_MAX, ImVec2(ImGui::GetContentRegionAvail().x, 80.0f));
+
+	ImGui::End();
+}
+
+FESceneGraphUIProfilerPhaseScope::FESceneGraphUIProfilerPhaseScope(FESceneGraphUIProfiler& Profiler, FE_SCENE_GRAPH_UI_PROFILER_PHASE Phase) : Phase(Phase)
+{
+	// Clock is not touched when profiler is disabled at runtime.
+	if (!Profiler.IsEnabled())
+		return;
+
+	this->Profiler = &Profiler;
+	StartTime = std::chrono::high_resolution_clock::now();
+}
+
+FESceneGraphUIProfilerPhaseScope::~FESceneGraphUIProfilerPhaseScope()
+{
+	if (Profiler == nullptr)
+		return;
+
+	std::chrono::duration<double, std::milli> Elapsed = std::chrono::high_resolution_clock::now() - StartTime;
+	Profiler->AddPhaseTime(Phase, Elapsed.count());
+}
+
+FESceneGraphUIProfilerFrameScope::FESceneGraphUIProfilerFrameScope(FESceneGraphUIProfiler& Profiler) : Profiler(Profiler)
+{
+	Profiler.BeginFrame();
+}
+
+FESceneGraphUIProfilerFrameScope::~FESceneGraphUIProfilerFrameScope()
+{
+	Profiler.EndFrame();
+}
\ No newline at end of file
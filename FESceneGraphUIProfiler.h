@@ -0,0 +1,121 @@
+#pragma once
+#include "FEngine.h"
+#include <chrono>
+
+// Profiling is compiled in only when FE_SCENE_GRAPH_UI_PROFILING is defined (FE_SCENE_GRAPH_UI_ENABLE_PROFILING CMake option).
+// Otherwise all profiling macros expand to nothing and panel does not pay for it.
+// When compiled in, it still should be enabled at runtime with SetEnabled.
+
+enum FE_SCENE_GRAPH_UI_PROFILER_PHASE
+{
+	FE_SCENE_GRAPH_UI_PHASE_ROW_REBUILD = 0,
+	FE_SCENE_GRAPH_UI_PHASE_FILTERING = 1,
+	FE_SCENE_GRAPH_UI_PHASE_PREDICATES = 2,
+	FE_SCENE_GRAPH_UI_PHASE_PROVIDERS = 3,
+	FE_SCENE_GRAPH_UI_PHASE_WIDGET_EVALUATION = 4,
+	FE_SCENE_GRAPH_UI_PHASE_TEXT_TRUNCATION = 5,
+	FE_SCENE_GRAPH_UI_PHASE_DRAW_SUBMISSION = 6,
+	FE_SCENE_GRAPH_UI_PHASE_DEFERRED_COMMANDS = 7,
+	FE_SCENE_GRAPH_UI_PHASE_COUNT = 8
+};
+
+enum FE_SCENE_GRAPH_UI_PROFILER_COUNTER
+{
+	FE_SCENE_GRAPH_UI_COUNTER_NODES_VISITED = 0,
+	FE_SCENE_GRAPH_UI_COUNTER_PREDICATE_CALLS = 1,
+	FE_SCENE_GRAPH_UI_COUNTER_PROVIDER_CALLS = 2,
+	// Strings that panel builds for rows (node IDs, display names, ImGui IDs, truncated text).
+	// It is not a heap allocation count, short strings could fit in the small string buffer.
+	FE_SCENE_GRAPH_UI_COUNTER_STRING_BUILDS = 3,
+	FE_SCENE_GRAPH_UI_COUNTER_IMGUI_ITEMS = 4,
+	FE_SCENE_GRAPH_UI_COUNTER_ROWS_SUBMITTED = 5,
+	FE_SCENE_GRAPH_UI_COUNTER_COUNT = 6
+};
+
+// Phases could be nested (e.g. predicates are called during row rebuild), so they do not add up to the frame time.
+struct FESceneGraphUIFrameProfile
+{
+	uint64_t FrameIndex = 0;
+	double FrameMilliseconds = 0.0;
+	double PhaseMilliseconds[FE_SCENE_GRAPH_UI_PHASE_COUNT] = {};
+	uint64_t Counters[FE_SCENE_GRAPH_UI_COUNTER_COUNT] = {};
+};
+
+class FESceneGraphUIProfiler
+{
+	bool bEnabled = false;
+	bool bFrameActive = false;
+	std::chrono::high_resolution_clock::time_point FrameStartTime;
+	uint64_t FrameIndex = 0;
+	FESceneGraphUIFrameProfile CurrentFrame;
+
+	// Ring buffer, HistoryStart points to the oldest frame.
+	std::vector<FESceneGraphUIFrameProfile> History;
+	size_t HistoryStart = 0;
+	size_t HistoryCapacity = 240;
+
+	int OverlayGraphPhase = -1;
+public:
+	static constexpr bool IsCompiledIn()
+	{
+#ifdef FE_SCENE_GRAPH_UI_PROFILING
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	static std::string PhaseToString(FE_SCENE_GRAPH_UI_PROFILER_PHASE Phase);
+	static std::string CounterToString(FE_SCENE_GRAPH_UI_PROFILER_COUNTER Counter);
+
+	bool IsEnabled() const;
+	void SetEnabled(bool bNewValue);
+
+	void BeginFrame();
+	void EndFrame();
+	void AddPhaseTime(FE_SCENE_GRAPH_UI_PROFILER_PHASE Phase, double Milliseconds);
+	void IncrementCounter(FE_SCENE_GRAPH_UI_PROFILER_COUNTER Counter, uint64_t Amount = 1);
+
+	// Last finished frame.
+	FESceneGraphUIFrameProfile GetLastFrame() const;
+	// Oldest frame first.
+	std::vector<FESceneGraphUIFrameProfile> GetHistory() const;
+	FESceneGraphUIFrameProfile GetAverageOverHistory() const;
+	void ClearHistory();
+
+	size_t GetHistoryCapacity() const;
+	void SetHistoryCapacity(size_t NewValue);
+
+	void RenderOverlay(const std::string& WindowName);
+};
+
+class FESceneGraphUIProfilerPhaseScope
+{
+	FESceneGraphUIProfiler* Profiler = nullptr;
+	FE_SCENE_GRAPH_UI_PROFILER_PHASE Phase;
+	std::chrono::high_resolution_clock::time_point StartTime;
+public:
+	FESceneGraphUIProfilerPhaseScope(FESceneGraphUIProfiler& Profiler, FE_SCENE_GRAPH_UI_PROFILER_PHASE Phase);
+	~FESceneGraphUIProfilerPhaseScope();
+};
+
+class FESceneGraphUIProfilerFrameScope
+{
+	FESceneGraphUIProfiler& Profiler;
+public:
+	FESceneGraphUIProfilerFrameScope(FESceneGraphUIProfiler& Profiler);
+	~FESceneGraphUIProfilerFrameScope();
+};
+
+#define FE_SCENE_GRAPH_UI_PROFILER_CONCAT_INNER(A, B) A##B
+#define FE_SCENE_GRAPH_UI_PROFILER_CONCAT(A, B) FE_SCENE_GRAPH_UI_PROFILER_CONCAT_INNER(A, B)
+
+#ifdef FE_SCENE_GRAPH_UI_PROFILING
+	#define FE_SCENE_GRAPH_UI_PROFILE_FRAME(Profiler) FESceneGraphUIProfilerFrameScope FE_SCENE_GRAPH_UI_PROFILER_CONCAT(ProfilerFrameScope, __LINE__)(Profiler)
+	#define FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, Phase) FESceneGraphUIProfilerPhaseScope FE_SCENE_GRAPH_UI_PROFILER_CONCAT(ProfilerPhaseScope, __LINE__)(Profiler, Phase)
+	#define FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, Counter, Amount) (Profiler).IncrementCounter(Counter, Amount)
+#else
+	#define FE_SCENE_GRAPH_UI_PROFILE_FRAME(Profiler)
+	#define FE_SCENE_GRAPH_UI_PROFILE_PHASE(Profiler, Phase)
+	#define FE_SCENE_GRAPH_UI_PROFILE_COUNT(Profiler, Counter, Amount)
+#endif
\ No newline at end of file
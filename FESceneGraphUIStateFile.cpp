@@ -0,0 +1,269 @@
+#include "FESceneGraphUIStateFile.h"
+
+static const uint8_t StateFileMagic[4] = { 'F', 'E', 'S', 'G' };
+static const uint8_t StateFileVersion = 1;
+
+enum FE_SCENE_GRAPH_UI_STATE_FILE_NODE_FLAG
+{
+	FE_SCENE_GRAPH_UI_STATE_FILE_NODE_EXPANDED = 1 << 0,
+	FE_SCENE_GRAPH_UI_STATE_FILE_NODE_SELECTED = 1 << 1,
+	FE_SCENE_GRAPH_UI_STATE_FILE_NODE_HOISTED = 1 << 2,
+	FE_SCENE_GRAPH_UI_STATE_FILE_NODE_LOADED_CHILD_COUNT = 1 << 3,
+	FE_SCENE_GRAPH_UI_STATE_FILE_NODE_PACKED_UPPER_HEX_ID = 1 << 4,
+	FE_SCENE_GRAPH_UI_STATE_FILE_NODE_PACKED_LOWER_HEX_ID = 1 << 5
+};
+
+enum FE_SCENE_GRAPH_UI_STATE_FILE_OPTION_FLAG
+{
+	FE_SCENE_GRAPH_UI_STATE_FILE_CASE_SENSITIVE_FILTERING = 1 << 0,
+	FE_SCENE_GRAPH_UI_STATE_FILE_CHILDREN_SORT_ASCENDING = 1 << 1
+};
+
+static int GetHexDigitValue(char Character, bool bUpperCase)
+{
+	if (Character >= '0' && Character <= '9')
+		return Character - '0';
+
+	const char FirstLetter = bUpperCase ? 'A' : 'a';
+	if (Character >= FirstLetter && Character <= FirstLetter + 5)
+		return Character - FirstLetter + 10;
+
+	return -1;
+}
+
+static bool IsPackableHex(const std::string& Text, bool bUpperCase)
+{
+	if (Text.empty() || Text.size() % 2 != 0)
+		return false;
+
+	for (size_t i = 0; i < Text.size(); i++)
+	{
+		if (GetHexDigitValue(Text[i], bUpperCase) == -1)
+			return false;
+	}
+
+	return true;
+}
+
+void FESceneGraphUIStateFile::WriteVarint(std::vector<uint8_t>& Data, uint64_t Value)
+{
+	while (Value >= 0x80)
+	{
+		Data.push_back(static_cast<uint8_t>(Value | 0x80));
+		Value >>= 7;
+	}
+	Data.push_back(static_cast<uint8_t>(Value));
+}
+
+void FESceneGraphUIStateFile::WriteString(std::vector<uint8_t>& Data, const std::string& Value)
+{
+	WriteVarint(Data, Value.size());
+	Data.insert(Data.end(), Value.begin(), Value.end());
+}
+
+void FESceneGraphUIStateFile::WriteNodeID(std::vector<uint8_t>& Data, const std::string& NodeID, uint8_t& InOutFlags)
+{
+	bool bUpperCase = IsPackableHex(NodeID, true);
+	if (!bUpperCase && !IsPackableHex(NodeID, false))
+	{
+		WriteString(Data, NodeID);
+		return;
+	}
+
+	InOutFlags |= bUpperCase ? FE_SCENE_GRAPH_UI_STATE_FILE_NODE_PACKED_UPPER_HEX_ID : FE_SCENE_GRAPH_UI_STATE_FILE_NODE_PACKED_LOWER_HEX_ID;
+	WriteVarint(Data, NodeID.size() / 2);
+	for (size_t i = 0; i < NodeID.size(); i += 2)
+		Data.push_back(static_cast<uint8_t>(GetHexDigitValue(NodeID[i], bUpperCase) << 4 | GetHexDigitValue(NodeID[i + 1], bUpperCase)));
+}
+
+bool FESceneGraphUIStateFile::ReadVarint(const uint8_t* Data, size_t Size, size_t& InOutOffset, uint64_t& OutValue)
+{
+	OutValue = 0;
+	for (int Shift = 0; Shift < 64; Shift += 7)
+	{
+		if (InOutOffset >= Size)
+			return false;
+
+		uint8_t Byte = Data[InOutOffset++];
+		OutValue |= static_cast<uint64_t>(Byte & 0x7F) << Shift;
+		if ((Byte & 0x80) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+bool FESceneGraphUIStateFile::ReadString(const uint8_t* Data, size_t Size, size_t& InOutOffset, std::string& OutValue)
+{
+	uint64_t Length = 0;
+	if (!ReadVarint(Data, Size, InOutOffset, Length) || Length > Size - InOutOffset)
+		return false;
+
+	OutValue.assign(reinterpret_cast<const char*>(Data + InOutOffset), static_cast<size_t>(Length));
+	InOutOffset += static_cast<size_t>(Length);
+	return true;
+}
+
+bool FESceneGraphUIStateFile::ReadNodeID(const uint8_t* Data, size_t Size, size_t& InOutOffset, uint8_t Flags, std::string& OutNodeID)
+{
+	const bool bUpperCase = (Flags & FE_SCENE_GRAPH_UI_STATE_FILE_NODE_PACKED_UPPER_HEX_ID) != 0;
+	if (!bUpperCase && (Flags & FE_SCENE_GRAPH_UI_STATE_FILE_NODE_PACKED_LOWER_HEX_ID) == 0)
+		return ReadString(Data, Size, InOutOffset, OutNodeID);
+
+	uint64_t ByteCount = 0;
+	if (!ReadVarint(Data, Size, InOutOffset, ByteCount) || ByteCount > Size - InOutOffset)
+		return false;
+
+	const char* Digits = bUpperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+	OutNodeID.resize(static_cast<size_t>(ByteCount) * 2);
+	for (size_t i = 0; i < ByteCount; i++)
+	{
+		uint8_t Byte = Data[InOutOffset++];
+		OutNodeID[i * 2] = Digits[Byte >> 4];
+		OutNodeID[i * 2 + 1] = Digits[Byte & 0x0F];
+	}
+
+	return true;
+}
+
+std::vector<uint8_t> FESceneGraphUIStateFile::Encode(const FESceneGraphUIPersistentState& State)
+{
+	std::vector<uint8_t> Data(StateFileMagic, StateFileMagic + sizeof(StateFileMagic));
+	Data.push_back(StateFileVersion);
+	WriteString(Data, State.SceneID);
+
+	WriteVarint(Data, State.Nodes.size());
+	for (size_t i = 0; i < State.Nodes.size(); i++)
+	{
+		const FESceneGraphUIPersistentNodeState& Node = State.Nodes[i];
+		uint8_t Flags = 0;
+		if (Node.bExpanded)
+			Flags |= FE_SCENE_GRAPH_UI_STATE_FILE_NODE_EXPANDED;
+		if (Node.bSelected)
+			Flags |= FE_SCENE_GRAPH_UI_STATE_FILE_NODE_SELECTED;
+		if (Node.bHoisted)
+			Flags |= FE_SCENE_GRAPH_UI_STATE_FILE_NODE_HOISTED;
+		if (Node.LoadedChildCount != 0)
+			Flags |= FE_SCENE_GRAPH_UI_STATE_FILE_NODE_LOADED_CHILD_COUNT;
+
+		// Flags are known only after node ID is written, so the placeholder is patched.
+		size_t FlagsOffset = Data.size();
+		Data.push_back(0);
+		WriteNodeID(Data, Node.NodeID, Flags);
+		Data[FlagsOffset] = Flags;
+
+		if (Node.LoadedChildCount != 0)
+			WriteVarint(Data, Node.LoadedChildCount);
+	}
+
+	uint8_t ScrollBytes[sizeof(float)];
+	memcpy(ScrollBytes, &State.ScrollY, sizeof(float));
+	Data.insert(Data.end(), ScrollBytes, ScrollBytes + sizeof(float));
+
+	WriteString(Data, State.FilterText);
+	uint8_t Options = 0;
+	if (State.bCaseSensitiveFiltering)
+		Options |= FE_SCENE_GRAPH_UI_STATE_FILE_CASE_SENSITIVE_FILTERING;
+	if (State.bChildrenSortAscending)
+		Options |= FE_SCENE_GRAPH_UI_STATE_FILE_CHILDREN_SORT_ASCENDING;
+	Data.push_back(Options);
+	WriteVarint(Data, State.ChildrenSortMode);
+
+	return Data;
+}
+
+bool FESceneGraphUIStateFile::Decode(const uint8_t* Data, size_t Size, FESceneGraphUIPersistentState& OutState)
+{
+	OutState = FESceneGraphUIPersistentState();
+	if (Data == nullptr || Size < sizeof(StateFileMagic) + 1 || memcmp(Data, StateFileMagic, sizeof(StateFileMagic)) != 0)
+		return false;
+
+	size_t Offset = sizeof(StateFileMagic);
+	if (Data[Offset++] != StateFileVersion)
+		return false;
+
+	if (!ReadString(Data, Size, Offset, OutState.SceneID))
+		return false;
+
+	uint64_t NodeCount = 0;
+	if (!ReadVarint(Data, Size, Offset, NodeCount))
+		return false;
+
+	// Every node takes at least two bytes, so corrupted count can not cause huge allocation.
+	if (NodeCount > (Size - Offset) / 2)
+		return false;
+
+	OutState.Nodes.resize(static_cast<size_t>(NodeCount));
+	for (size_t i = 0; i < OutState.Nodes.size(); i++)
+	{
+		FESceneGraphUIPersistentNodeState& Node = OutState.Nodes[i];
+		if (Offset >= Size)
+			return false;
+
+		uint8_t Flags = Data[Offset++];
+		if (!ReadNodeID(Data, Size, Offset, Flags, Node.NodeID))
+			return false;
+
+		Node.bExpanded = (Flags & FE_SCENE_GRAPH_UI_STATE_FILE_NODE_EXPANDED) != 0;
+		Node.bSelected = (Flags & FE_SCENE_GRAPH_UI_STATE_FILE_NODE_SELECTED) != 0;
+		Node.bHoisted = (Flags & FE_SCENE_GRAPH_UI_STATE_FILE_NODE_HOISTED) != 0;
+		if (Flags & FE_SCENE_GRAPH_UI_STATE_FILE_NODE_LOADED_CHILD_COUNT)
+		{
+			uint64_t LoadedChildCount = 0;
+			if (!ReadVarint(Data, Size, Offset, LoadedChildCount))
+				return false;
+
+			Node.LoadedChildCount = static_cast<size_t>(LoadedChildCount);
+		}
+	}
+
+	if (Size - Offset < sizeof(float))
+		return false;
+
+	memcpy(&OutState.ScrollY, Data + Offset, sizeof(float));
+	Offset += sizeof(float);
+
+	if (!ReadString(Data, Size, Offset, OutState.FilterText) || Offset >= Size)
+		return false;
+
+	uint8_t Options = Data[Offset++];
+	OutState.bCaseSensitiveFiltering = (Options & FE_SCENE_GRAPH_UI_STATE_FILE_CASE_SENSITIVE_FILTERING) != 0;
+	OutState.bChildrenSortAscending = (Options & FE_SCENE_GRAPH_UI_STATE_FILE_CHILDREN_SORT_ASCENDING) != 0;
+
+	uint64_t ChildrenSortMode = 0;
+	if (!ReadVarint(Data, Size, Offset, ChildrenSortMode))
+		return false;
+
+	OutState.ChildrenSortMode = static_cast<uint32_t>(ChildrenSortMode);
+	return true;
+}
+
+bool FESceneGraphUIStateFile::Save(const std::string& FilePath, const FESceneGraphUIPersistentState& State)
+{
+	std::vector<uint8_t> Data = Encode(State);
+	std::ofstream File(FilePath, std::ios::binary | std::ios::trunc);
+	if (!File.is_open())
+		return false;
+
+	File.write(reinterpret_cast<const char*>(Data.data()), static_cast<std::streamsize>(Data.size()));
+	return static_cast<bool>(File);
+}
+
+bool FESceneGraphUIStateFile::Load(const std::string& FilePath, FESceneGraphUIPersistentState& OutState)
+{
+	std::ifstream File(FilePath, std::ios::binary | std::ios::ate);
+	if (!File.is_open())
+		return false;
+
+	std::streamsize FileSize = File.tellg();
+	if (FileSize <= 0)
+		return false;
+
+	// Whole file is read with one call and decoded in place.
+	std::vector<uint8_t> Data(static_cast<size_t>(FileSize));
+	File.seekg(0, std::ios::beg);
+	if (!File.read(reinterpret_cast<char*>(Data.data()), FileSize))
+		return false;
+
+	return Decode(Data.data(), Data.size(), OutState);
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include "FEngine.h"
+#include <fstream>
+
+struct FESceneGraphUIPersistentNodeState
+{
+	std::string NodeID = "";
+	bool bExpanded = false;
+	bool bSelected = false;
+	bool bHoisted = false;
+	size_t LoadedChildCount = 0;
+};
+
+// Panel state that outlives editor session.
+// Every node that has state is stored once, with its flags, so there are no repeated node IDs in the file.
+struct FESceneGraphUIPersistentState
+{
+	std::string SceneID = "";
+	std::vector<FESceneGraphUIPersistentNodeState> Nodes;
+	float ScrollY = 0.0f;
+	std::string FilterText = "";
+	bool bCaseSensitiveFiltering = false;
+	uint32_t ChildrenSortMode = 0;
+	bool bChildrenSortAscending = true;
+};
+
+// Compact binary sidecar format for FESceneGraphUIPersistentState.
+// Counts and lengths are varints, hexadecimal node IDs are packed to two digits per byte.
+// It does not know about scenes, validation of node IDs is done by the caller.
+class FESceneGraphUIStateFile
+{
+	static void WriteVarint(std::vector<uint8_t>& Data, uint64_t Value);
+	static void WriteString(std::vector<uint8_t>& Data, const std::string& Value);
+	static void WriteNodeID(std::vector<uint8_t>& Data, const std::string& NodeID, uint8_t& InOutFlags);
+	static bool ReadVarint(const uint8_t* Data, size_t Size, size_t& InOutOffset, uint64_t& OutValue);
+	static bool ReadString(const uint8_t* Data, size_t Size, size_t& InOutOffset, std::string& OutValue);
+	static bool ReadNodeID(const uint8_t* Data, size_t Size, size_t& InOutOffset, uint8_t Flags, std::string& OutNodeID);
+public:
+	static std::vector<uint8_t> Encode(const FESceneGraphUIPersistentState& State);
+	// Returns false for data of another format or version, or for truncated data.
+	static bool Decode(const uint8_t* Data, size_t Size, FESceneGraphUIPersistentState& OutState);
+
+	static bool Save(const std::string& FilePath, const FESceneGraphUIPersistentState& State);
+	static bool Load(const std::string& FilePath, FESceneGraphUIPersistentState& OutState);
+};
\ No newline at end of file
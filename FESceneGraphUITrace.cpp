@@ -0,0 +1,111 @@
+#include "FESceneGraphUITrace.h"
+#include <thread>
+
+#ifdef TRACY_ENABLE
+#include <tracy/TracyC.h>
+#include <vector>
+#endif
+
+FESceneGraphUIChromeTraceSink::FESceneGraphUIChromeTraceSink(const std::string& FilePath)
+{
+	StartTime = std::chrono::high_resolution_clock::now();
+	File.open(FilePath, std::ios::out | std::ios::trunc);
+	if (File.is_open())
+		File << "[\n";
+}
+
+FESceneGraphUIChromeTraceSink::~FESceneGraphUIChromeTraceSink()
+{
+	Close();
+}
+
+bool FESceneGraphUIChromeTraceSink::IsOpen() const
+{
+	return File.is_open();
+}
+
+void FESceneGraphUIChromeTraceSink::Close()
+{
+	std::lock_guard<std::mutex> Lock(FileMutex);
+	if (!File.is_open())
+		return;
+
+	File << "\n]\n";
+	File.close();
+}
+
+void FESceneGraphUIChromeTraceSink::WriteEvent(const char* Phase, const char* Name)
+{
+	std::chrono::duration<double, std::micro> Timestamp = std::chrono::high_resolution_clock::now() - StartTime;
+	size_t ThreadID = std::hash<std::thread::id>{}(std::this_thread::get_id()) % 100000;
+
+	std::lock_guard<std::mutex> Lock(FileMutex);
+	if (!File.is_open())
+		return;
+
+	if (!bFirstEvent)
+		File << ",\n";
+	bFirstEvent = false;
+
+	File << "{\"ph\":\"" << Phase << "\",\"pid\":1,\"tid\":" << ThreadID << ",\"ts\":" << std::fixed << Timestamp.count();
+	if (Name != nullptr)
+	{
+		// Names come from user callbacks registration, so they are escaped.
+		File << ",\"cat\":\"FESceneGraphUI\",\"name\":\"";
+		for (const char* Character = Name; *Character != '\0'; Character++)
+		{
+			if (*Character == '"' || *Character == '\\')
+				File << '\\';
+
+			if (static_cast<unsigned char>(*Character) < 0x20)
+				continue;
+
+			File << *Character;
+		}
+		File << "\"";
+	}
+	File << "}";
+}
+
+void FESceneGraphUIChromeTraceSink::BeginSpan(const char* Name)
+{
+	WriteEvent("B", Name);
+}
+
+void FESceneGraphUIChromeTraceSink::EndSpan()
+{
+	WriteEvent("E", nullptr);
+}
+
+#ifdef TRACY_ENABLE
+// Tracy zones are closed with context that was returned on begin, so each thread keeps its own stack.
+static thread_local std::vector<TracyCZoneCtx> TracyZoneStack;
+
+void FESceneGraphUITracyTraceSink::BeginSpan(const char* Name)
+{
+	size_t NameLength = strlen(Name);
+	uint64_t SourceLocation = ___tracy_alloc_srcloc_name(__LINE__, __FILE__, strlen(__FILE__), "FESceneGraphUI", strlen("FESceneGraphUI"), Name, NameLength, 0);
+	TracyZoneStack.push_back(___tracy_emit_zone_begin_alloc(SourceLocation, 1));
+}
+
+void FESceneGraphUITracyTraceSink::EndSpan()
+{
+	if (TracyZoneStack.empty())
+		return;
+
+	___tracy_emit_zone_end(TracyZoneStack.back());
+	TracyZoneStack.pop_back();
+}
+#endif
+
+FESceneGraphUITraceScope::FESceneGraphUITraceScope(FESceneGraphUITraceSink* Sink, const char* Name) : Sink(Sink)
+{
+	if (Sink != nullptr)
+		Sink->BeginSpan(Name);
+}
+
+FESceneGraphUITraceScope::~FESceneGraphUITraceScope()
+{
+	if (Sink != nullptr)
+		Sink->EndSpan();
+}
\ No newline at end of file
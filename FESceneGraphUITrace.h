@@ -0,0 +1,60 @@
+#pragma once
+#include "FEngine.h"
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
+// Receives named spans from FESceneGraphUI (Render, FilterInput, Traverse, Filter, RenderNode, RenderNodeWidgets and user callbacks).
+// Spans on one thread are properly nested, EndSpan always closes the last opened span.
+// Name pointer is valid only during BeginSpan call, sink should copy it if needed.
+class FESceneGraphUITraceSink
+{
+public:
+	virtual ~FESceneGraphUITraceSink() {}
+
+	virtual void BeginSpan(const char* Name) = 0;
+	virtual void EndSpan() = 0;
+};
+
+// Writes Chrome trace-event JSON (chrome://tracing, Perfetto) to a local file.
+// File is valid JSON only after Close() or destruction of the sink.
+class FESceneGraphUIChromeTraceSink : public FESceneGraphUITraceSink
+{
+	std::mutex FileMutex;
+	std::ofstream File;
+	bool bFirstEvent = true;
+	std::chrono::high_resolution_clock::time_point StartTime;
+
+	void WriteEvent(const char* Phase, const char* Name);
+public:
+	FESceneGraphUIChromeTraceSink(const std::string& FilePath);
+	~FESceneGraphUIChromeTraceSink();
+
+	bool IsOpen() const;
+	void Close();
+
+	void BeginSpan(const char* Name) override;
+	void EndSpan() override;
+};
+
+#ifdef TRACY_ENABLE
+// Forwards spans to Tracy as zones with runtime names.
+class FESceneGraphUITracyTraceSink : public FESceneGraphUITraceSink
+{
+public:
+	void BeginSpan(const char* Name) override;
+	void EndSpan() override;
+};
+#endif
+
+class FESceneGraphUITraceScope
+{
+	FESceneGraphUITraceSink* Sink = nullptr;
+public:
+	FESceneGraphUITraceScope(FESceneGraphUITraceSink* Sink, const char* Name);
+	~FESceneGraphUITraceScope();
+};
+
+#define FE_SCENE_GRAPH_UI_TRACE_CONCAT_INNER(A, B) A##B
+#define FE_SCENE_GRAPH_UI_TRACE_CONCAT(A, B) FE_SCENE_GRAPH_UI_TRACE_CONCAT_INNER(A, B)
+#define FE_SCENE_GRAPH_UI_TRACE_SPAN(Sink, Name) FESceneGraphUITraceScope FE_SCENE_GRAPH_UI_TRACE_CONCAT(TraceScope, __LINE__)(Sink, Name)
\ No newline at end of file
@@ -0,0 +1,308 @@
+#include "FESceneGraphViewHistory.h"
+
+bool FESceneGraphViewHistoryStep::IsFilterOnly() const
+{
+	if (Operations.empty())
+		return false;
+
+	for (size_t i = 0; i < Operations.size(); i++)
+	{
+		if (Operations[i].Type != FE_SCENE_GRAPH_VIEW_HISTORY_FILTER)
+			return false;
+	}
+
+	return true;
+}
+
+size_t FESceneGraphViewHistoryStep::GetMemorySize() const
+{
+	size_t Result = sizeof(FESceneGraphViewHistoryStep) + Operations.capacity() * sizeof(FESceneGraphViewHistoryOperation);
+	for (size_t i = 0; i < Operations.size(); i++)
+		Result += Operations[i].Data.capacity() + Operations[i].OldFilterText.capacity() + Operations[i].NewFilterText.capacity();
+
+	return Result;
+}
+
+void FESceneGraphViewHistory::WriteVarint(std::vector<uint8_t>& Data, uint64_t Value)
+{
+	while (Value >= 0x80)
+	{
+		Data.push_back(static_cast<uint8_t>(Value | 0x80));
+		Value >>= 7;
+	}
+	Data.push_back(static_cast<uint8_t>(Value));
+}
+
+std::vector<uint64_t> FESceneGraphViewHistory::DecodeVarints(const std::vector<uint8_t>& Data)
+{
+	std::vector<uint64_t> Result;
+	uint64_t Value = 0;
+	int Shift = 0;
+	for (size_t i = 0; i < Data.size(); i++)
+	{
+		Value |= static_cast<uint64_t>(Data[i] & 0x7F) << Shift;
+		if (Data[i] & 0x80)
+		{
+			Shift += 7;
+			continue;
+		}
+
+		Result.push_back(Value);
+		Value = 0;
+		Shift = 0;
+	}
+
+	return Result;
+}
+
+uint32_t FESceneGraphViewHistory::InternNodeID(const std::string& NodeID)
+{
+	auto Iterator = NodeIndices.find(NodeID);
+	if (Iterator != NodeIndices.end())
+		return Iterator->second;
+
+	uint32_t Index = static_cast<uint32_t>(NodeIDs.size());
+	NodeIDs.push_back(NodeID);
+	NodeIndices[NodeID] = Index;
+	return Index;
+}
+
+const std::string& FESceneGraphViewHistory::GetNodeID(uint32_t Index) const
+{
+	static const std::string EmptyNodeID = "";
+	if (Index >= NodeIDs.size())
+		return EmptyNodeID;
+
+	return NodeIDs[Index];
+}
+
+bool FESceneGraphViewHistory::IsRecording() const
+{
+	return bRecording;
+}
+
+void FESceneGraphViewHistory::SetRecording(bool bNewValue)
+{
+	bRecording = bNewValue;
+}
+
+void FESceneGraphViewHistory::RecordNodeChange(const std::string& NodeID, FE_SCENE_GRAPH_VIEW_HISTORY_FIELD Field, bool bNewValue)
+{
+	if (!bRecording || MaxSteps == 0)
+		return;
+
+	std::vector<FESceneGraphViewHistoryOperation>& Operations = PendingStep.Operations;
+	if (Operations.empty() || Operations.back().Type != FE_SCENE_GRAPH_VIEW_HISTORY_NODE_CHANGES)
+		Operations.push_back(FESceneGraphViewHistoryOperation());
+
+	uint64_t Record = static_cast<uint64_t>(InternNodeID(NodeID)) * 4 + static_cast<uint64_t>(Field) * 2 + (bNewValue ? 1 : 0);
+	WriteVarint(Operations.back().Data, Record);
+}
+
+void FESceneGraphViewHistory::RecordSubtreeExpansion(const std::string& RootNodeID, bool bExpanded, const std::vector<std::string>& ExpandedNodeIDsBefore)
+{
+	if (!bRecording || MaxSteps == 0)
+		return;
+
+	FESceneGraphViewHistoryOperation Operation;
+	Operation.Type = FE_SCENE_GRAPH_VIEW_HISTORY_SUBTREE_EXPANSION;
+	Operation.SubtreeRootIndex = InternNodeID(RootNodeID);
+	Operation.bSubtreeExpanded = bExpanded;
+	for (size_t i = 0; i < ExpandedNodeIDsBefore.size(); i++)
+		WriteVarint(Operation.Data, InternNodeID(ExpandedNodeIDsBefore[i]));
+
+	PendingStep.Operations.push_back(std::move(Operation));
+}
+
+void FESceneGraphViewHistory::RecordFilterChange(const std::string& OldFilterText, const std::string& NewFilterText)
+{
+	if (!bRecording || MaxSteps == 0 || OldFilterText == NewFilterText)
+		return;
+
+	std::vector<FESceneGraphViewHistoryOperation>& Operations = PendingStep.Operations;
+	if (!Operations.empty() && Operations.back().Type == FE_SCENE_GRAPH_VIEW_HISTORY_FILTER)
+	{
+		Operations.back().NewFilterText = NewFilterText;
+		return;
+	}
+
+	FESceneGraphViewHistoryOperation Operation;
+	Operation.Type = FE_SCENE_GRAPH_VIEW_HISTORY_FILTER;
+	Operation.OldFilterText = OldFilterText;
+	Operation.NewFilterText = NewFilterText;
+	Operations.push_back(std::move(Operation));
+}
+
+void FESceneGraphViewHistory::CommitPendingStep()
+{
+	if (PendingStep.Operations.empty())
+		return;
+
+	RedoSteps.clear();
+	if (PendingStep.IsFilterOnly() && !UndoSteps.empty() && UndoSteps.back().IsFilterOnly())
+	{
+		UndoSteps.back().Operations.back().NewFilterText = PendingStep.Operations.back().NewFilterText;
+	}
+	else
+	{
+		UndoSteps.push_back(std::move(PendingStep));
+	}
+	PendingStep = FESceneGraphViewHistoryStep();
+
+	DropOldestUndoSteps();
+}
+
+void FESceneGraphViewHistory::DropOldestUndoSteps()
+{
+	if (UndoSteps.size() <= MaxSteps)
+		return;
+
+	while (UndoSteps.size() > MaxSteps)
+		UndoSteps.pop_front();
+
+	if (NodeIDs.size() > 256 && NodeIDs.size() >= NodeIDCountAfterCompaction * 2)
+		CompactNodeIDs();
+}
+
+void FESceneGraphViewHistory::CompactNodeIDs()
+{
+	std::vector<FESceneGraphViewHistoryStep*> Steps;
+	for (size_t i = 0; i < UndoSteps.size(); i++)
+		Steps.push_back(&UndoSteps[i]);
+	for (size_t i = 0; i < RedoSteps.size(); i++)
+		Steps.push_back(&RedoSteps[i]);
+	Steps.push_back(&PendingStep);
+
+	std::vector<std::string> NewNodeIDs;
+	std::unordered_map<std::string, uint32_t> NewNodeIndices;
+	std::vector<uint32_t> IndexRemap(NodeIDs.size(), UINT32_MAX);
+	auto RemapIndex = [&](uint64_t OldIndex) -> uint64_t {
+		if (OldIndex >= NodeIDs.size())
+			return OldIndex;
+
+		if (IndexRemap[OldIndex] == UINT32_MAX)
+		{
+			IndexRemap[OldIndex] = static_cast<uint32_t>(NewNodeIDs.size());
+			NewNodeIndices[NodeIDs[OldIndex]] = IndexRemap[OldIndex];
+			NewNodeIDs.push_back(NodeIDs[OldIndex]);
+		}
+
+		return IndexRemap[OldIndex];
+	};
+
+	for (FESceneGraphViewHistoryStep* Step : Steps)
+	{
+		for (FESceneGraphViewHistoryOperation& Operation : Step->Operations)
+		{
+			if (Operation.Type == FE_SCENE_GRAPH_VIEW_HISTORY_FILTER)
+				continue;
+
+			std::vector<uint64_t> Values = DecodeVarints(Operation.Data);
+			Operation.Data.clear();
+			for (size_t i = 0; i < Values.size(); i++)
+			{
+				// Node change records keep field and value in the two lowest bits.
+				if (Operation.Type == FE_SCENE_GRAPH_VIEW_HISTORY_NODE_CHANGES)
+				{
+					WriteVarint(Operation.Data, RemapIndex(Values[i] / 4) * 4 + Values[i] % 4);
+				}
+				else
+				{
+					WriteVarint(Operation.Data, RemapIndex(Values[i]));
+				}
+			}
+
+			if (Operation.Type == FE_SCENE_GRAPH_VIEW_HISTORY_SUBTREE_EXPANSION)
+				Operation.SubtreeRootIndex = static_cast<uint32_t>(RemapIndex(Operation.SubtreeRootIndex));
+		}
+	}
+
+	NodeIDs = std::move(NewNodeIDs);
+	NodeIndices = std::move(NewNodeIndices);
+	NodeIDCountAfterCompaction = NodeIDs.size();
+}
+
+bool FESceneGraphViewHistory::HasPendingStep() const
+{
+	return !PendingStep.Operations.empty();
+}
+
+bool FESceneGraphViewHistory::CanUndo() const
+{
+	return !UndoSteps.empty();
+}
+
+bool FESceneGraphViewHistory::CanRedo() const
+{
+	return !RedoSteps.empty();
+}
+
+const FESceneGraphViewHistoryStep* FESceneGraphViewHistory::PopUndoStep()
+{
+	if (UndoSteps.empty())
+		return nullptr;
+
+	RedoSteps.push_back(std::move(UndoSteps.back()));
+	UndoSteps.pop_back();
+	return &RedoSteps.back();
+}
+
+const FESceneGraphViewHistoryStep* FESceneGraphViewHistory::PopRedoStep()
+{
+	if (RedoSteps.empty())
+		return nullptr;
+
+	UndoSteps.push_back(std::move(RedoSteps.back()));
+	RedoSteps.pop_back();
+	return &UndoSteps.back();
+}
+
+size_t FESceneGraphViewHistory::GetMaxSteps() const
+{
+	return MaxSteps;
+}
+
+void FESceneGraphViewHistory::SetMaxSteps(size_t NewValue)
+{
+	MaxSteps = NewValue;
+	DropOldestUndoSteps();
+
+	if (RedoSteps.size() > MaxSteps)
+		RedoSteps.erase(RedoSteps.begin(), RedoSteps.end() - MaxSteps);
+}
+
+size_t FESceneGraphViewHistory::GetUndoStepCount() const
+{
+	return UndoSteps.size();
+}
+
+size_t FESceneGraphViewHistory::GetRedoStepCount() const
+{
+	return RedoSteps.size();
+}
+
+size_t FESceneGraphViewHistory::GetMemorySize() const
+{
+	size_t Result = PendingStep.GetMemorySize();
+	for (size_t i = 0; i < UndoSteps.size(); i++)
+		Result += UndoSteps[i].GetMemorySize();
+
+	for (size_t i = 0; i < RedoSteps.size(); i++)
+		Result += RedoSteps[i].GetMemorySize();
+
+	// Interned IDs are stored twice, in the table and as the map key.
+	for (size_t i = 0; i < NodeIDs.size(); i++)
+		Result += NodeIDs[i].capacity() * 2 + sizeof(std::string) * 2 + sizeof(uint32_t);
+
+	return Result;
+}
+
+void FESceneGraphViewHistory::Clear()
+{
+	NodeIDs.clear();
+	NodeIndices.clear();
+	NodeIDCountAfterCompaction = 0;
+	UndoSteps.clear();
+	RedoSteps.clear();
+	PendingStep = FESceneGraphViewHistoryStep();
+}
\ No newline at end of file
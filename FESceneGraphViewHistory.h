@@ -0,0 +1,89 @@
+#pragma once
+#include "FEngine.h"
+#include <deque>
+
+enum FE_SCENE_GRAPH_VIEW_HISTORY_FIELD
+{
+	FE_SCENE_GRAPH_VIEW_HISTORY_FIELD_EXPANDED = 0,
+	FE_SCENE_GRAPH_VIEW_HISTORY_FIELD_SELECTED = 1
+};
+
+enum FE_SCENE_GRAPH_VIEW_HISTORY_OPERATION_TYPE
+{
+	FE_SCENE_GRAPH_VIEW_HISTORY_NODE_CHANGES = 0,
+	// Expand or collapse of every node in a subtree.
+	FE_SCENE_GRAPH_VIEW_HISTORY_SUBTREE_EXPANSION = 1,
+	FE_SCENE_GRAPH_VIEW_HISTORY_FILTER = 2
+};
+
+struct FESceneGraphViewHistoryOperation
+{
+	FE_SCENE_GRAPH_VIEW_HISTORY_OPERATION_TYPE Type = FE_SCENE_GRAPH_VIEW_HISTORY_NODE_CHANGES;
+	// Node changes: varint records of (NodeIndex * 4 + Field * 2 + NewValue), previous value is always the opposite.
+	// Subtree expansion: varint indices of subtree nodes that were expanded before it, so the size does not depend on subtree size.
+	std::vector<uint8_t> Data;
+	uint32_t SubtreeRootIndex = 0;
+	bool bSubtreeExpanded = false;
+	std::string OldFilterText = "";
+	std::string NewFilterText = "";
+};
+
+// Everything that was changed between two commits, it is undone and redone as one.
+struct FESceneGraphViewHistoryStep
+{
+	std::vector<FESceneGraphViewHistoryOperation> Operations;
+
+	bool IsFilterOnly() const;
+	size_t GetMemorySize() const;
+};
+
+// Bounded undo/redo log of view state changes (expansion, selection, filter).
+// Node IDs are interned once, steps refer to them by index.
+// It only records and stores changes, applying them is done by FESceneGraphUI.
+class FESceneGraphViewHistory
+{
+	std::vector<std::string> NodeIDs;
+	std::unordered_map<std::string, uint32_t> NodeIndices;
+	std::deque<FESceneGraphViewHistoryStep> UndoSteps;
+	std::vector<FESceneGraphViewHistoryStep> RedoSteps;
+	FESceneGraphViewHistoryStep PendingStep;
+	size_t MaxSteps = 64;
+	bool bRecording = true;
+	// IDs of nodes that are referenced only by dropped steps are removed when table has doubled since the last compaction.
+	size_t NodeIDCountAfterCompaction = 0;
+
+	static void WriteVarint(std::vector<uint8_t>& Data, uint64_t Value);
+	void DropOldestUndoSteps();
+	void CompactNodeIDs();
+public:
+	uint32_t InternNodeID(const std::string& NodeID);
+	const std::string& GetNodeID(uint32_t Index) const;
+
+	// Recording is paused while steps are applied, so undo does not record itself.
+	bool IsRecording() const;
+	void SetRecording(bool bNewValue);
+
+	void RecordNodeChange(const std::string& NodeID, FE_SCENE_GRAPH_VIEW_HISTORY_FIELD Field, bool bNewValue);
+	void RecordSubtreeExpansion(const std::string& RootNodeID, bool bExpanded, const std::vector<std::string>& ExpandedNodeIDsBefore);
+	void RecordFilterChange(const std::string& OldFilterText, const std::string& NewFilterText);
+
+	// Closes the pending step, does nothing if nothing was recorded.
+	// Consecutive filter only steps are merged, so typing in the filter is undone at once.
+	void CommitPendingStep();
+	bool HasPendingStep() const;
+
+	bool CanUndo() const;
+	bool CanRedo() const;
+	// Moves the step between stacks and returns it, pointer is valid until the history is changed.
+	const FESceneGraphViewHistoryStep* PopUndoStep();
+	const FESceneGraphViewHistoryStep* PopRedoStep();
+
+	static std::vector<uint64_t> DecodeVarints(const std::vector<uint8_t>& Data);
+
+	size_t GetMaxSteps() const;
+	void SetMaxSteps(size_t NewValue);
+	size_t GetUndoStepCount() const;
+	size_t GetRedoStepCount() const;
+	size_t GetMemorySize() const;
+	void Clear();
+};
\ No newline at end of file